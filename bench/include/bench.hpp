@@ -0,0 +1,64 @@
+// Utilities for benchmarking
+//
+// File Name: bench.hpp
+// Date: 2026-10-18
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace Bench {
+    /**
+     * @brief Run func repeatedly for at least min_time and report throughput
+     *
+     * @param name label printed with the result
+     * @param bytes number of bytes processed by a single call, 0 for
+     * operation counts only
+     * @return nanoseconds per call
+     */
+    template <typename Func>
+    double run(std::string const& name, std::size_t bytes, Func&& func,
+               std::chrono::milliseconds min_time =
+                   std::chrono::milliseconds{300}) {
+        using Clock = std::chrono::steady_clock;
+
+        // warm up caches and lazy initialization
+        func();
+
+        std::size_t iterations{};
+        auto const start = Clock::now();
+        auto now = start;
+        do {
+            for (auto i = 0; i < 16; ++i)
+                func();
+
+            iterations += 16;
+            now = Clock::now();
+        } while (now - start < min_time);
+
+        double const ns =
+            std::chrono::duration<double, std::nano>(now - start).count() /
+            iterations;
+
+        if (bytes != 0)
+            std::printf("%-40s %12.1f ns/op %10.1f MiB/s\n", name.c_str(), ns,
+                        (bytes / (1024.0 * 1024.0)) / (ns * 1e-9));
+        else
+            std::printf("%-40s %12.1f ns/op\n", name.c_str(), ns);
+
+        return ns;
+    }
+
+    /** @brief Keep the optimizer from discarding a result */
+    template <typename T>
+    void do_not_optimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static void const* volatile sink;
+        sink = &value;
+#endif
+    }
+} // namespace Bench
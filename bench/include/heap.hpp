@@ -0,0 +1,60 @@
+// Counting replacement of the global allocator, for memory figures
+//
+// Replaces operator new and delete, so include it from exactly one
+// translation unit of a benchmark.
+//
+// File Name: heap.hpp
+// Date: 2026-10-18
+
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <cstddef>
+
+namespace Bench::Heap {
+    /** @brief Bytes currently allocated, as requested */
+    inline std::atomic<std::size_t> bytes{};
+
+    /** @brief Allocations made so far */
+    inline std::atomic<std::size_t> allocations{};
+
+    // room for the size of each block ahead of it, keeping it aligned
+    constexpr std::size_t header = alignof(std::max_align_t);
+} // namespace Bench::Heap
+
+// Once delete is inlined into code that called new, GCC sees a free() of
+// memory from operator new and warns, so neither side is inlined
+#ifdef __GNUC__
+#define BENCH_HEAP_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_HEAP_NOINLINE
+#endif
+
+BENCH_HEAP_NOINLINE void* operator new(std::size_t size) {
+    auto* block =
+        static_cast<unsigned char*>(std::malloc(size + Bench::Heap::header));
+    if (block == nullptr)
+        throw std::bad_alloc{};
+
+    *reinterpret_cast<std::size_t*>(block) = size;
+    Bench::Heap::bytes.fetch_add(size, std::memory_order_relaxed);
+    Bench::Heap::allocations.fetch_add(1, std::memory_order_relaxed);
+    return block + Bench::Heap::header;
+}
+
+BENCH_HEAP_NOINLINE void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr)
+        return;
+
+    auto* block = static_cast<unsigned char*>(ptr) - Bench::Heap::header;
+    Bench::Heap::bytes.fetch_sub(*reinterpret_cast<std::size_t*>(block),
+                                 std::memory_order_relaxed);
+    std::free(block);
+}
+
+BENCH_HEAP_NOINLINE void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
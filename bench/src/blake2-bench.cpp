@@ -0,0 +1,51 @@
+// BLAKE2 throughput: in-library kernels against OpenSSL EVP
+//
+// File Name: blake2-bench.cpp
+// Date: 2026-10-18
+
+#include "bench.hpp"
+
+#include "multiformats/multihash.hpp"
+
+#include <openssl/evp.h>
+
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+namespace {
+    void evp_digest(EVP_MD const* md, std::vector<std::uint8_t> const& input) {
+        unsigned char digest[EVP_MAX_MD_SIZE];
+        unsigned digest_len{};
+        EVP_Digest(input.data(), input.size(), digest, &digest_len, md,
+                   nullptr);
+        Bench::do_not_optimize(digest);
+    }
+} // namespace
+
+int main() {
+    for (std::size_t size : {64, 1024, 16 * 1024, 1024 * 1024}) {
+        std::vector<std::uint8_t> input(size, 0xa5);
+        auto const suffix = " " + std::to_string(size) + "B";
+
+        Bench::run("openssl blake2b-512" + suffix, size,
+                   [&] { evp_digest(EVP_blake2b512(), input); });
+        Bench::run("multihash blake2b-512" + suffix, size, [&] {
+            Bench::do_not_optimize(
+                Multiformats::Multihash{input, "blake2b-512"});
+        });
+        Bench::run("multihash blake2b-256" + suffix, size, [&] {
+            Bench::do_not_optimize(
+                Multiformats::Multihash{input, "blake2b-256"});
+        });
+        Bench::run("openssl blake2s-256" + suffix, size,
+                   [&] { evp_digest(EVP_blake2s256(), input); });
+        Bench::run("multihash blake2s-256" + suffix, size, [&] {
+            Bench::do_not_optimize(
+                Multiformats::Multihash{input, "blake2s-256"});
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+// Memory per key and lookup cost of CIDs in blockstore-like containers
+//
+// usage: cid-key-bench [keys]
+//
+// File Name: cid-key-bench.cpp
+// Date: 2026-10-18
+
+#include "bench.hpp"
+#include "heap.hpp"
+
+#include "multiformats/cid_key.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+    using Multiformats::Cid;
+    using Multiformats::CidKey;
+
+    /** @brief Binary CIDv1s of raw blocks, sha2-256 of random content */
+    std::vector<std::vector<std::uint8_t>> synthetic_cids(std::size_t count) {
+        std::mt19937_64 rng{42};
+        std::vector<std::vector<std::uint8_t>> ret(count);
+        for (auto& binary : ret) {
+            binary = {0x01, 0x55, 0x12, 0x20};
+            for (int i = 0; i < 32; ++i)
+                binary.push_back(static_cast<std::uint8_t>(rng()));
+        }
+
+        return ret;
+    }
+
+    /** @brief Build a container and report what it costs per key */
+    template <typename Build>
+    void measure(char const* name, std::size_t keys, Build&& build) {
+        auto const bytes = Bench::Heap::bytes.load();
+        auto const allocations = Bench::Heap::allocations.load();
+
+        auto const container = build();
+        Bench::do_not_optimize(container);
+
+        std::printf("%-40s %8.1f B/key %8.2f allocations/key\n", name,
+                    double(Bench::Heap::bytes - bytes) / keys,
+                    double(Bench::Heap::allocations - allocations) / keys);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const keys =
+        argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    auto const binaries = synthetic_cids(keys);
+    std::printf("%zu keys, sizeof(Cid) %zu, sizeof(CidKey) %zu\n", keys,
+                sizeof(Cid), sizeof(CidKey));
+
+    measure("std::vector<Cid>", keys, [&] {
+        std::vector<Cid> ret;
+        ret.reserve(keys);
+        for (auto const& binary : binaries)
+            ret.emplace_back(binary);
+
+        return ret;
+    });
+
+    measure("std::vector<CidKey>", keys, [&] {
+        std::vector<CidKey> ret;
+        ret.reserve(keys);
+        for (auto const& binary : binaries)
+            ret.emplace_back(binary);
+
+        return ret;
+    });
+
+    measure("std::unordered_set<std::string>", keys, [&] {
+        std::unordered_set<std::string> ret;
+        ret.reserve(keys);
+        for (auto const& binary : binaries)
+            ret.emplace(binary.begin(), binary.end());
+
+        return ret;
+    });
+
+    measure("std::unordered_set<CidKey>", keys, [&] {
+        std::unordered_set<CidKey> ret;
+        ret.reserve(keys);
+        for (auto const& binary : binaries)
+            ret.emplace(binary);
+
+        return ret;
+    });
+
+    // lookups, half of them misses
+    std::unordered_set<std::string> strings;
+    std::unordered_set<CidKey> cid_keys;
+    for (std::size_t i = 0; i < keys; i += 2) {
+        strings.emplace(binaries[i].begin(), binaries[i].end());
+        cid_keys.emplace(binaries[i]);
+    }
+
+    std::vector<std::string> string_probes;
+    std::vector<CidKey> key_probes;
+    for (auto const& binary : binaries) {
+        string_probes.emplace_back(binary.begin(), binary.end());
+        key_probes.emplace_back(binary);
+    }
+
+    std::size_t next{};
+    Bench::run("find std::string", 0, [&] {
+        Bench::do_not_optimize(strings.count(string_probes[next]));
+        next = next + 1 == keys ? 0 : next + 1;
+    });
+    next = 0;
+    Bench::run("find CidKey", 0, [&] {
+        Bench::do_not_optimize(cid_keys.count(key_probes[next]));
+        next = next + 1 == keys ? 0 : next + 1;
+    });
+
+    Cid const cid{binaries.front()};
+    CidKey const key{cid};
+    Bench::run("CidKey from Cid", 0,
+               [&] { Bench::do_not_optimize(CidKey{cid}); });
+    Bench::run("Cid from CidKey", 0,
+               [&] { Bench::do_not_optimize(key.to_cid()); });
+    Bench::run("CidKey from binary", 0,
+               [&] { Bench::do_not_optimize(CidKey{binaries.front()}); });
+
+    return 0;
+}
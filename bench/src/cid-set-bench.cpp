@@ -0,0 +1,116 @@
+// Deduplicating CIDs from many threads, sharded set against one lock
+//
+// usage: cid-set-bench [blocks] [distinct CIDs]
+//
+// File Name: cid-set-bench.cpp
+// Date: 2026-10-18
+
+#include "bench.hpp"
+
+#include "multiformats/cid_set.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+    using Multiformats::CidKey;
+    using Multiformats::CidSet;
+
+    using Clock = std::chrono::steady_clock;
+
+    double seconds_since(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    /** @brief Binary CIDv1s of raw blocks, sha2-256 of random content */
+    std::vector<std::vector<std::uint8_t>> synthetic_cids(std::size_t count) {
+        std::mt19937_64 rng{42};
+        std::vector<std::vector<std::uint8_t>> ret(count);
+        for (auto& binary : ret) {
+            binary = {0x01, 0x55, 0x12, 0x20};
+            for (int i = 0; i < 32; ++i)
+                binary.push_back(static_cast<std::uint8_t>(rng()));
+        }
+
+        return ret;
+    }
+
+    /** @brief What an ingest pipeline had before, one mutex around a set */
+    class LockedSet {
+        std::mutex mutex;
+        std::unordered_set<std::string> keys;
+
+      public:
+        bool insert(std::vector<std::uint8_t> const& binary) {
+            std::string key{binary.begin(), binary.end()};
+            std::lock_guard lock{mutex};
+            return keys.insert(std::move(key)).second;
+        }
+    };
+
+    /** @brief Run insert over every block, split across threads */
+    template <typename Insert>
+    double run_threads(unsigned threads, std::size_t blocks, Insert&& insert) {
+        auto const start = Clock::now();
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (auto i = std::size_t{t}; i < blocks; i += threads)
+                    insert(i);
+            });
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+
+        return blocks / seconds_since(start) * 1e-6;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const blocks =
+        argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+    std::size_t const distinct =
+        argc > 2 ? std::strtoull(argv[2], nullptr, 10) : blocks / 4;
+
+    auto const binaries = synthetic_cids(distinct);
+
+    // which CID each ingested block has, most of them seen before
+    std::mt19937_64 rng{7};
+    std::uniform_int_distribution<std::size_t> pick{0, distinct - 1};
+    std::vector<std::uint32_t> refs(blocks);
+    for (auto& ref : refs)
+        ref = static_cast<std::uint32_t>(pick(rng));
+
+    std::printf("%zu blocks, %zu distinct CIDs, %u hardware threads\n",
+                blocks, distinct, std::thread::hardware_concurrency());
+    std::printf("%-8s %16s %16s\n", "threads", "locked Mops/s",
+                "CidSet Mops/s");
+
+    for (unsigned threads = 1; threads <= 64; threads *= 2) {
+        LockedSet locked;
+        auto const locked_rate = run_threads(threads, blocks, [&](auto i) {
+            Bench::do_not_optimize(locked.insert(binaries[refs[i]]));
+        });
+
+        CidSet set;
+        auto const set_rate = run_threads(threads, blocks, [&](auto i) {
+            Bench::do_not_optimize(set.insert(CidKey{binaries[refs[i]]}));
+        });
+
+        std::printf("%-8u %16.2f %16.2f\n", threads, locked_rate, set_rate);
+    }
+
+    return 0;
+}
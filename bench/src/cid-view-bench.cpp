@@ -0,0 +1,55 @@
+// Cost of parsing CIDs into Cid objects and into views
+//
+// File Name: cid-view-bench.cpp
+// Date: 2026-10-18
+
+#include "bench.hpp"
+
+#include "multiformats/cid.hpp"
+#include "multiformats/cid_view.hpp"
+#include "multiformats/multibase.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+namespace {
+    using Multiformats::Cid;
+    using Multiformats::CidView;
+    using Multiformats::Multibase::Protocol;
+
+    std::string const encoded{
+        "zb2rhe5P4gXftAwvA4eXQ5HJwsER2owDyS9sKaQRRVQPn93bA"};
+} // namespace
+
+int main() {
+    auto const binary = Multiformats::Multibase::decode(encoded);
+
+    Bench::run("Cid from binary", binary.size(),
+               [&] { Bench::do_not_optimize(Cid{binary}); });
+    Bench::run("CidView from binary", binary.size(), [&] {
+        CidView view;
+        Bench::do_not_optimize(CidView::parse(binary, view));
+        Bench::do_not_optimize(view);
+    });
+
+    for (auto const protocol :
+         {Protocol::Base16, Protocol::Base32, Protocol::Base58Btc,
+          Protocol::Base64Url, Protocol::Base32Hex}) {
+        auto const text = Multiformats::Multibase::encode(protocol, binary);
+        auto const name = Multiformats::Multibase::to_string(protocol);
+
+        Bench::run("Cid from " + name, text.size(),
+                   [&] { Bench::do_not_optimize(Cid{text}); });
+        Bench::run("CidView from " + name, text.size(), [&] {
+            std::array<std::uint8_t, 128> buffer;
+            CidView view;
+            Bench::do_not_optimize(CidView::parse(text, buffer, view));
+            Bench::do_not_optimize(view);
+        });
+    }
+
+    return 0;
+}
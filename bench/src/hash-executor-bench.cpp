@@ -0,0 +1,57 @@
+// HashExecutor scaling from one worker to one per hardware thread
+//
+// File Name: hash-executor-bench.cpp
+// Date: 2026-10-18
+
+#include "bench.hpp"
+
+#include "multiformats/hash_executor.hpp"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cstdint>
+
+int main() {
+    // 4 KiB blocks with a 1 MiB block every 64, about 4 MiB per round
+    std::vector<std::vector<std::uint8_t>> blocks;
+    std::size_t bytes{};
+    for (std::size_t i = 0; i < 256; ++i) {
+        blocks.emplace_back(i % 64 == 0 ? 1024 * 1024 : 4096,
+                            static_cast<std::uint8_t>(i));
+        bytes += blocks.back().size();
+    }
+
+    auto const cores = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::size_t> counts;
+    for (std::size_t workers = 1; workers < cores; workers *= 2)
+        counts.push_back(workers);
+    counts.push_back(cores);
+
+    for (auto workers : counts) {
+        Multiformats::HashExecutor::Options options;
+        options.workers = workers;
+        Multiformats::HashExecutor executor{options};
+
+        for (auto const* protocol : {"sha2-256", "blake2b-256"}) {
+            Multiformats::Varint const code =
+                protocol[0] == 's' ? 0x12 : 0xb220;
+            std::vector<std::future<Multiformats::Multihash>> futures;
+            futures.reserve(blocks.size());
+
+            Bench::run(std::string{protocol} + " mixed " +
+                           std::to_string(workers) + " workers",
+                       bytes, [&] {
+                           futures.clear();
+                           for (auto const& block : blocks)
+                               futures.push_back(executor.submit(block, code));
+                           for (auto& future : futures)
+                               Bench::do_not_optimize(future.get());
+                       });
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+// Multiaddr parse throughput and memory held per address
+//
+// File Name: multiaddr-bench.cpp
+// Date: 2026-10-18
+
+#include "bench.hpp"
+#include "heap.hpp"
+
+#include "multiformats/multiaddr.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+int main() {
+    using Multiformats::Multiaddr;
+
+    std::vector<std::string> const addresses{
+        "/ip4/127.0.0.1/tcp/4001",
+        "/ip6/2001:db8::1/udp/4001/quic",
+        "/dns4/bootstrap.libp2p.io/tcp/443/wss",
+        "/ip4/104.131.131.82/tcp/4001/p2p/"
+        "QmaCpDMGvV2BGHeYERUEnRQAwe3N8SzbUtfsmvsqQLuvuJ",
+        "/ip4/147.75.83.83/udp/4001/quic/p2p/"
+        "QmbLHAnMoJPWSCR5Zhtx6BHJX9KiKNN6tpvbUcqanj75Nb/p2p-circuit/p2p/"
+        "QmcZf59bWwK5XFi76CZX8cbJ4BhTzzA3gU1ZjYZcYW3dwt"};
+
+    auto const label = [](Multiaddr const& multiaddr) {
+        return " " + std::to_string(multiaddr.size()) + "x/" +
+               std::to_string(multiaddr.to_binary().size()) + "B";
+    };
+
+    constexpr std::size_t copies = 10000;
+    for (auto const& address : addresses) {
+        std::vector<Multiaddr> held;
+        held.reserve(copies);
+
+        auto const bytes_before = Bench::Heap::bytes.load();
+        auto const allocations_before = Bench::Heap::allocations.load();
+        for (std::size_t i = 0; i < copies; ++i)
+            held.emplace_back(address);
+
+        std::printf("%-40s %8zu B/addr %6.1f allocs/addr\n",
+                    ("memory" + label(held.front())).c_str(),
+                    sizeof(Multiaddr) +
+                        (Bench::Heap::bytes - bytes_before) / copies,
+                    double(Bench::Heap::allocations - allocations_before) /
+                        copies);
+    }
+
+    for (auto const& address : addresses) {
+        Multiaddr const parsed{address};
+        auto const& encoded = parsed.to_binary();
+        std::vector<std::uint8_t> const binary{encoded.begin(), encoded.end()};
+        auto const suffix = label(parsed);
+
+        Bench::run("parse text" + suffix, address.size(), [&] {
+            Bench::do_not_optimize(Multiaddr{address});
+        });
+        Bench::run("parse binary" + suffix, binary.size(), [&] {
+            Bench::do_not_optimize(Multiaddr{binary});
+        });
+        Bench::run("to_binary" + suffix, binary.size(), [&] {
+            Bench::do_not_optimize(parsed.to_binary().size());
+        });
+        Bench::run("to_string" + suffix, address.size(), [&] {
+            Bench::do_not_optimize(parsed.to_string());
+        });
+    }
+
+    return 0;
+}
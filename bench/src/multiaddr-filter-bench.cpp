@@ -0,0 +1,122 @@
+// Multiaddr IP prefix filter build cost, memory and match latency
+//
+// usage: multiaddr-filter-bench [ip4 prefixes] [ip6 prefixes]
+//
+// File Name: multiaddr-filter-bench.cpp
+// Date: 2026-10-18
+
+#include "bench.hpp"
+#include "heap.hpp"
+
+#include "multiformats/multiaddr_filter.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+    using Multiformats::Multiaddr;
+    using Multiformats::MultiaddrFilter;
+
+    std::string ip4_text(std::uint32_t address) {
+        return std::to_string(address >> 24) + "." +
+               std::to_string((address >> 16) & 0xff) + "." +
+               std::to_string((address >> 8) & 0xff) + "." +
+               std::to_string(address & 0xff);
+    }
+
+    std::string ip6_text(std::uint64_t high, std::uint64_t low) {
+        char buffer[48];
+        std::snprintf(buffer, sizeof(buffer), "%x:%x:%x:%x:%x:%x:%x:%x",
+                      unsigned(high >> 48), unsigned(high >> 32) & 0xffff,
+                      unsigned(high >> 16) & 0xffff, unsigned(high) & 0xffff,
+                      unsigned(low >> 48), unsigned(low >> 32) & 0xffff,
+                      unsigned(low >> 16) & 0xffff, unsigned(low) & 0xffff);
+        return buffer;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const ip4_count =
+        argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000;
+    std::size_t const ip6_count =
+        argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100'000;
+
+    // blocklist shaped prefixes: mostly /24s and hosts for IPv4, /32 to /64
+    // allocations for IPv6
+    std::mt19937_64 rng{42};
+    std::vector<std::string> prefixes;
+    prefixes.reserve(ip4_count + ip6_count);
+    for (std::size_t i = 0; i < ip4_count; ++i) {
+        static constexpr int lengths[] = {8, 12, 16, 20, 24, 24, 24, 32, 32};
+        auto const length = lengths[rng() % std::size(lengths)];
+        prefixes.push_back(ip4_text(std::uint32_t(rng())) + "/" +
+                           std::to_string(length));
+    }
+
+    for (std::size_t i = 0; i < ip6_count; ++i) {
+        auto const length = 32 + rng() % 33;
+        prefixes.push_back(ip6_text(0x2000'0000'0000'0000 | rng() >> 4, 0) +
+                           "/" + std::to_string(length));
+    }
+
+    MultiaddrFilter filter;
+    auto const bytes_before = Bench::Heap::bytes.load();
+    auto const start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < prefixes.size(); ++i)
+        filter.add(prefixes[i], i % 2 == 0 ? MultiaddrFilter::Action::Deny
+                                           : MultiaddrFilter::Action::Accept);
+
+    auto const seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+    auto const bytes = Bench::Heap::bytes - bytes_before;
+    std::printf("%zu prefixes, %.1f ns/add, %.1f MiB, %.1f B/prefix\n",
+                filter.size(), seconds * 1e9 / prefixes.size(),
+                bytes / (1024.0 * 1024.0), double(bytes) / filter.size());
+
+    // probes inside the prefixes' ranges and outside them
+    constexpr std::size_t probe_count = 1 << 10;
+    std::vector<Multiaddr> ip4_probes;
+    std::vector<Multiaddr> ip6_probes;
+    for (std::size_t i = 0; i < probe_count; ++i) {
+        ip4_probes.emplace_back("/ip4/" + ip4_text(std::uint32_t(rng())) +
+                                "/tcp/4001");
+        ip6_probes.emplace_back(
+            "/ip6/" + ip6_text(0x2000'0000'0000'0000 | rng() >> 4, rng()) +
+            "/udp/4001/quic");
+    }
+
+    std::size_t next{};
+    auto const allocations_before = Bench::Heap::allocations.load();
+    Bench::run("match ip4", 0, [&] {
+        Bench::do_not_optimize(
+            filter.match(ip4_probes[next++ % probe_count]));
+    });
+    Bench::run("match ip6", 0, [&] {
+        Bench::do_not_optimize(
+            filter.match(ip6_probes[next++ % probe_count]));
+    });
+    std::printf("allocations while matching: %zu\n",
+                Bench::Heap::allocations - allocations_before);
+
+    std::size_t matched{};
+    for (auto const& probe : ip4_probes)
+        matched += filter.match(probe) != MultiaddrFilter::Action::None;
+    for (auto const& probe : ip6_probes)
+        matched += filter.match(probe) != MultiaddrFilter::Action::None;
+    std::printf("probes matched: %.1f%%\n", 50.0 * matched / probe_count);
+
+    // what matching through the text form costs, before any lookup
+    Bench::run("to_string ip6 (for comparison)", 0, [&] {
+        Bench::do_not_optimize(ip6_probes[next++ % probe_count].to_string());
+    });
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+// Selecting addresses by pattern from an address book, indexed against a
+// linear scan
+//
+// usage: multiaddr-index-bench [addresses]
+//
+// File Name: multiaddr-index-bench.cpp
+// Date: 2026-10-18
+
+#include "bench.hpp"
+
+#include "multiformats/multiaddr_index.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+    using Multiformats::Multiaddr;
+    using Multiformats::MultiaddrIndex;
+    using Multiformats::MultiaddrPattern;
+
+    /** @brief Address shapes in roughly the mix a DHT peerstore sees */
+    Multiaddr synthetic_address(std::mt19937_64& rng) {
+        auto const ip4 = [&rng] {
+            auto const address = static_cast<std::uint32_t>(rng());
+            return "/ip4/" + std::to_string(address >> 24) + "." +
+                   std::to_string((address >> 16) & 0xff) + "." +
+                   std::to_string((address >> 8) & 0xff) + "." +
+                   std::to_string(address & 0xff);
+        };
+        auto const ip6 = [&rng] {
+            char text[48];
+            std::snprintf(text, sizeof(text), "/ip6/2001:db8::%x:%x",
+                          unsigned(rng() & 0xffff), unsigned(rng() & 0xffff));
+            return std::string{text};
+        };
+        auto const port = [&rng] { return std::to_string(rng() % 65536); };
+
+        switch (rng() % 20) {
+        case 0:
+        case 1:
+        case 2:
+        case 3:
+        case 4:
+            return Multiaddr{ip4() + "/tcp/" + port()};
+        case 5:
+        case 6:
+        case 7:
+        case 8:
+            return Multiaddr{ip4() + "/udp/" + port() + "/quic"};
+        case 9:
+        case 10:
+        case 11:
+            return Multiaddr{ip6() + "/tcp/" + port()};
+        case 12:
+        case 13:
+            return Multiaddr{ip6() + "/udp/" + port() + "/quic"};
+        case 14:
+            return Multiaddr{ip4() + "/udp/" + port() + "/udt"};
+        case 15:
+            return Multiaddr{ip4() + "/tcp/" + port() + "/ws"};
+        case 16:
+            return Multiaddr{"/dns4/node" + std::to_string(rng() % 1000) +
+                             ".example/tcp/443/wss"};
+        case 17:
+            return Multiaddr{ip4() + "/tcp/" + port() + "/p2p-circuit"};
+        case 18:
+            return Multiaddr{ip6() + "/udp/" + port() + "/quic/p2p-circuit"};
+        default:
+            return Multiaddr{ip4() + "/udp/" + port() + "/utp"};
+        }
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const count =
+        argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500'000;
+
+    std::mt19937_64 rng{42};
+    std::vector<Multiaddr> book;
+    MultiaddrIndex index;
+    book.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        book.push_back(synthetic_address(rng));
+        index.add(book.back());
+    }
+
+    std::printf("%zu addresses, %zu signatures\n", index.size(),
+                index.signatures());
+
+    for (auto const* text :
+         {"/ip4/*/udp/*/quic", "/**/p2p-circuit/**", "/**/ws",
+          "/**/tcp/443/**", "/ip6zone/*/**"}) {
+        MultiaddrPattern const pattern{text};
+        auto const matches = index.count(pattern);
+
+        auto const scan = Bench::run(
+            std::string{"scan "} + text, 0,
+            [&] {
+                std::size_t found{};
+                for (auto const& multiaddr : book)
+                    found += pattern.matches(multiaddr);
+                Bench::do_not_optimize(found);
+            },
+            std::chrono::milliseconds{1000});
+        auto const indexed =
+            Bench::run(std::string{"index "} + text, 0, [&] {
+                std::size_t found{};
+                index.query(pattern, [&found](Multiaddr const&) { ++found; });
+                Bench::do_not_optimize(found);
+            });
+
+        std::printf("%-40s %12zu matches %9.1fx\n", "", matches,
+                    scan / indexed);
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Loading a peerstore snapshot, one Multiaddr per line, with the bulk parser
+// against constructing each Multiaddr in turn
+//
+// usage: multiaddr-list-bench [lines]
+//
+// File Name: multiaddr-list-bench.cpp
+// Date: 2026-10-18
+
+#include "bench.hpp"
+
+#include "multiformats/multiaddr_list.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+    using Multiformats::Multiaddr;
+    using Multiformats::MultiaddrList;
+
+    std::string synthetic_line(std::mt19937_64& rng) {
+        auto const address = static_cast<std::uint32_t>(rng());
+        auto const ip4 = "/ip4/" + std::to_string(address >> 24) + "." +
+                         std::to_string((address >> 16) & 0xff) + "." +
+                         std::to_string((address >> 8) & 0xff) + "." +
+                         std::to_string(address & 0xff);
+        auto const port = std::to_string(rng() % 65536);
+
+        switch (rng() % 8) {
+        case 0:
+        case 1:
+        case 2:
+            return ip4 + "/tcp/" + port;
+        case 3:
+        case 4:
+            return ip4 + "/udp/" + port + "/quic";
+        case 5:
+            return "/ip6/2001:db8::" + std::to_string(rng() % 10000) +
+                   "/tcp/" + port;
+        case 6:
+            return ip4 + "/tcp/" + port +
+                   "/p2p/QmcgpsyWgH8Y8ajJz1Cu72KnS5uo2Aa2LpzU7kinSupNKC";
+        default:
+            return "/dns4/node" + std::to_string(rng() % 1000) +
+                   ".example/tcp/443/wss";
+        }
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const lines =
+        argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000;
+
+    std::mt19937_64 rng{42};
+    std::string text;
+    for (std::size_t i = 0; i < lines; ++i) {
+        text += synthetic_line(rng);
+        text += '\n';
+    }
+
+    auto const path = "multiaddr-list-bench.txt";
+    std::ofstream{path, std::ios::binary} << text;
+
+    std::printf("%zu lines, %zu bytes, %u hardware threads\n", lines,
+                text.size(), std::thread::hardware_concurrency());
+
+    auto const serial = Bench::run("Multiaddr per line", text.size(), [&] {
+        std::vector<Multiaddr> parsed;
+        std::string_view rest{text};
+        for (auto end = rest.find('\n'); end != std::string_view::npos;
+             end = rest.find('\n')) {
+            parsed.emplace_back(std::string{rest.substr(0, end)});
+            rest.remove_prefix(end + 1);
+        }
+
+        Bench::do_not_optimize(parsed);
+    });
+
+    for (std::size_t workers : {1, 2, 4, 8, 0}) {
+        MultiaddrList::Options options;
+        options.workers = workers;
+
+        auto const name = "MultiaddrList::parse, " +
+                          (workers == 0 ? std::string{"all"}
+                                        : std::to_string(workers)) +
+                          " workers";
+        auto const ns = Bench::run(name, text.size(), [&] {
+            Bench::do_not_optimize(MultiaddrList::parse(text, options));
+        });
+        std::printf("%-40s %12.1fx\n", "", serial / ns);
+    }
+
+    auto const mapped =
+        Bench::run("MultiaddrList::from_file", text.size(), [&] {
+            Bench::do_not_optimize(MultiaddrList::from_file(path));
+        });
+    std::printf("%-40s %12.1fx\n", "", serial / mapped);
+
+    std::remove(path);
+    return 0;
+}
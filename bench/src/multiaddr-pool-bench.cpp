@@ -0,0 +1,144 @@
+// Synthetic peerstore holding Multiaddr copies against interned handles
+//
+// usage: multiaddr-pool-bench [entries] [distinct addresses]
+//
+// File Name: multiaddr-pool-bench.cpp
+// Date: 2026-10-18
+
+#include "bench.hpp"
+#include "heap.hpp"
+
+#include "multiformats/multiaddr_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+    using Multiformats::Multiaddr;
+    using Multiformats::MultiaddrPool;
+
+    using Clock = std::chrono::steady_clock;
+
+    double seconds_since(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    /** @brief Addresses the way peers announce them, ip4 and ip6 mixed */
+    Multiaddr synthetic_address(std::uint32_t i) {
+        auto const byte = [i](int shift) {
+            return std::to_string((i >> shift) & 0xff);
+        };
+
+        if (i % 2 == 0)
+            return Multiaddr{"/ip4/10." + byte(16) + "." + byte(8) + "." +
+                             byte(0) + "/tcp/4001"};
+
+        char ip6[32];
+        std::snprintf(ip6, sizeof(ip6), "2001:db8::%x:%x", i >> 16, i & 0xffff);
+        return Multiaddr{"/ip6/" + std::string{ip6} + "/udp/4001/quic"};
+    }
+
+    void report(char const* name, std::size_t entries, std::size_t bytes,
+                double seconds) {
+        std::printf("%-40s %8.1f B/entry %8.1f MiB %8.1f ns/entry\n", name,
+                    double(bytes) / entries, bytes / (1024.0 * 1024.0),
+                    seconds * 1e9 / entries);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const entries =
+        argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    std::size_t const distinct =
+        argc > 2 ? std::strtoull(argv[2], nullptr, 10) : entries / 10;
+
+    std::vector<Multiaddr> addresses;
+    addresses.reserve(distinct);
+    for (std::size_t i = 0; i < distinct; ++i)
+        addresses.push_back(synthetic_address(static_cast<std::uint32_t>(i)));
+
+    // which address each peerstore entry refers to
+    std::mt19937_64 rng{42};
+    std::uniform_int_distribution<std::size_t> pick{0, distinct - 1};
+    std::vector<std::uint32_t> refs(entries);
+    for (auto& ref : refs)
+        ref = static_cast<std::uint32_t>(pick(rng));
+
+    std::printf("%zu entries, %zu distinct addresses\n", entries, distinct);
+
+    {
+        auto const before = Bench::Heap::bytes.load();
+        auto const start = Clock::now();
+
+        std::vector<Multiaddr> copies;
+        copies.reserve(entries);
+        for (auto ref : refs)
+            copies.push_back(addresses[ref]);
+
+        report("store copies", entries, Bench::Heap::bytes - before,
+               seconds_since(start));
+    }
+
+    MultiaddrPool pool;
+    std::vector<MultiaddrPool::Handle> handles;
+    {
+        auto const before = Bench::Heap::bytes.load();
+        auto const start = Clock::now();
+
+        handles.reserve(entries);
+        for (auto ref : refs)
+            handles.push_back(pool.intern(addresses[ref].view()));
+
+        report("store interned handles", entries, Bench::Heap::bytes - before,
+               seconds_since(start));
+    }
+
+    std::size_t next{};
+    Bench::run("find interned", 0, [&] {
+        Bench::do_not_optimize(
+            pool.find(addresses[refs[next++ % entries]].view()));
+    });
+    Bench::run("compare handles", 0, [&] {
+        auto const i = next++ % (entries - 1);
+        Bench::do_not_optimize(handles[i] == handles[i + 1]);
+    });
+    Bench::run("compare copies", 0, [&] {
+        auto const i = next++ % (distinct - 1);
+        Bench::do_not_optimize(addresses[i] == addresses[i + 1]);
+    });
+
+    // concurrent interning into a fresh pool, every thread taking a slice
+    auto const hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= hardware; threads *= 2) {
+        MultiaddrPool shared;
+        auto const start = Clock::now();
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (auto i = t; i < entries; i += threads)
+                    Bench::do_not_optimize(
+                        shared.intern(addresses[refs[i]].view()));
+            });
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+
+        auto const seconds = seconds_since(start);
+        std::printf("%-40s %12.1f Mops/s\n",
+                    ("intern " + std::to_string(threads) + " threads").c_str(),
+                    entries / seconds * 1e-6);
+    }
+
+    return 0;
+}
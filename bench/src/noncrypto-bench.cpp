@@ -0,0 +1,30 @@
+// Non-cryptographic multihashes against SHA-256, for bucketing keys
+//
+// File Name: noncrypto-bench.cpp
+// Date: 2026-10-18
+
+#include "bench.hpp"
+
+#include "multiformats/multihash.hpp"
+
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+int main() {
+    for (std::size_t size : {16, 64, 1024, 64 * 1024, 1024 * 1024}) {
+        std::vector<std::uint8_t> input(size, 0xa5);
+        auto const suffix = " " + std::to_string(size) + "B";
+
+        for (auto const* protocol :
+             {"sha2-256", "murmur3-32", "murmur3-128", "xxh3-64", "xxh3-128"}) {
+            Bench::run(protocol + suffix, size, [&] {
+                Bench::do_not_optimize(
+                    Multiformats::Multihash{input, protocol});
+            });
+        }
+    }
+
+    return 0;
+}
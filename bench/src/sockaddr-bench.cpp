@@ -0,0 +1,99 @@
+// Multiaddr to and from sockaddr, against a round trip through text
+//
+// File Name: sockaddr-bench.cpp
+// Date: 2026-10-18
+
+#include "bench.hpp"
+
+#include "multiformats/multiaddr.hpp"
+
+#include <arpa/inet.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+    using Multiformats::Multiaddr;
+
+    // what callers did before: format, split on '/' and use inet_pton
+    socklen_t text_to_sockaddr(Multiaddr const& multiaddr,
+                               sockaddr_storage& out) {
+        auto const text = multiaddr.to_string();
+        std::string_view rest{text};
+        std::string parts[4];
+        for (auto& part : parts) {
+            rest.remove_prefix(1);
+            auto const end = std::min(rest.find('/'), rest.size());
+            part = rest.substr(0, end);
+            rest.remove_prefix(end);
+        }
+
+        auto const port =
+            htons(static_cast<std::uint16_t>(std::stoi(parts[3])));
+        if (parts[0] == "ip4") {
+            sockaddr_in in{};
+            in.sin_family = AF_INET;
+            in.sin_port = port;
+            inet_pton(AF_INET, parts[1].c_str(), &in.sin_addr);
+            std::memcpy(&out, &in, sizeof(in));
+            return sizeof(in);
+        }
+
+        sockaddr_in6 in6{};
+        in6.sin6_family = AF_INET6;
+        in6.sin6_port = port;
+        inet_pton(AF_INET6, parts[1].c_str(), &in6.sin6_addr);
+        std::memcpy(&out, &in6, sizeof(in6));
+        return sizeof(in6);
+    }
+
+    Multiaddr text_from_sockaddr(sockaddr const& address) {
+        char ip[INET6_ADDRSTRLEN];
+        std::uint16_t port;
+        std::string text;
+        if (address.sa_family == AF_INET) {
+            auto const& in = reinterpret_cast<sockaddr_in const&>(address);
+            inet_ntop(AF_INET, &in.sin_addr, ip, sizeof(ip));
+            port = ntohs(in.sin_port);
+            text = "/ip4/";
+        } else {
+            auto const& in6 = reinterpret_cast<sockaddr_in6 const&>(address);
+            inet_ntop(AF_INET6, &in6.sin6_addr, ip, sizeof(ip));
+            port = ntohs(in6.sin6_port);
+            text = "/ip6/";
+        }
+
+        return Multiaddr{text + ip + "/tcp/" + std::to_string(port)};
+    }
+} // namespace
+
+int main() {
+    for (auto const* address : {"/ip4/192.168.1.20/tcp/4001",
+                                "/ip6/2001:db8:85a3::8a2e:370:7334/tcp/4001"}) {
+        Multiaddr const multiaddr{address};
+        auto const suffix = std::string{" "} + std::string{address, 4};
+
+        sockaddr_storage storage;
+        Bench::run("to_sockaddr" + suffix, 0, [&] {
+            Bench::do_not_optimize(multiaddr.to_sockaddr(storage));
+        });
+        Bench::run("text to sockaddr" + suffix, 0, [&] {
+            Bench::do_not_optimize(text_to_sockaddr(multiaddr, storage));
+        });
+
+        multiaddr.to_sockaddr(storage);
+        auto const& socket_address = reinterpret_cast<sockaddr const&>(storage);
+        Bench::run("from_sockaddr" + suffix, 0, [&] {
+            Bench::do_not_optimize(Multiaddr::from_sockaddr(socket_address));
+        });
+        Bench::run("text from sockaddr" + suffix, 0, [&] {
+            Bench::do_not_optimize(text_from_sockaddr(socket_address));
+        });
+    }
+
+    return 0;
+}
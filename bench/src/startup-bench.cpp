@@ -0,0 +1,56 @@
+// Process start up time and memory with the library linked in, against a
+// process that does not link it
+//
+// File Name: startup-bench.cpp
+// Date: 2026-10-18
+
+#include "bench.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+extern char** environ;
+
+namespace {
+    void spawn(char const* path) {
+        char* argv[] = {const_cast<char*>(path), nullptr};
+
+        pid_t pid{};
+        if (posix_spawn(&pid, path, nullptr, nullptr, argv, environ) != 0)
+            throw std::runtime_error(std::string{"failed to spawn "} + path);
+
+        int status{};
+        if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) ||
+            WEXITSTATUS(status) != 0)
+            throw std::runtime_error(std::string{path} + " failed");
+    }
+
+    /** @brief Largest resident set of the children spawned so far, KiB */
+    long max_child_rss() {
+        rusage usage{};
+        getrusage(RUSAGE_CHILDREN, &usage);
+        return usage.ru_maxrss;
+    }
+} // namespace
+
+int main() {
+    auto const baseline = Bench::run("startup without library", 0,
+                                     [] { spawn(STARTUP_PROBE_BASELINE); });
+    auto const baseline_rss = max_child_rss();
+
+    auto const linked = Bench::run("startup with library", 0,
+                                   [] { spawn(STARTUP_PROBE_LIBRARY); });
+    auto const linked_rss = max_child_rss();
+
+    std::printf("%-40s %12.1f ns\n", "library start up overhead",
+                linked - baseline);
+    std::printf("%-40s %12ld KiB\n", "max RSS without library", baseline_rss);
+    std::printf("%-40s %12ld KiB\n", "max RSS with library", linked_rss);
+
+    return 0;
+}
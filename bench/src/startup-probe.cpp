@@ -0,0 +1,33 @@
+// Process that links the library and exits, spawned by startup-bench
+//
+// File Name: startup-probe.cpp
+// Date: 2026-10-18
+
+#ifdef STARTUP_PROBE_LINK_LIBRARY
+#include "multiformats/cid.hpp"
+#include "multiformats/multiaddr.hpp"
+#include "multiformats/multibase.hpp"
+#include "multiformats/multihash.hpp"
+#endif
+
+int main(int argc, char** argv) {
+#ifdef STARTUP_PROBE_LINK_LIBRARY
+    // never taken, but pulls every module and its static state into the
+    // executable
+    if (argc > 1) {
+        using namespace Multiformats;
+
+        Cid cid{argv[1]};
+        Multiaddr addr{argv[1]};
+        Multihash hash{Multibase::decode(argv[1]), argv[1]};
+        return static_cast<int>(
+            cid.to_string(Multibase::Protocol::Base32).size() +
+            addr.to_string().size() + hash.len());
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
+
+    return 0;
+}
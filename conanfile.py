@@ -26,6 +26,7 @@ class MultiformatsConan(ConanFile):
 
     def package(self):
         self.copy("include/*.hpp", dst=".")
+        self.copy("*.hpp", dst="include", src="generated")
         self.copy("*.dll", dst="bin", keep_path=False)
         self.copy("*.so", dst="lib", keep_path=False)
         self.copy("*.dylib", dst="lib", keep_path=False)
@@ -1,10 +1,111 @@
-import sys
+"""Generate the constexpr multicodec tables from the multicodec CSV
+
+usage: csv_to_table.py <table.csv> <output.hpp>
+
+The CSV has a header row followed by name, tag, code and description
+columns, as in the official multicodec table. Entries are written ordered by
+code; where names share a code the first one in the CSV stays first, which
+makes it the canonical name for that code.
+"""
+
 import csv
+import sys
+
+
+# predefined as macros by GCC and Clang in the GNU dialects
+MACROS = {"linux", "unix"}
+
+
+def enumerator(tag):
+    return "".join(part.capitalize() for part in tag.split("-"))
+
+
+def identifier(name):
+    ret = name.replace("-", "_")
+    return ret + "_" if ret in MACROS else ret
+
+
+def main(csv_path, out_path):
+    with open(csv_path, newline="") as csvfile:
+        reader = csv.reader(csvfile, skipinitialspace=True)
+        next(reader)
+        rows = [
+            (row[0].strip(), row[1].strip(), int(row[2].strip(), 16))
+            for row in reader
+            if row
+        ]
+
+    names = set()
+    identifiers = set()
+    for name, _, _ in rows:
+        if name in names or identifier(name) in identifiers:
+            sys.exit("%s: duplicate multicodec name %s" % (csv_path, name))
+        names.add(name)
+        identifiers.add(identifier(name))
+
+    tags = []
+    for _, tag, _ in rows:
+        if tag not in tags:
+            tags.append(tag)
+
+    rows.sort(key=lambda row: row[2])
+
+    lines = [
+        "// Multicodec table -- generated by csv_to_table.py, do not edit",
+        "",
+        "#pragma once",
+        "",
+        "#include <string_view>",
+        "",
+        "#include <cstdint>",
+        "",
+        "namespace Multiformats::Multicodec {",
+        "    /** @brief What kind of thing a code identifies */",
+        "    enum class Tag {",
+    ]
+    lines += ["        %s," % enumerator(tag) for tag in tags]
+    lines += [
+        "    };",
+        "",
+        "    /**",
+        "     * @brief Every code by name, with '-' spelled '_' and a trailing '_'",
+        "     * on names that are predefined macros, e.g. Code::sha2_256 and",
+        "     * Code::unix_",
+        "     */",
+        "    enum class Code : std::uint64_t {",
+    ]
+    lines += [
+        "        %s = 0x%02x," % (identifier(name), code) for name, _, code in rows
+    ]
+    lines += [
+        "    };",
+        "",
+        "    struct Entry {",
+        "        std::string_view name;",
+        "        std::uint64_t code;",
+        "        Tag tag;",
+        "    };",
+        "",
+        "    /**",
+        "     * @brief Protocols and their specific varint code values, ordered",
+        "     * by code",
+        "     *",
+        "     * Where two names share a code the first one is the canonical name.",
+        "     */",
+        "    inline constexpr Entry entries[]{",
+    ]
+    lines += [
+        '        {"%s", 0x%02x, Tag::%s},' % (name, code, enumerator(tag))
+        for name, tag, code in rows
+    ]
+    lines += ["    };", "} // namespace Multiformats::Multicodec", ""]
+
+    with open(out_path, "w") as out:
+        out.write("\n".join(lines))
+
 
-with open(sys.argv[1]) as csvfile:
-    reader = csv.reader(csvfile)
-    print("std::map<std::string, Varint> table {")
-    for row in reader:
-        print("    { \"%s\", %s }," % (row[0], row[2].replace(' ', '')))
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
 
-    print("}")
+    main(sys.argv[1], sys.argv[2])
@@ -0,0 +1,97 @@
+/**
+ * Asynchronous hashing of many files
+ *
+ * @file bulk_hasher.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "multiformats/multihash.hpp"
+#include "multiformats/varint.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <cstddef>
+
+namespace Multiformats {
+    /**
+     * @brief Hashes large sets of files, keeping the storage queue full
+     *
+     * On Linux reads are issued through io_uring with up to queue_depth
+     * requests outstanding, and completed buffers are hashed on a pool of
+     * worker threads. Where io_uring is unavailable (other platforms, old
+     * kernels, or seccomp filters) a pool of threads doing blocking pread
+     * takes its place.
+     */
+    class BulkHasher {
+      public:
+        enum class Engine {
+            /** @brief io_uring if the kernel allows it, else ThreadPool */
+            Auto,
+            IoUring,
+            ThreadPool
+        };
+
+        struct Options {
+            /** @brief Reads in flight, which is also files open at once */
+            std::size_t queue_depth{64};
+
+            /** @brief Size of each read */
+            std::size_t buffer_size{256 * 1024};
+
+            /** @brief Hashing threads, 0 picks one per hardware thread */
+            std::size_t workers{0};
+
+            Engine engine{Engine::Auto};
+        };
+
+        /**
+         * @brief Called once per file, from a worker thread, must not throw
+         *
+         * @param index position of the file in the list passed to hash()
+         * @param multihash hash of the contents, empty if error is set
+         * @param error reason the file could not be read, or the read
+         * could not be submitted, operation_canceled once the ring stopped
+         * taking submissions
+         */
+        using Callback = std::function<void(std::size_t index,
+                                            Multihash const& multihash,
+                                            std::error_code error)>;
+
+        struct Impl;
+
+      private:
+        std::unique_ptr<Impl> impl;
+
+      public:
+        BulkHasher();
+
+        /**
+         * @throw std::system_error if Engine::IoUring is requested and the
+         * ring can't be set up */
+        explicit BulkHasher(Options options);
+        ~BulkHasher();
+
+        /**
+         * @brief Hash every file and block until all callbacks have returned
+         *
+         * @throw std::invalid_argument if function code is not supported
+         * @throw std::system_error if waiting on the ring fails, files not
+         * yet reported then get no callback, and later calls fall back to
+         * Engine::ThreadPool
+         * @throw std::runtime_error if hashing a file fails, once every
+         * worker has stopped, files not yet reported then get no callback */
+        void hash(std::vector<std::string> const& paths,
+                  Varint const& protocol, Callback const& callback);
+        void hash(std::vector<std::string> const& paths,
+                  std::string const& protocol, Callback const& callback);
+
+        /** @brief Engine actually in use */
+        Engine engine() const;
+    };
+} // namespace Multiformats
@@ -8,16 +8,26 @@
 
 #pragma once
 
+#include "multiformats/codec_traits.hpp"
 #include "multiformats/multibase.hpp"
 #include "multiformats/multihash.hpp"
+#include "multiformats/span.hpp"
 #include "multiformats/varint.hpp"
 
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
 namespace Multiformats {
+    class CidKey;
+
     class Cid {
         Varint version;
         Varint content_type;
         Multihash content_address;
 
+        friend class CidKey;
+
       public:
         /** @brief Construct from multibase encoded string */
         Cid(std::string const& encoded);
@@ -29,10 +39,61 @@ namespace Multiformats {
         Cid(Varint const& version, Varint const& content_type,
             Multihash const& content_address);
 
+        /**
+         * @brief Parse a binary CID of a known content type and hash function
+         *
+         * The expected header is built at compile time, so checking it is a
+         * single comparison. A CIDv0 is accepted for dag-pb and sha2-256.
+         *
+         * @throw std::invalid_argument if buf is not a CID of that content
+         * type and hash function, with a full length digest */
+        template <Multicodec::Code ContentType, Multicodec::Code HashFunction>
+        static Cid parse(ByteSpan buf);
+
         /** @brief encode to multibase */
         std::string to_string(Multibase::Protocol const& protocol);
 
         /** @brief to human readable format */
         std::string human_readable(Multibase::Protocol const& protocol);
     };
+
+    template <Multicodec::Code ContentType, Multicodec::Code HashFunction>
+    Cid Cid::parse(ByteSpan buf) {
+        using Multicodec::Code;
+        using Content = Multicodec::codec_traits<ContentType>;
+        using Hash = Multicodec::codec_traits<HashFunction>;
+
+        static_assert(Hash::tag == Multicodec::Tag::Multihash &&
+                          Hash::digest_size != 0 && Hash::digest_size < 0x80,
+                      "hash function must have a fixed digest length");
+
+        // version, content type, hash function, digest length
+        static constexpr auto header = [] {
+            std::array<std::uint8_t,
+                       2 + Content::varint.size() + Hash::varint.size()>
+                ret{};
+            std::size_t i{};
+            ret[i++] = 1;
+            for (auto byte : Content::varint)
+                ret[i++] = byte;
+            for (auto byte : Hash::varint)
+                ret[i++] = byte;
+            ret[i] = Hash::digest_size;
+            return ret;
+        }();
+
+        if constexpr (ContentType == Code::dag_pb &&
+                      HashFunction == Code::sha2_256) {
+            if (buf.size() == 34 && buf[0] == 0x12 && buf[1] == 0x20)
+                return Cid{0, Content::value, Multihash(buf.begin(), buf.end())};
+        }
+
+        if (buf.size() != header.size() + Hash::digest_size ||
+            !std::equal(header.cbegin(), header.cend(), buf.begin()))
+            throw std::invalid_argument("unexpected CID header");
+
+        return Cid{1, Content::value,
+                   Multihash(buf.begin() + 1 + Content::varint.size(),
+                             buf.end())};
+    }
 }; // namespace Multiformats
@@ -0,0 +1,174 @@
+/**
+ * Compact CID for use as a hash map key
+ *
+ * @file cid_key.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "multiformats/cid.hpp"
+#include "multiformats/inline_buffer.hpp"
+#include "multiformats/span.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Multiformats {
+    /**
+     * @brief A CID as its canonical binary form in one buffer
+     *
+     * Binary CIDs of up to inline_capacity bytes, which covers a CIDv1 of a
+     * 512-bit digest, are stored inline; longer ones spill to the heap. The
+     * offsets of the multihash and of its digest are decoded once, so
+     * hashing and comparing read no varints. A CIDv0 is kept as the bare
+     * multihash, so it is a different key from the equivalent CIDv1.
+     */
+    class CidKey {
+      public:
+        /** @brief Number of bytes stored without a heap allocation */
+        static constexpr std::size_t inline_capacity = 72;
+
+      private:
+        struct Header {
+            std::uint8_t multihash_offset{};
+            std::uint8_t digest_offset{};
+        };
+
+        Detail::InlineBuffer<inline_capacity, Header> storage;
+
+        std::uint8_t const* data() const { return storage.data(); }
+        std::size_t size() const { return storage.size(); }
+        std::size_t multihash_offset() const {
+            return storage.header.multihash_offset;
+        }
+        std::size_t digest_offset() const {
+            return storage.header.digest_offset;
+        }
+
+        /** @brief Decode and cache the offsets of the stored bytes */
+        void parse_header();
+
+      public:
+        /** @brief Empty key, equal only to other empty keys */
+        CidKey() = default;
+
+        /**
+         * @brief Copy a binary CID, a CIDv0 being the bare sha2-256
+         * multihash
+         *
+         * @throw std::invalid_argument if binary is not a CIDv0 or CIDv1
+         * with a complete multihash */
+        explicit CidKey(ByteSpan binary);
+
+        /** @brief Copy a binary CID, rather than make a Cid of it first */
+        explicit CidKey(std::vector<std::uint8_t> const& binary)
+            : CidKey(ByteSpan{binary}) {}
+
+        /** @throw std::invalid_argument if cid is not a valid CIDv0 or
+         * CIDv1 */
+        explicit CidKey(Cid const& cid);
+
+        /**
+         * @brief Get the CID this is the key of
+         *
+         * @throw std::invalid_argument if the key is empty */
+        Cid to_cid() const;
+
+        /** @brief Get binary form */
+        ByteSpan to_binary() const { return {data(), size()}; }
+
+        /** @brief 0 for a CIDv0, else the version in the binary */
+        std::uint64_t version() const;
+
+        /** @brief Codec of the content, dag-pb for a CIDv0 */
+        std::uint64_t content_type() const;
+
+        /** @brief Get the multihash, the end of the binary form */
+        ByteSpan multihash() const {
+            return {data() + multihash_offset(), size() - multihash_offset()};
+        }
+
+        /** @brief Get the digest within the multihash */
+        ByteSpan digest() const {
+            return {data() + digest_offset(), size() - digest_offset()};
+        }
+
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief Hash for tables, taken straight from the digest
+         *
+         * The digest of a cryptographic hash is already uniformly
+         * distributed, so its first bytes serve as they are. Identity
+         * multihashes and short digests are hashed in full instead.
+         */
+        std::size_t hash() const noexcept {
+            auto const* const bytes = data();
+            if (size() - digest_offset() >= sizeof(std::size_t) &&
+                bytes[multihash_offset()] != 0) {
+                std::size_t ret;
+                std::memcpy(&ret, bytes + digest_offset(), sizeof(ret));
+                return ret;
+            }
+
+            return std::hash<std::string_view>{}(
+                {reinterpret_cast<char const*>(bytes), size()});
+        }
+
+        /**
+         * @brief Order binary forms as byte strings
+         *
+         * @return less than, equal to or greater than 0 as this is before,
+         * equal to or after other
+         */
+        int compare(CidKey const& other) const {
+            auto const common = std::min(size(), other.size());
+            auto const ret = std::memcmp(data(), other.data(), common);
+            if (ret != 0)
+                return ret;
+
+            return size() < other.size() ? -1 : size() > other.size();
+        }
+
+        bool operator==(CidKey const& other) const {
+            return size() == other.size() &&
+                   std::memcmp(data(), other.data(), size()) == 0;
+        }
+
+        bool operator!=(CidKey const& other) const {
+            return !(*this == other);
+        }
+
+        bool operator<(CidKey const& other) const {
+            return compare(other) < 0;
+        }
+
+        bool operator>(CidKey const& other) const {
+            return compare(other) > 0;
+        }
+
+        bool operator<=(CidKey const& other) const {
+            return compare(other) <= 0;
+        }
+
+        bool operator>=(CidKey const& other) const {
+            return compare(other) >= 0;
+        }
+    };
+} // namespace Multiformats
+
+namespace std {
+    template <>
+    struct hash<Multiformats::CidKey> {
+        size_t operator()(Multiformats::CidKey const& key) const noexcept {
+            return key.hash();
+        }
+    };
+} // namespace std
@@ -0,0 +1,70 @@
+/**
+ * Concurrent set of CIDs
+ *
+ * @file cid_set.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "multiformats/cid.hpp"
+#include "multiformats/cid_key.hpp"
+
+#include <memory>
+
+#include <cstddef>
+
+namespace Multiformats {
+    /**
+     * @brief Thread-safe set of CIDs, for deduplicating blocks
+     *
+     * CIDs are stored as CidKeys and spread over shards by the first bytes
+     * of their digest, each shard behind its own reader-writer lock. Threads
+     * adding different CIDs rarely contend, and lookups of CIDs already seen
+     * only share a lock.
+     */
+    class CidSet {
+      public:
+        struct Impl;
+
+      private:
+        std::unique_ptr<Impl> impl;
+
+      public:
+        /**
+         * @param shards independently locked parts, rounded up to a power
+         * of two
+         * @throw std::invalid_argument if shards is 0
+         */
+        explicit CidSet(std::size_t shards = 64);
+
+        ~CidSet();
+
+        /**
+         * @brief Add a CID unless it is already in the set
+         *
+         * @return true if it was added, false if it was already there
+         */
+        bool insert(CidKey key);
+
+        /** @throw like CidKey(Cid const&) */
+        bool insert(Cid const& cid) { return insert(CidKey{cid}); }
+
+        bool contains(CidKey const& key) const;
+
+        /** @throw like CidKey(Cid const&) */
+        bool contains(Cid const& cid) const { return contains(CidKey{cid}); }
+
+        /** @return true if the CID was in the set */
+        bool erase(CidKey const& key);
+
+        /** @throw like CidKey(Cid const&) */
+        bool erase(Cid const& cid) { return erase(CidKey{cid}); }
+
+        /**
+         * @brief Number of CIDs, only exact while no other thread changes
+         * the set
+         */
+        std::size_t size() const;
+    };
+} // namespace Multiformats
@@ -0,0 +1,112 @@
+/**
+ * Non-owning CID parsed in place
+ *
+ * @file cid_view.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "multiformats/span.hpp"
+
+#include <string_view>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats {
+    /** @brief Why bytes or text are not a CID */
+    enum class CidError : std::uint8_t {
+        None,
+
+        /** @brief Ends inside a varint or the digest */
+        Truncated,
+
+        /** @brief Bytes follow the digest */
+        TrailingBytes,
+
+        /** @brief Neither a CIDv0 nor a CIDv1 */
+        Version,
+
+        /** @brief Text with an unknown base or characters not in it */
+        Multibase,
+
+        /** @brief Text decodes to more than the buffer holds */
+        BufferTooSmall
+    };
+
+    /** @brief Describe an error */
+    char const* to_string(CidError error);
+
+    /**
+     * @brief The fields of a binary CID, pointing into its bytes
+     *
+     * Parsing reads the version, content type and multihash header and
+     * checks the digest length, without copying or allocating and without
+     * throwing. The view is valid as long as the bytes it was parsed from.
+     */
+    class CidView {
+        ByteSpan bytes;
+        std::uint64_t cid_version{};
+        std::uint64_t codec{};
+        std::uint64_t function{};
+        std::uint8_t multihash_offset{};
+        std::uint8_t digest_offset{};
+
+      public:
+        CidView() = default;
+
+        /**
+         * @brief Parse a binary CID, a CIDv0 being the bare sha2-256
+         * multihash
+         *
+         * @param out set if there's no error, else unchanged
+         */
+        static CidError parse(ByteSpan binary, CidView& out);
+
+        /**
+         * @brief Decode a CID's text into buffer, then parse it from there
+         *
+         * Takes a multibase string, or a CIDv0 as the 46 base58btc
+         * characters starting "Qm". Base58btc, base16, unpadded base32 and
+         * unpadded base64 are decoded straight into buffer; other bases go
+         * through Multibase::decode. No base makes text shorter than its
+         * binary, so a buffer of text.size() bytes is always enough.
+         *
+         * @throw std::bad_alloc if a base decoded through Multibase::decode
+         * runs out of memory, malformed text is only ever an error code
+         * @param out set if there's no error, else unchanged, pointing into
+         * buffer
+         */
+        static CidError parse(std::string_view text, Span<std::uint8_t> buffer,
+                              CidView& out);
+
+        /** @brief 0 for a CIDv0, else 1 */
+        std::uint64_t version() const { return cid_version; }
+
+        /** @brief Codec of the content, dag-pb for a CIDv0 */
+        std::uint64_t content_type() const { return codec; }
+
+        /** @brief Function code of the multihash */
+        std::uint64_t hash_function() const { return function; }
+
+        /** @brief Length of the digest, in bytes */
+        std::size_t digest_size() const {
+            return bytes.size() - digest_offset;
+        }
+
+        /** @brief Get the digest, within the bytes parsed */
+        ByteSpan digest() const {
+            return {bytes.data() + digest_offset, digest_size()};
+        }
+
+        /** @brief Get the multihash, the end of the binary form */
+        ByteSpan multihash() const {
+            return {bytes.data() + multihash_offset,
+                    bytes.size() - multihash_offset};
+        }
+
+        /** @brief Get binary form */
+        ByteSpan to_binary() const { return bytes; }
+    };
+} // namespace Multiformats
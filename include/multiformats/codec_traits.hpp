@@ -0,0 +1,154 @@
+/**
+ * Compile time properties of multicodec codes
+ *
+ * @file codec_traits.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "multiformats/multicodec.hpp"
+#include "multiformats/varint.hpp"
+
+#include <array>
+#include <optional>
+#include <string_view>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats::Multicodec {
+    /**
+     * @brief Length of the digest a hash function produces, 0 if the code
+     * is not a hash function with a fixed length
+     *
+     * SHAKE digests are the 128 and 256 bit default output lengths.
+     */
+    constexpr std::size_t digest_size(Code code) {
+        auto const value = static_cast<std::uint64_t>(code);
+
+        // BLAKE2 and Skein codes are contiguous, one per byte of digest
+        if (value >= 0xb201 && value <= 0xb240)
+            return value - 0xb200;
+        if (value >= 0xb241 && value <= 0xb260)
+            return value - 0xb240;
+        if (value >= 0xb301 && value <= 0xb320)
+            return value - 0xb300;
+        if (value >= 0xb321 && value <= 0xb360)
+            return value - 0xb320;
+        if (value >= 0xb361 && value <= 0xb3e0)
+            return value - 0xb360;
+
+        switch (code) {
+        case Code::murmur3_32:
+            return 4;
+        case Code::xxh3_64:
+            return 8;
+        case Code::md4:
+        case Code::md5:
+        case Code::murmur3_128:
+        case Code::shake_128:
+        case Code::xxh3_128:
+            return 16;
+        case Code::sha1:
+            return 20;
+        case Code::sha3_224:
+        case Code::keccak_224:
+            return 28;
+        case Code::sha2_256:
+        case Code::sha3_256:
+        case Code::keccak_256:
+        case Code::shake_256:
+        case Code::dbl_sha2_256:
+        case Code::bmt:
+        case Code::x11:
+            return 32;
+        case Code::sha3_384:
+        case Code::keccak_384:
+            return 48;
+        case Code::sha2_512:
+        case Code::sha3_512:
+        case Code::keccak_512:
+            return 64;
+        default:
+            return 0;
+        }
+    }
+
+    /** @brief Value length of a multiaddr component that is varint prefixed */
+    constexpr int variable_size = -1;
+
+    /**
+     * @brief Length of the value of a multiaddr component
+     *
+     * @return bytes of a fixed length value, 0 if the protocol takes no
+     * value, variable_size if the value is prefixed with its varint length,
+     * std::nullopt if code is not a supported multiaddr protocol
+     */
+    constexpr std::optional<int> value_size(Code code) {
+        switch (code) {
+        case Code::ip4:
+            return 4;
+        case Code::tcp:
+        case Code::udp:
+        case Code::dccp:
+        case Code::sctp:
+            return 2;
+        case Code::ip6:
+            return 16;
+        case Code::onion:
+            return 12;
+        case Code::onion3:
+            return 37;
+        case Code::ip6zone:
+        case Code::dns:
+        case Code::dns4:
+        case Code::dns6:
+        case Code::dnsaddr:
+        case Code::unix_:
+        case Code::p2p:
+        case Code::garlic64:
+        case Code::garlic32:
+            return variable_size;
+        case Code::udt:
+        case Code::utp:
+        case Code::quic:
+        case Code::http:
+        case Code::https:
+        case Code::ws:
+        case Code::wss:
+        case Code::p2p_websocket_star:
+        case Code::p2p_stardust:
+        case Code::p2p_webrtc_star:
+        case Code::p2p_webrtc_direct:
+        case Code::p2p_circuit:
+            return 0;
+        default:
+            return std::nullopt;
+        }
+    }
+
+    /** @brief Properties of a code known at compile time */
+    template <Code C>
+    struct codec_traits {
+        static constexpr Code code = C;
+        static constexpr std::uint64_t value = static_cast<std::uint64_t>(C);
+
+        static constexpr std::string_view name = Multicodec::name(value);
+        static constexpr Tag tag = entries[Detail::index(value)].tag;
+
+        /** @brief See Multicodec::digest_size() */
+        static constexpr std::size_t digest_size = Multicodec::digest_size(C);
+
+        /** @brief See Multicodec::value_size() */
+        static constexpr std::optional<int> value_size =
+            Multicodec::value_size(C);
+
+        /** @brief The code as an unsigned varint */
+        static constexpr auto varint = [] {
+            std::array<std::uint8_t, varint_size(value)> ret{};
+            encode_varint(value, ret.data());
+            return ret;
+        }();
+    };
+} // namespace Multiformats::Multicodec
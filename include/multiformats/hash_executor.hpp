@@ -0,0 +1,106 @@
+/**
+ * Multihash generation on a pool of worker threads
+ *
+ * @file hash_executor.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "multiformats/multihash.hpp"
+#include "multiformats/span.hpp"
+#include "multiformats/varint.hpp"
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats {
+    /**
+     * @brief Work stealing thread pool producing Multihashes
+     *
+     * Every worker owns a queue. Jobs submitted from outside go to the
+     * queues round robin, jobs submitted from a worker (from a callback) go
+     * to its own queue, and a worker whose queue is empty steals from the
+     * others. Small jobs with the same function code are taken off a queue
+     * together and hashed back to back with one digest context, as
+     * Multihash::hash_each does.
+     *
+     * The number of queued jobs is bounded: once queue_capacity jobs are
+     * waiting, submit() blocks until a worker takes one. Calling submit()
+     * from a callback can therefore deadlock if every worker does so while
+     * the queues are full.
+     */
+    class HashExecutor {
+      public:
+        struct Options {
+            /** @brief Worker threads, 0 picks one per hardware thread */
+            std::size_t workers{0};
+
+            /** @brief Jobs waiting before submit() blocks */
+            std::size_t queue_capacity{1024};
+
+            /** @brief Jobs of at most this many bytes may be batched */
+            std::size_t small_job{16 * 1024};
+
+            /** @brief Most small jobs taken off a queue at once */
+            std::size_t batch_size{32};
+        };
+
+        /**
+         * @brief Called from a worker thread with the result of a job, must
+         * not throw
+         *
+         * @param multihash hash of the buffer, empty if error is set
+         * @param error exception hashing failed with, e.g.
+         * std::invalid_argument for an unsupported function code
+         */
+        using Callback = std::function<void(Multihash const& multihash,
+                                            std::exception_ptr error)>;
+
+        struct Impl;
+
+      private:
+        std::unique_ptr<Impl> impl;
+
+      public:
+        HashExecutor();
+
+        /** @throw std::invalid_argument if capacity or batch size is 0 */
+        explicit HashExecutor(Options options);
+
+        /** @brief Finishes every submitted job, then joins the workers */
+        ~HashExecutor();
+
+        /** @brief Hash a buffer the executor takes ownership of */
+        std::future<Multihash> submit(std::vector<std::uint8_t>&& buffer,
+                                      Varint const& protocol);
+
+        /**
+         * @brief Hash a borrowed buffer
+         *
+         * The bytes must stay alive and unmodified until the future is
+         * ready. */
+        std::future<Multihash> submit(ByteSpan buffer, Varint const& protocol);
+
+        /** @brief Hash an owned buffer, reporting through callback */
+        void submit(std::vector<std::uint8_t>&& buffer, Varint const& protocol,
+                    Callback callback);
+
+        /**
+         * @brief Hash a borrowed buffer, reporting through callback
+         *
+         * The bytes must stay alive and unmodified until callback is
+         * called. */
+        void submit(ByteSpan buffer, Varint const& protocol,
+                    Callback callback);
+
+        /** @brief Number of worker threads */
+        std::size_t size() const;
+    };
+} // namespace Multiformats
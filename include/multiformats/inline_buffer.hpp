@@ -0,0 +1,126 @@
+/**
+ * Byte storage that holds short contents inline
+ *
+ * @file inline_buffer.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats::Detail {
+    /**
+     * @brief Up to Capacity bytes stored inline, longer contents on the heap
+     *
+     * The owner keeps the fields it decodes from the bytes, such as offsets
+     * into them, in header, which sits in what would otherwise be padding.
+     * Whatever empties the buffer resets header too, so those fields never
+     * outlive the bytes: a moved from buffer is empty, and a copy or
+     * assign() allocates before it releases anything, so a throw leaves
+     * the buffer as it was.
+     */
+    template <std::size_t Capacity, typename Header>
+    class InlineBuffer {
+        union {
+            std::uint8_t inline_buf[Capacity];
+            std::uint8_t* heap_buf;
+        };
+
+        std::uint32_t length{};
+
+        bool is_inline() const { return length <= Capacity; }
+
+        /** @brief Take other's contents, leaving it empty */
+        void steal(InlineBuffer& other) noexcept {
+            length = other.length;
+            header = other.header;
+            if (other.is_inline())
+                std::copy_n(other.inline_buf, length, inline_buf);
+            else
+                heap_buf = other.heap_buf;
+
+            other.length = 0;
+            other.header = {};
+        }
+
+      public:
+        /** @brief Fields decoded from the bytes, reset when they go */
+        Header header{};
+
+        InlineBuffer() {}
+
+        /**
+         * @brief Storage for size bytes, left uninitialised
+         *
+         * @throw std::invalid_argument if size doesn't fit in 32 bits */
+        explicit InlineBuffer(std::size_t size) {
+            if (size > std::numeric_limits<decltype(length)>::max())
+                throw std::invalid_argument("buffer is too large");
+
+            // allocate before recording the length, so a throw leaves
+            // nothing to free
+            if (size > Capacity)
+                heap_buf = new std::uint8_t[size];
+
+            length = static_cast<decltype(length)>(size);
+        }
+
+        InlineBuffer(InlineBuffer const& other)
+            : InlineBuffer(other.size()) {
+            std::copy_n(other.data(), length, data());
+            header = other.header;
+        }
+
+        InlineBuffer(InlineBuffer&& other) noexcept { steal(other); }
+
+        InlineBuffer& operator=(InlineBuffer const& other) {
+            if (this != &other)
+                *this = InlineBuffer{other};
+
+            return *this;
+        }
+
+        InlineBuffer& operator=(InlineBuffer&& other) noexcept {
+            if (this != &other) {
+                clear();
+                steal(other);
+            }
+
+            return *this;
+        }
+
+        ~InlineBuffer() { clear(); }
+
+        /**
+         * @brief Replace the contents with size uninitialised bytes
+         *
+         * @return where to write them
+         * @throw std::invalid_argument if size doesn't fit in 32 bits */
+        std::uint8_t* assign(std::size_t size) {
+            *this = InlineBuffer{size};
+            return data();
+        }
+
+        /** @brief Release heap storage, if any, and become empty */
+        void clear() noexcept {
+            if (!is_inline())
+                delete[] heap_buf;
+
+            length = 0;
+            header = {};
+        }
+
+        std::uint8_t* data() { return is_inline() ? inline_buf : heap_buf; }
+        std::uint8_t const* data() const {
+            return is_inline() ? inline_buf : heap_buf;
+        }
+
+        std::size_t size() const { return length; }
+    };
+} // namespace Multiformats::Detail
@@ -8,42 +8,227 @@
 
 #pragma once
 
-#include "varint.hpp"
+#include "multiformats/multicodec_table.hpp"
+#include "multiformats/span.hpp"
 
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <iterator>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include <cstddef>
 #include <cstdint>
 
+#if __has_include(<netinet/in.h>)
+#include <netinet/in.h>
+#include <sys/socket.h>
+#define MULTIFORMATS_HAS_SOCKADDR 1
+#endif
+
 namespace Multiformats {
+    class MultiaddrView;
+
+    /** @brief Why text is not a valid multiaddr */
+    enum class MultiaddrError : std::uint8_t {
+        None,
+
+        /** @brief Empty, or doesn't start with '/' */
+        Syntax,
+
+        /** @brief A protocol name no multicodec has */
+        UnknownProtocol,
+
+        /** @brief A multicodec that multiaddrs don't support */
+        UnsupportedProtocol,
+
+        /** @brief A protocol that takes a value ends the text */
+        MissingValue,
+
+        /** @brief A value its protocol can't parse */
+        InvalidValue,
+
+        /** @brief The binary form would be longer than Multiaddr::max_size */
+        TooLong
+    };
+
+    /** @brief Describe an error, as exceptions do */
+    char const* to_string(MultiaddrError error);
+
+    /**
+     * @brief Network address made of protocol components
+     *
+     * The canonical binary form is kept in a single buffer, and the offsets
+     * of the first inline_components components are kept inline, so
+     * to_binary() is free and front(), back() and size() don't walk the
+     * buffer.
+     */
     class Multiaddr {
-        struct Protocol {
-            Varint code;
-            std::vector<std::uint8_t> value;
+      public:
+        /** @brief A protocol code and its value, pointing into the buffer */
+        struct Component {
+            std::uint64_t code{};
+            ByteSpan value{};
 
+            /** @brief Get the value in human-readable form */
             std::string to_string() const;
         };
 
-        std::vector<Protocol> addr;
+        /** @brief Decodes one component at a time from the binary form */
+        class ConstIterator {
+            std::uint8_t const* pos{};
+            std::uint8_t const* next{};
+            std::uint8_t const* last{};
+            Component current{};
 
-      public:
-        using ConstIterator = typename decltype(addr)::const_iterator;
-        using ConstReference = typename decltype(addr)::const_reference;
+            void decode();
+
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Component;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Component const*;
+            using reference = Component const&;
+
+            ConstIterator() = default;
 
-        /** @brief Construct from human-readable string */
+            /** @brief Iterate a binary multiaddr that is known to be valid */
+            ConstIterator(std::uint8_t const* begin, std::uint8_t const* end);
+
+            reference operator*() const { return current; }
+            pointer operator->() const { return &current; }
+
+            ConstIterator& operator++() {
+                pos = next;
+                decode();
+                return *this;
+            }
+
+            ConstIterator operator++(int) {
+                auto ret = *this;
+                ++*this;
+                return ret;
+            }
+
+            bool operator==(ConstIterator const& other) const {
+                return pos == other.pos;
+            }
+
+            bool operator!=(ConstIterator const& other) const {
+                return pos != other.pos;
+            }
+        };
+
+        /** @brief Number of components whose offsets are stored inline */
+        static constexpr std::size_t inline_components = 8;
+
+        /** @brief Largest binary form, offsets are 16 bit */
+        static constexpr std::size_t max_size = 0xffff;
+
+      private:
+        std::vector<std::uint8_t> bytes;
+        std::uint16_t count{};
+        std::array<std::uint16_t, inline_components> offsets{};
+
+        /** @brief Record that a component starts at offset */
+        void push_offset(std::size_t offset);
+
+        /** @brief Offset of the component at index, which is < count */
+        std::size_t offset(std::size_t index) const;
+
+        Multiaddr() = default;
+
+        /** @brief Copy of components [first, last), without re-validating */
+        Multiaddr slice(std::size_t first, std::size_t last) const;
+
+      public:
+        /** @brief Construct from human-readable string
+         *
+         *  @throw std::out_of_range if a protocol name is unknown
+         *  @throw std::invalid_argument if the text is otherwise invalid */
         Multiaddr(std::string const& address);
 
-        /** @brief Construct from binary */
+        /** @brief Construct from binary
+         *
+         *  @throw std::invalid_argument if the binary is truncated
+         *  @throw std::runtime_error if a protocol is not supported */
         Multiaddr(std::vector<std::uint8_t> const& raw);
 
+        /** @brief Copy a view, validating every component
+         *
+         *  @throw std::invalid_argument if the binary is truncated
+         *  @throw std::runtime_error if a protocol is not supported */
+        explicit Multiaddr(MultiaddrView view);
+
         /** @brief Get human-readable string */
         std::string to_string() const;
 
         /** @brief Get binary form */
-        std::vector<std::uint8_t> to_binary() const;
+        std::vector<std::uint8_t> const& to_binary() const { return bytes; }
+
+        /** @brief Get a view of the binary form */
+        MultiaddrView view() const;
+
+        /**
+         * @brief Append the components of other, e.g. a /p2p component to a
+         * transport address
+         *
+         * @throw std::invalid_argument if the result would be longer than
+         * max_size
+         */
+        Multiaddr encapsulate(Multiaddr const& other) const;
+
+        /**
+         * @brief Remove the last component with code, and everything after it
+         *
+         * @return a copy if no component has code
+         */
+        Multiaddr decapsulate(Multicodec::Code code) const;
+
+        /** @brief Check whether the first components are those of prefix */
+        bool starts_with(Multiaddr const& prefix) const;
+
+        /**
+         * @brief Split into the first index components and the rest
+         *
+         * @throw std::out_of_range if index is greater than size()
+         */
+        std::pair<Multiaddr, Multiaddr> split_at(std::size_t index) const;
+
+#ifdef MULTIFORMATS_HAS_SOCKADDR
+        /**
+         * @brief Make an /ip4 or /ip6 address with a port
+         *
+         * A nonzero sin6_scope_id becomes an /ip6zone component, named after
+         * the interface if it has one.
+         *
+         * @param transport tcp, udp, dccp or sctp
+         * @throw std::invalid_argument if address is not AF_INET or AF_INET6,
+         * or transport does not take a port
+         */
+        static Multiaddr
+        from_sockaddr(sockaddr const& address,
+                      Multicodec::Code transport = Multicodec::Code::tcp);
+
+        /**
+         * @brief Fill a socket address from the leading components
+         *
+         * Reads an optional /ip6zone, then /ip4 or /ip6, then a tcp, udp,
+         * dccp or sctp port straight from the binary form. Any components
+         * after the port, such as /p2p, are ignored.
+         *
+         * @return the length of the address written
+         * @throw std::invalid_argument if the address doesn't start with an
+         * IP address and port, or the zone is not a known interface
+         */
+        socklen_t to_sockaddr(sockaddr_storage& out) const;
+#endif
 
-        /** @brief Get size of multiaddr */
-        std::size_t size() const;
+        /** @brief Get number of components in multiaddr */
+        std::size_t size() const { return count; }
 
         /** @brief Get iterator to beginning of multiaddr */
         ConstIterator begin() const;
@@ -51,9 +236,88 @@ namespace Multiformats {
         /** @brief Get iterator to end of multiaddr */
         ConstIterator end() const;
 
-        ConstReference front() const;
+        Component front() const;
+
+        Component back() const;
+
+        /** @brief Compare binary forms */
+        bool operator==(Multiaddr const& other) const {
+            return bytes == other.bytes;
+        }
+
+        bool operator!=(Multiaddr const& other) const {
+            return bytes != other.bytes;
+        }
+    };
+
+    /**
+     * @brief Non-owning multiaddr over binary bytes
+     *
+     * Nothing is checked up front; each component is validated when the
+     * iterator reaches it, so inspecting the first few components of a
+     * received address doesn't decode the rest. Comparison and hashing are
+     * on the raw bytes.
+     */
+    class MultiaddrView {
+        ByteSpan bytes;
+
+      public:
+        using ConstIterator = Multiaddr::ConstIterator;
+
+        MultiaddrView() = default;
+
+        constexpr MultiaddrView(ByteSpan binary)
+            : bytes(binary) {}
+
+        /** @brief Get binary form */
+        constexpr ByteSpan to_binary() const { return bytes; }
+
+        constexpr bool empty() const { return bytes.empty(); }
+
+        /** @brief Get human-readable string
+         *
+         *  @throw std::invalid_argument if the binary is truncated
+         *  @throw std::runtime_error if a protocol is not supported */
+        std::string to_string() const;
 
-        ConstReference back() const;
+        /** @brief Get iterator to the first component
+         *
+         *  Iterators throw like to_string() when they reach a component that
+         *  is not valid. */
+        ConstIterator begin() const { return {bytes.begin(), bytes.end()}; }
 
+        /** @brief Get iterator to end of multiaddr */
+        ConstIterator end() const { return {bytes.end(), bytes.end()}; }
+
+        bool operator==(MultiaddrView const& other) const {
+            return std::equal(bytes.begin(), bytes.end(), other.bytes.begin(),
+                              other.bytes.end());
+        }
+
+        bool operator!=(MultiaddrView const& other) const {
+            return !(*this == other);
+        }
     };
+
+    inline MultiaddrView Multiaddr::view() const { return {bytes}; }
 } // namespace Multiformats
+
+namespace std {
+    template <>
+    struct hash<Multiformats::MultiaddrView> {
+        size_t operator()(Multiformats::MultiaddrView view) const noexcept {
+            auto const binary = view.to_binary();
+            return hash<string_view>{}(
+                {reinterpret_cast<char const*>(binary.data()), binary.size()});
+        }
+    };
+
+    /** @brief Hash of the binary form, the same as of its view */
+    template <>
+    struct hash<Multiformats::Multiaddr> {
+        size_t operator()(Multiformats::Multiaddr const& multiaddr) const
+            noexcept {
+            return hash<Multiformats::MultiaddrView>{}(multiaddr.view());
+        }
+    };
+} // namespace std
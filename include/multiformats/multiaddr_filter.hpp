@@ -0,0 +1,114 @@
+/**
+ * Allow and deny lists of IP prefixes for Multiaddrs
+ *
+ * @file multiaddr_filter.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "multiformats/multiaddr.hpp"
+
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats {
+    /**
+     * @brief Longest prefix match of a Multiaddr's IP address against CIDR
+     * prefixes
+     *
+     * Prefixes are held in a path compressed binary (Patricia) trie over
+     * 128 bit keys, IPv4 prefixes being stored as IPv4-mapped IPv6 ones.
+     * Nodes sit in one array and link by index. Once the trie is large, a
+     * table per address family indexed by the 16 bits after the family's
+     * base prefix holds where the walk for those bits starts, so a match
+     * skips the top of the trie. A match doesn't allocate.
+     *
+     * match() may be called from several threads at once, add() may not
+     * run at the same time as anything else.
+     */
+    class MultiaddrFilter {
+      public:
+        enum class Action : std::uint8_t { None, Accept, Deny };
+
+      private:
+        struct Key {
+            std::uint64_t high{};
+            std::uint64_t low{};
+        };
+
+        struct Node {
+            Key prefix;
+            std::uint32_t children[2]{};
+            std::uint8_t length{};
+            Action action{Action::None};
+        };
+
+        /**
+         * @brief Starting points of walks for the addresses under base
+         *
+         * Entry i is for the addresses whose 16 bits after base are i. It
+         * packs the deepest node no longer than length + 16 bits on their
+         * path, shifted left by 2, with the action of the longest prefix
+         * above it. Empty until the trie has index_threshold nodes.
+         */
+        struct Index {
+            Key base;
+            std::size_t length;
+            std::vector<std::uint32_t> entries;
+        };
+
+        static constexpr std::size_t index_bits = 16;
+        static constexpr std::size_t index_threshold = 1024;
+
+        // node 0 is the root, the zero length prefix, so a child index of
+        // 0 means no child
+        std::vector<Node> nodes{1};
+        std::size_t count{};
+        Index ip4_index{{0, 0xffff00000000}, 96, {}};
+        Index ip6_index{{0, 0}, 0, {}};
+
+        void add(Key key, std::size_t length, Action action);
+
+        /** @brief Update the entries of walks through a changed node */
+        void reindex(Index& index, std::uint32_t node);
+
+        /** @brief Point the entries under node and its children at them */
+        void fill(Index& index, std::uint32_t node, Action above);
+
+        Action match(Key key, Index const& index) const;
+
+      public:
+        /**
+         * @brief Set the action for a prefix such as "10.0.0.0/8" or
+         * "2001:db8::/32"
+         *
+         * Host bits are ignored. Adding a prefix again replaces its action,
+         * and Action::None removes it.
+         *
+         * @throw std::invalid_argument if cidr is not an IPv4 or IPv6 prefix
+         */
+        void add(std::string_view cidr, Action action);
+
+        /**
+         * @brief Action of the longest prefix containing the address
+         *
+         * The address is the leading /ip4 or /ip6 component, after an
+         * optional /ip6zone.
+         *
+         * @return Action::None if the address doesn't start with an IP
+         * address or no prefix contains it
+         */
+        Action match(MultiaddrView multiaddr) const;
+
+        Action match(Multiaddr const& multiaddr) const {
+            return match(multiaddr.view());
+        }
+
+        /** @brief Number of prefixes with an action */
+        std::size_t size() const { return count; }
+    };
+} // namespace Multiformats
@@ -0,0 +1,121 @@
+/**
+ * Selecting Multiaddrs by the shape of their protocols
+ *
+ * @file multiaddr_index.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "multiformats/multiaddr.hpp"
+#include "multiformats/span.hpp"
+
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats {
+    /**
+     * @brief Compiled shape of Multiaddrs: protocols in order, with or
+     * without their values
+     *
+     * Written like a multiaddr, except that "*" in place of a value matches
+     * any value and a "**" part in place of a protocol matches any number
+     * of components. So the pattern for QUIC over IPv4 is ip4, udp and
+     * quic with "*" for both values, and the one for relayed addresses is
+     * p2p-circuit between two "**" parts.
+     */
+    class MultiaddrPattern {
+        struct Step {
+            /** @brief Any number of components, the other fields unused */
+            bool gap{};
+            std::uint64_t code{};
+            bool any_value{true};
+            std::vector<std::uint8_t> value;
+        };
+
+        std::vector<Step> steps;
+        bool values{};
+
+      public:
+        /**
+         * @throw std::out_of_range if a protocol name is unknown
+         * @throw std::invalid_argument if the pattern is otherwise invalid
+         */
+        explicit MultiaddrPattern(std::string_view pattern);
+
+        /** @throw std::invalid_argument if multiaddr is invalid */
+        bool matches(MultiaddrView multiaddr) const;
+
+        bool matches(Multiaddr const& multiaddr) const {
+            return matches(multiaddr.view());
+        }
+
+        /**
+         * @brief Whether a multiaddr with these protocol codes, in order,
+         * can match
+         *
+         * Every such multiaddr matches unless has_values().
+         */
+        bool matches_codes(Span<std::uint64_t const> codes) const;
+
+        /** @brief Whether the pattern has values other than "*" */
+        bool has_values() const { return values; }
+    };
+
+    /**
+     * @brief Set of Multiaddrs grouped by signature, the sequence of their
+     * protocol codes
+     *
+     * A query tests the pattern once per signature and visits only the
+     * addresses in the groups that can match, reading their values only if
+     * the pattern has some. Address books hold few distinct signatures, so
+     * a query costs about as much as its results.
+     *
+     * Not thread-safe.
+     */
+    class MultiaddrIndex {
+      public:
+        using Callback = std::function<void(Multiaddr const& multiaddr)>;
+
+        struct Impl;
+
+      private:
+        std::unique_ptr<Impl> impl;
+
+      public:
+        MultiaddrIndex();
+
+        ~MultiaddrIndex();
+
+        /** @return false if the index already holds the address */
+        bool add(Multiaddr multiaddr);
+
+        /** @return false if the index doesn't hold the address */
+        bool remove(MultiaddrView multiaddr);
+
+        bool contains(MultiaddrView multiaddr) const;
+
+        /**
+         * @brief Call callback with every address pattern matches
+         *
+         * Addresses come grouped by signature, in no particular order.
+         * callback must not change the index.
+         */
+        void query(MultiaddrPattern const& pattern,
+                   Callback const& callback) const;
+
+        /** @brief Number of addresses pattern matches */
+        std::size_t count(MultiaddrPattern const& pattern) const;
+
+        /** @brief Number of addresses */
+        std::size_t size() const;
+
+        /** @brief Number of distinct signatures among the addresses */
+        std::size_t signatures() const;
+    };
+} // namespace Multiformats
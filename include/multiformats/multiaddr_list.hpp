@@ -0,0 +1,104 @@
+/**
+ * Bulk parsing of Multiaddrs from text, one per line
+ *
+ * @file multiaddr_list.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "multiformats/multiaddr.hpp"
+#include "multiformats/span.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats {
+    /**
+     * @brief Multiaddrs parsed from a list, stored back to back in one
+     * buffer
+     *
+     * Input is split on newlines, with an optional '\r' before each, and
+     * blank lines are skipped. The text is cut into chunks at line breaks
+     * and the chunks are parsed in parallel on a pool of threads, each into
+     * its own buffer, which are then joined in order. A line that isn't a
+     * valid multiaddr is recorded as an error instead of throwing, so a bad
+     * entry costs no more than a good one. Failures that aren't about the
+     * text, such as std::bad_alloc, are thrown once every chunk is done.
+     */
+    class MultiaddrList {
+      public:
+        /** @brief A line that was not a multiaddr */
+        struct LineError {
+            /** @brief Line number, counting from 1 */
+            std::size_t line;
+            MultiaddrError error;
+
+            bool operator==(LineError const& other) const {
+                return line == other.line && error == other.error;
+            }
+        };
+
+        struct Options {
+            /** @brief Parsing threads, 0 picks one per hardware thread */
+            std::size_t workers{0};
+
+            /** @brief Bytes of text per task, input smaller than this is
+             * parsed on the calling thread */
+            std::size_t chunk_size{1024 * 1024};
+        };
+
+      private:
+        std::vector<std::uint8_t> bytes;
+
+        /** @brief Offset in bytes past the end of each address */
+        std::vector<std::size_t> ends;
+
+        std::vector<LineError> failures;
+
+      public:
+        MultiaddrList() = default;
+
+        /**
+         * @brief Parse text holding one multiaddr per line
+         *
+         * @throw std::invalid_argument if options.chunk_size is 0
+         */
+        static MultiaddrList parse(std::string_view text);
+        static MultiaddrList parse(std::string_view text,
+                                   Options const& options);
+
+        /**
+         * @brief Parse a file holding one multiaddr per line
+         *
+         * Regular files are memory mapped, anything else is read first.
+         *
+         * @throw std::system_error if the file can't be opened or read
+         * @throw std::invalid_argument if options.chunk_size is 0
+         */
+        static MultiaddrList from_file(std::string const& path);
+        static MultiaddrList from_file(std::string const& path,
+                                       Options const& options);
+
+        /** @brief Number of addresses parsed */
+        std::size_t size() const { return ends.size(); }
+
+        bool empty() const { return ends.empty(); }
+
+        /** @brief Get the address at index, in the order of the input */
+        MultiaddrView operator[](std::size_t index) const {
+            auto const begin = index == 0 ? 0 : ends[index - 1];
+            return ByteSpan{bytes.data() + begin, ends[index] - begin};
+        }
+
+        /** @brief Every address's binary form, back to back */
+        ByteSpan to_binary() const { return bytes; }
+
+        /** @brief Lines that failed to parse, in order */
+        std::vector<LineError> const& errors() const { return failures; }
+    };
+} // namespace Multiformats
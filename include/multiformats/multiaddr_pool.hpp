@@ -0,0 +1,72 @@
+/**
+ * Interning pool for Multiaddrs
+ *
+ * @file multiaddr_pool.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "multiformats/multiaddr.hpp"
+
+#include <memory>
+
+#include <cstddef>
+
+namespace Multiformats {
+    /**
+     * @brief Thread-safe set of interned Multiaddrs
+     *
+     * Equal addresses are stored once and get the same handle, which stays
+     * valid as long as the pool, so handles can be compared and hashed as
+     * pointers. Addresses are spread over shards by hash, each behind its
+     * own reader-writer lock, so threads interning different addresses
+     * rarely contend and lookups of known addresses only share a lock.
+     */
+    class MultiaddrPool {
+      public:
+        /** @brief An interned address, equal addresses have equal handles */
+        using Handle = Multiaddr const*;
+
+        struct Impl;
+
+      private:
+        std::unique_ptr<Impl> impl;
+
+      public:
+        /**
+         * @param shards independently locked parts, rounded up to a power
+         * of two
+         * @throw std::invalid_argument if shards is 0
+         */
+        explicit MultiaddrPool(std::size_t shards = 64);
+
+        ~MultiaddrPool();
+
+        /**
+         * @brief Intern a copy of a binary multiaddr
+         *
+         * The view is only validated if the address is new.
+         *
+         * @throw like Multiaddr(MultiaddrView)
+         */
+        Handle intern(MultiaddrView view);
+
+        /** @brief Intern a copy of multiaddr */
+        Handle intern(Multiaddr const& multiaddr);
+
+        /**
+         * @brief Intern multiaddr, taking its buffer if it is new
+         *
+         * If the address is already interned, even by another thread while
+         * this call waited for the lock, multiaddr is left as it was.
+         */
+        Handle intern(Multiaddr&& multiaddr);
+
+        /** @brief Get the handle of an address, nullptr if not interned */
+        Handle find(MultiaddrView view) const;
+
+        /** @brief Number of distinct addresses */
+        std::size_t size() const;
+    };
+} // namespace Multiformats
@@ -3,447 +3,244 @@
 // Author: Matthew Knight
 // File Name: multicodec.hpp
 // Date: 2019-09-12
-// Multicode: self-des
-//
-// Author: Matthew Knight
-// File Name: varint.hpp
-// Date: 2019-09-12
 
 #pragma once
 
-#include "varint.hpp"
+#include "multiformats/multicodec_table.hpp"
+#include "multiformats/varint.hpp"
 
-#include <unordered_map>
+#include <array>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include <cstddef>
+#include <cstdint>
 
 namespace Multiformats::Multicodec {
-    /** @brief Map of protocols and their specific varint code values */
-    std::unordered_map<std::string, Varint> const table {
-        { "identity", 0x00 },
-        { "ip4", 0x04 },
-        { "tcp", 0x06 },
-        { "sha1", 0x11 },
-        { "sha2-256", 0x12 },
-        { "sha2-512", 0x13 },
-        { "sha3-512", 0x14 },
-        { "sha3-384", 0x15 },
-        { "sha3-256", 0x16 },
-        { "sha3-224", 0x17 },
-        { "shake-128", 0x18 },
-        { "shake-256", 0x19 },
-        { "keccak-224", 0x1a },
-        { "keccak-256", 0x1b },
-        { "keccak-384", 0x1c },
-        { "keccak-512", 0x1d },
-        { "dccp", 0x21 },
-        { "murmur3-128", 0x22 },
-        { "murmur3-32", 0x23 },
-        { "ip6", 0x29 },
-        { "ip6zone", 0x2a },
-        { "path", 0x2f },
-        { "multicodec", 0x30 },
-        { "multihash", 0x31 },
-        { "multiaddr", 0x32 },
-        { "multibase", 0x33 },
-        { "dns", 0x35 },
-        { "dns4", 0x36 },
-        { "dns6", 0x37 },
-        { "dnsaddr", 0x38 },
-        { "protobuf", 0x50 },
-        { "cbor", 0x51 },
-        { "raw", 0x55 },
-        { "dbl-sha2-256", 0x56 },
-        { "rlp", 0x60 },
-        { "bencode", 0x63 },
-        { "dag-pb", 0x70 },
-        { "dag-cbor", 0x71 },
-        { "libp2p-key", 0x72 },
-        { "git-raw", 0x78 },
-        { "torrent-info", 0x7b },
-        { "torrent-file", 0x7c },
-        { "leofcoin-block", 0x81 },
-        { "leofcoin-tx", 0x82 },
-        { "leofcoin-pr", 0x83 },
-        { "sctp", 0x84 },
-        { "eth-block", 0x90 },
-        { "eth-block-list", 0x91 },
-        { "eth-tx-trie", 0x92 },
-        { "eth-tx", 0x93 },
-        { "eth-tx-receipt-trie", 0x94 },
-        { "eth-tx-receipt", 0x95 },
-        { "eth-state-trie", 0x96 },
-        { "eth-account-snapshot", 0x97 },
-        { "eth-storage-trie", 0x98 },
-        { "bitcoin-block", 0xb0 },
-        { "bitcoin-tx", 0xb1 },
-        { "zcash-block", 0xc0 },
-        { "zcash-tx", 0xc1 },
-        { "stellar-block", 0xd0 },
-        { "stellar-tx", 0xd1 },
-        { "md4", 0xd4 },
-        { "md5", 0xd5 },
-        { "bmt", 0xd6 },
-        { "decred-block", 0xe0 },
-        { "decred-tx", 0xe1 },
-        { "ipld-ns", 0xe2 },
-        { "ipfs-ns", 0xe3 },
-        { "swarm-ns", 0xe4 },
-        { "ipns-ns", 0xe5 },
-        { "zeronet", 0xe6 },
-        { "ed25519-pub", 0xed },
-        { "dash-block", 0xf0 },
-        { "dash-tx", 0xf1 },
-        { "swarm-manifest", 0xfa },
-        { "swarm-feed", 0xfb },
-        { "udp", 0x0111 },
-        { "p2p-webrtc-star", 0x0113 },
-        { "p2p-webrtc-direct", 0x0114 },
-        { "p2p-stardust", 0x0115 },
-        { "p2p-circuit", 0x0122 },
-        { "dag-json", 0x0129 },
-        { "udt", 0x012d },
-        { "utp", 0x012e },
-        { "unix", 0x0190 },
-        { "p2p", 0x01a5 },
-        { "ipfs", 0x01a5 },
-        { "https", 0x01bb },
-        { "onion", 0x01bc },
-        { "onion3", 0x01bd },
-        { "garlic64", 0x01be },
-        { "garlic32", 0x01bf },
-        { "tls", 0x01c0 },
-        { "quic", 0x01cc },
-        { "ws", 0x01dd },
-        { "wss", 0x01de },
-        { "p2p-websocket-star", 0x01df },
-        { "http", 0x01e0 },
-        { "json", 0x0200 },
-        { "messagepack", 0x0201 },
-        { "x11", 0x1100 },
-        { "blake2b-8", 0xb201 },
-        { "blake2b-16", 0xb202 },
-        { "blake2b-24", 0xb203 },
-        { "blake2b-32", 0xb204 },
-        { "blake2b-40", 0xb205 },
-        { "blake2b-48", 0xb206 },
-        { "blake2b-56", 0xb207 },
-        { "blake2b-64", 0xb208 },
-        { "blake2b-72", 0xb209 },
-        { "blake2b-80", 0xb20a },
-        { "blake2b-88", 0xb20b },
-        { "blake2b-96", 0xb20c },
-        { "blake2b-104", 0xb20d },
-        { "blake2b-112", 0xb20e },
-        { "blake2b-120", 0xb20f },
-        { "blake2b-128", 0xb210 },
-        { "blake2b-136", 0xb211 },
-        { "blake2b-144", 0xb212 },
-        { "blake2b-152", 0xb213 },
-        { "blake2b-160", 0xb214 },
-        { "blake2b-168", 0xb215 },
-        { "blake2b-176", 0xb216 },
-        { "blake2b-184", 0xb217 },
-        { "blake2b-192", 0xb218 },
-        { "blake2b-200", 0xb219 },
-        { "blake2b-208", 0xb21a },
-        { "blake2b-216", 0xb21b },
-        { "blake2b-224", 0xb21c },
-        { "blake2b-232", 0xb21d },
-        { "blake2b-240", 0xb21e },
-        { "blake2b-248", 0xb21f },
-        { "blake2b-256", 0xb220 },
-        { "blake2b-264", 0xb221 },
-        { "blake2b-272", 0xb222 },
-        { "blake2b-280", 0xb223 },
-        { "blake2b-288", 0xb224 },
-        { "blake2b-296", 0xb225 },
-        { "blake2b-304", 0xb226 },
-        { "blake2b-312", 0xb227 },
-        { "blake2b-320", 0xb228 },
-        { "blake2b-328", 0xb229 },
-        { "blake2b-336", 0xb22a },
-        { "blake2b-344", 0xb22b },
-        { "blake2b-352", 0xb22c },
-        { "blake2b-360", 0xb22d },
-        { "blake2b-368", 0xb22e },
-        { "blake2b-376", 0xb22f },
-        { "blake2b-384", 0xb230 },
-        { "blake2b-392", 0xb231 },
-        { "blake2b-400", 0xb232 },
-        { "blake2b-408", 0xb233 },
-        { "blake2b-416", 0xb234 },
-        { "blake2b-424", 0xb235 },
-        { "blake2b-432", 0xb236 },
-        { "blake2b-440", 0xb237 },
-        { "blake2b-448", 0xb238 },
-        { "blake2b-456", 0xb239 },
-        { "blake2b-464", 0xb23a },
-        { "blake2b-472", 0xb23b },
-        { "blake2b-480", 0xb23c },
-        { "blake2b-488", 0xb23d },
-        { "blake2b-496", 0xb23e },
-        { "blake2b-504", 0xb23f },
-        { "blake2b-512", 0xb240 },
-        { "blake2s-8", 0xb241 },
-        { "blake2s-16", 0xb242 },
-        { "blake2s-24", 0xb243 },
-        { "blake2s-32", 0xb244 },
-        { "blake2s-40", 0xb245 },
-        { "blake2s-48", 0xb246 },
-        { "blake2s-56", 0xb247 },
-        { "blake2s-64", 0xb248 },
-        { "blake2s-72", 0xb249 },
-        { "blake2s-80", 0xb24a },
-        { "blake2s-88", 0xb24b },
-        { "blake2s-96", 0xb24c },
-        { "blake2s-104", 0xb24d },
-        { "blake2s-112", 0xb24e },
-        { "blake2s-120", 0xb24f },
-        { "blake2s-128", 0xb250 },
-        { "blake2s-136", 0xb251 },
-        { "blake2s-144", 0xb252 },
-        { "blake2s-152", 0xb253 },
-        { "blake2s-160", 0xb254 },
-        { "blake2s-168", 0xb255 },
-        { "blake2s-176", 0xb256 },
-        { "blake2s-184", 0xb257 },
-        { "blake2s-192", 0xb258 },
-        { "blake2s-200", 0xb259 },
-        { "blake2s-208", 0xb25a },
-        { "blake2s-216", 0xb25b },
-        { "blake2s-224", 0xb25c },
-        { "blake2s-232", 0xb25d },
-        { "blake2s-240", 0xb25e },
-        { "blake2s-248", 0xb25f },
-        { "blake2s-256", 0xb260 },
-        { "skein256-8", 0xb301 },
-        { "skein256-16", 0xb302 },
-        { "skein256-24", 0xb303 },
-        { "skein256-32", 0xb304 },
-        { "skein256-40", 0xb305 },
-        { "skein256-48", 0xb306 },
-        { "skein256-56", 0xb307 },
-        { "skein256-64", 0xb308 },
-        { "skein256-72", 0xb309 },
-        { "skein256-80", 0xb30a },
-        { "skein256-88", 0xb30b },
-        { "skein256-96", 0xb30c },
-        { "skein256-104", 0xb30d },
-        { "skein256-112", 0xb30e },
-        { "skein256-120", 0xb30f },
-        { "skein256-128", 0xb310 },
-        { "skein256-136", 0xb311 },
-        { "skein256-144", 0xb312 },
-        { "skein256-152", 0xb313 },
-        { "skein256-160", 0xb314 },
-        { "skein256-168", 0xb315 },
-        { "skein256-176", 0xb316 },
-        { "skein256-184", 0xb317 },
-        { "skein256-192", 0xb318 },
-        { "skein256-200", 0xb319 },
-        { "skein256-208", 0xb31a },
-        { "skein256-216", 0xb31b },
-        { "skein256-224", 0xb31c },
-        { "skein256-232", 0xb31d },
-        { "skein256-240", 0xb31e },
-        { "skein256-248", 0xb31f },
-        { "skein256-256", 0xb320 },
-        { "skein512-8", 0xb321 },
-        { "skein512-16", 0xb322 },
-        { "skein512-24", 0xb323 },
-        { "skein512-32", 0xb324 },
-        { "skein512-40", 0xb325 },
-        { "skein512-48", 0xb326 },
-        { "skein512-56", 0xb327 },
-        { "skein512-64", 0xb328 },
-        { "skein512-72", 0xb329 },
-        { "skein512-80", 0xb32a },
-        { "skein512-88", 0xb32b },
-        { "skein512-96", 0xb32c },
-        { "skein512-104", 0xb32d },
-        { "skein512-112", 0xb32e },
-        { "skein512-120", 0xb32f },
-        { "skein512-128", 0xb330 },
-        { "skein512-136", 0xb331 },
-        { "skein512-144", 0xb332 },
-        { "skein512-152", 0xb333 },
-        { "skein512-160", 0xb334 },
-        { "skein512-168", 0xb335 },
-        { "skein512-176", 0xb336 },
-        { "skein512-184", 0xb337 },
-        { "skein512-192", 0xb338 },
-        { "skein512-200", 0xb339 },
-        { "skein512-208", 0xb33a },
-        { "skein512-216", 0xb33b },
-        { "skein512-224", 0xb33c },
-        { "skein512-232", 0xb33d },
-        { "skein512-240", 0xb33e },
-        { "skein512-248", 0xb33f },
-        { "skein512-256", 0xb340 },
-        { "skein512-264", 0xb341 },
-        { "skein512-272", 0xb342 },
-        { "skein512-280", 0xb343 },
-        { "skein512-288", 0xb344 },
-        { "skein512-296", 0xb345 },
-        { "skein512-304", 0xb346 },
-        { "skein512-312", 0xb347 },
-        { "skein512-320", 0xb348 },
-        { "skein512-328", 0xb349 },
-        { "skein512-336", 0xb34a },
-        { "skein512-344", 0xb34b },
-        { "skein512-352", 0xb34c },
-        { "skein512-360", 0xb34d },
-        { "skein512-368", 0xb34e },
-        { "skein512-376", 0xb34f },
-        { "skein512-384", 0xb350 },
-        { "skein512-392", 0xb351 },
-        { "skein512-400", 0xb352 },
-        { "skein512-408", 0xb353 },
-        { "skein512-416", 0xb354 },
-        { "skein512-424", 0xb355 },
-        { "skein512-432", 0xb356 },
-        { "skein512-440", 0xb357 },
-        { "skein512-448", 0xb358 },
-        { "skein512-456", 0xb359 },
-        { "skein512-464", 0xb35a },
-        { "skein512-472", 0xb35b },
-        { "skein512-480", 0xb35c },
-        { "skein512-488", 0xb35d },
-        { "skein512-496", 0xb35e },
-        { "skein512-504", 0xb35f },
-        { "skein512-512", 0xb360 },
-        { "skein1024-8", 0xb361 },
-        { "skein1024-16", 0xb362 },
-        { "skein1024-24", 0xb363 },
-        { "skein1024-32", 0xb364 },
-        { "skein1024-40", 0xb365 },
-        { "skein1024-48", 0xb366 },
-        { "skein1024-56", 0xb367 },
-        { "skein1024-64", 0xb368 },
-        { "skein1024-72", 0xb369 },
-        { "skein1024-80", 0xb36a },
-        { "skein1024-88", 0xb36b },
-        { "skein1024-96", 0xb36c },
-        { "skein1024-104", 0xb36d },
-        { "skein1024-112", 0xb36e },
-        { "skein1024-120", 0xb36f },
-        { "skein1024-128", 0xb370 },
-        { "skein1024-136", 0xb371 },
-        { "skein1024-144", 0xb372 },
-        { "skein1024-152", 0xb373 },
-        { "skein1024-160", 0xb374 },
-        { "skein1024-168", 0xb375 },
-        { "skein1024-176", 0xb376 },
-        { "skein1024-184", 0xb377 },
-        { "skein1024-192", 0xb378 },
-        { "skein1024-200", 0xb379 },
-        { "skein1024-208", 0xb37a },
-        { "skein1024-216", 0xb37b },
-        { "skein1024-224", 0xb37c },
-        { "skein1024-232", 0xb37d },
-        { "skein1024-240", 0xb37e },
-        { "skein1024-248", 0xb37f },
-        { "skein1024-256", 0xb380 },
-        { "skein1024-264", 0xb381 },
-        { "skein1024-272", 0xb382 },
-        { "skein1024-280", 0xb383 },
-        { "skein1024-288", 0xb384 },
-        { "skein1024-296", 0xb385 },
-        { "skein1024-304", 0xb386 },
-        { "skein1024-312", 0xb387 },
-        { "skein1024-320", 0xb388 },
-        { "skein1024-328", 0xb389 },
-        { "skein1024-336", 0xb38a },
-        { "skein1024-344", 0xb38b },
-        { "skein1024-352", 0xb38c },
-        { "skein1024-360", 0xb38d },
-        { "skein1024-368", 0xb38e },
-        { "skein1024-376", 0xb38f },
-        { "skein1024-384", 0xb390 },
-        { "skein1024-392", 0xb391 },
-        { "skein1024-400", 0xb392 },
-        { "skein1024-408", 0xb393 },
-        { "skein1024-416", 0xb394 },
-        { "skein1024-424", 0xb395 },
-        { "skein1024-432", 0xb396 },
-        { "skein1024-440", 0xb397 },
-        { "skein1024-448", 0xb398 },
-        { "skein1024-456", 0xb399 },
-        { "skein1024-464", 0xb39a },
-        { "skein1024-472", 0xb39b },
-        { "skein1024-480", 0xb39c },
-        { "skein1024-488", 0xb39d },
-        { "skein1024-496", 0xb39e },
-        { "skein1024-504", 0xb39f },
-        { "skein1024-512", 0xb3a0 },
-        { "skein1024-520", 0xb3a1 },
-        { "skein1024-528", 0xb3a2 },
-        { "skein1024-536", 0xb3a3 },
-        { "skein1024-544", 0xb3a4 },
-        { "skein1024-552", 0xb3a5 },
-        { "skein1024-560", 0xb3a6 },
-        { "skein1024-568", 0xb3a7 },
-        { "skein1024-576", 0xb3a8 },
-        { "skein1024-584", 0xb3a9 },
-        { "skein1024-592", 0xb3aa },
-        { "skein1024-600", 0xb3ab },
-        { "skein1024-608", 0xb3ac },
-        { "skein1024-616", 0xb3ad },
-        { "skein1024-624", 0xb3ae },
-        { "skein1024-632", 0xb3af },
-        { "skein1024-640", 0xb3b0 },
-        { "skein1024-648", 0xb3b1 },
-        { "skein1024-656", 0xb3b2 },
-        { "skein1024-664", 0xb3b3 },
-        { "skein1024-672", 0xb3b4 },
-        { "skein1024-680", 0xb3b5 },
-        { "skein1024-688", 0xb3b6 },
-        { "skein1024-696", 0xb3b7 },
-        { "skein1024-704", 0xb3b8 },
-        { "skein1024-712", 0xb3b9 },
-        { "skein1024-720", 0xb3ba },
-        { "skein1024-728", 0xb3bb },
-        { "skein1024-736", 0xb3bc },
-        { "skein1024-744", 0xb3bd },
-        { "skein1024-752", 0xb3be },
-        { "skein1024-760", 0xb3bf },
-        { "skein1024-768", 0xb3c0 },
-        { "skein1024-776", 0xb3c1 },
-        { "skein1024-784", 0xb3c2 },
-        { "skein1024-792", 0xb3c3 },
-        { "skein1024-800", 0xb3c4 },
-        { "skein1024-808", 0xb3c5 },
-        { "skein1024-816", 0xb3c6 },
-        { "skein1024-824", 0xb3c7 },
-        { "skein1024-832", 0xb3c8 },
-        { "skein1024-840", 0xb3c9 },
-        { "skein1024-848", 0xb3ca },
-        { "skein1024-856", 0xb3cb },
-        { "skein1024-864", 0xb3cc },
-        { "skein1024-872", 0xb3cd },
-        { "skein1024-880", 0xb3ce },
-        { "skein1024-888", 0xb3cf },
-        { "skein1024-896", 0xb3d0 },
-        { "skein1024-904", 0xb3d1 },
-        { "skein1024-912", 0xb3d2 },
-        { "skein1024-920", 0xb3d3 },
-        { "skein1024-928", 0xb3d4 },
-        { "skein1024-936", 0xb3d5 },
-        { "skein1024-944", 0xb3d6 },
-        { "skein1024-952", 0xb3d7 },
-        { "skein1024-960", 0xb3d8 },
-        { "skein1024-968", 0xb3d9 },
-        { "skein1024-976", 0xb3da },
-        { "skein1024-984", 0xb3db },
-        { "skein1024-992", 0xb3dc },
-        { "skein1024-1000", 0xb3dd },
-        { "skein1024-1008", 0xb3de },
-        { "skein1024-1016", 0xb3df },
-        { "skein1024-1024", 0xb3e0 },
-        { "holochain-adr-v0", 0x807124 },
-        { "holochain-adr-v1", 0x817124 },
-        { "holochain-key-v0", 0x947124 },
-        { "holochain-key-v1", 0x957124 },
-        { "holochain-sig-v0", 0xa27124 },
-        { "holochain-sig-v1", 0xa37124 }
+    namespace Detail {
+        constexpr std::size_t entry_count = std::size(entries);
+
+        constexpr std::uint64_t mix(std::uint64_t x) {
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111eb;
+            x ^= x >> 31;
+            return x;
+        }
+
+        constexpr std::uint64_t hash(std::string_view name) {
+            std::uint64_t h{0xcbf29ce484222325};
+            for (auto c : name) {
+                h ^= static_cast<unsigned char>(c);
+                h *= 0x100000001b3;
+            }
+            return mix(h);
+        }
+
+        constexpr std::uint64_t hash(std::uint64_t code) { return mix(code); }
+
+        /**
+         * @brief Hash and displace perfect hash over the entries
+         *
+         * A key's hash picks a bucket, the bucket's seed then picks the
+         * key's slot. Seeds are searched at compile time, largest bucket
+         * first, until every key in the bucket lands in a free slot.
+         */
+        struct PerfectHash {
+            static constexpr std::size_t bucket_bits = 7;
+            static constexpr std::size_t bucket_count = 1 << bucket_bits;
+            static constexpr std::size_t slot_count = 1024;
+            static constexpr std::uint16_t empty = 0xffff;
+
+            static_assert(entry_count * 2 <= slot_count,
+                          "grow the multicodec perfect hash");
+
+            std::array<std::uint16_t, bucket_count> seeds{};
+            std::array<std::uint16_t, slot_count> slots{};
+
+            static constexpr std::size_t bucket(std::uint64_t h) {
+                return h >> (64 - bucket_bits);
+            }
+
+            static constexpr std::size_t slot(std::uint64_t h,
+                                              std::uint16_t seed) {
+                return mix(h ^ (seed * 0x9e3779b97f4a7c15)) & (slot_count - 1);
+            }
+
+            /** @brief Index into entries to check the key against */
+            constexpr std::size_t operator()(std::uint64_t h) const {
+                return slots[slot(h, seeds[bucket(h)])];
+            }
+
+            /**
+             * @brief Build over keys, a key equal to the one before it is
+             * skipped */
+            template <typename Key>
+            static constexpr PerfectHash build(Key key) {
+                PerfectHash ret{};
+                std::array<std::uint64_t, entry_count> hashes{};
+                std::array<std::size_t, bucket_count + 1> starts{};
+                std::array<std::uint16_t, entry_count> order{};
+
+                // counting sort of the keys by bucket
+                for (std::size_t i = 0; i < entry_count; ++i) {
+                    hashes[i] = hash(key(entries[i]));
+                    if (i == 0 || key(entries[i]) != key(entries[i - 1]))
+                        ++starts[bucket(hashes[i]) + 1];
+                }
+
+                std::size_t largest = 0;
+                for (std::size_t b = 0; b < bucket_count; ++b) {
+                    auto size = starts[b + 1];
+                    largest = size > largest ? size : largest;
+                    starts[b + 1] += starts[b];
+                }
+
+                auto fill = starts;
+                for (std::size_t i = 0; i < entry_count; ++i)
+                    if (i == 0 || key(entries[i]) != key(entries[i - 1]))
+                        order[fill[bucket(hashes[i])]++] =
+                            static_cast<std::uint16_t>(i);
+
+                for (auto& s : ret.slots)
+                    s = empty;
+
+                for (auto size = largest; size > 0; --size) {
+                    for (std::size_t b = 0; b < bucket_count; ++b) {
+                        if (starts[b + 1] - starts[b] != size)
+                            continue;
+
+                        std::array<std::size_t, slot_count / 2> placed{};
+                        for (std::uint32_t seed = 0;; ++seed) {
+                            if (seed > 0xffff)
+                                throw std::logic_error(
+                                    "no perfect hash seed found");
+
+                            std::size_t count = 0;
+                            for (; count < size; ++count) {
+                                auto s = slot(hashes[order[starts[b] + count]],
+                                              seed);
+                                if (ret.slots[s] != empty)
+                                    break;
+
+                                // claim the slot now, released on failure
+                                ret.slots[s] = order[starts[b] + count];
+                                placed[count] = s;
+                            }
+
+                            if (count == size) {
+                                ret.seeds[b] = static_cast<std::uint16_t>(seed);
+                                break;
+                            }
+
+                            while (count-- > 0)
+                                ret.slots[placed[count]] = empty;
+                        }
+                    }
+                }
+
+                return ret;
+            }
+        };
+
+        inline constexpr auto by_name = PerfectHash::build(
+            [](Entry const& entry) { return entry.name; });
+
+        inline constexpr auto by_code = PerfectHash::build(
+            [](Entry const& entry) { return entry.code; });
+
+        /** @brief Index of the entry named name, entry_count if unknown */
+        constexpr std::size_t index(std::string_view name) {
+            auto i = by_name(hash(name));
+            return i < entry_count && entries[i].name == name ? i : entry_count;
+        }
+
+        /** @brief Index of the entry for code, entry_count if unknown */
+        constexpr std::size_t index(std::uint64_t code) {
+            auto i = by_code(hash(code));
+            return i < entry_count && entries[i].code == code ? i : entry_count;
+        }
+    } // namespace Detail
+
+    /** @brief Code of a protocol name, if it is known */
+    constexpr std::optional<std::uint64_t> find(std::string_view name) {
+        auto i = Detail::index(name);
+        if (i == Detail::entry_count)
+            return std::nullopt;
+
+        return entries[i].code;
+    }
+
+    /**
+     * @brief Code of a protocol name
+     *
+     * @throw std::out_of_range if the name is unknown */
+    constexpr std::uint64_t code(std::string_view name) {
+        auto ret = find(name);
+        if (!ret)
+            throw std::out_of_range("unknown multicodec");
+
+        return *ret;
+    }
+
+    /** @brief Entry for a code, nullptr if the code is unknown */
+    constexpr Entry const* lookup(std::uint64_t code) {
+        auto i = Detail::index(code);
+        return i == Detail::entry_count ? nullptr : &entries[i];
+    }
+
+    /** @brief Canonical name of a code, empty if the code is unknown */
+    constexpr std::string_view name(std::uint64_t code) {
+        auto i = Detail::index(code);
+        return i == Detail::entry_count ? std::string_view{} : entries[i].name;
+    }
+
+    namespace Detail {
+        using Pair = std::pair<std::string_view, std::uint64_t>;
+
+        template <std::size_t... I>
+        constexpr std::array<Pair, entry_count>
+        make_pairs(std::index_sequence<I...>) {
+            return {{Pair{entries[I].name, entries[I].code}...}};
+        }
+
+        inline constexpr auto pairs =
+            make_pairs(std::make_index_sequence<entry_count>{});
+    } // namespace Detail
+
+    /**
+     * @brief Lookups by protocol name in the style of a map
+     *
+     * Iterates name and code pairs in code order, entries has the tags too.
+     */
+    struct Table {
+        using key_type = std::string_view;
+        using mapped_type = std::uint64_t;
+        using value_type = Detail::Pair;
+        using const_iterator = value_type const*;
+
+        constexpr const_iterator begin() const { return Detail::pairs.data(); }
+        constexpr const_iterator end() const { return begin() + size(); }
+        constexpr const_iterator cbegin() const { return begin(); }
+        constexpr const_iterator cend() const { return end(); }
+        constexpr std::size_t size() const { return Detail::entry_count; }
+
+        constexpr const_iterator find(std::string_view name) const {
+            return begin() + Detail::index(name);
+        }
+
+        constexpr std::size_t count(std::string_view name) const {
+            return find(name) != end();
+        }
+
+        /** @throw std::out_of_range if the name is unknown */
+        Varint at(std::string_view name) const { return code(name); }
     };
+
+    /** @brief Map of protocols and their specific varint code values */
+    inline constexpr Table table{};
 }
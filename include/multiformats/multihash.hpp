@@ -8,19 +8,64 @@
 
 #pragma once
 
+#include "multiformats/inline_buffer.hpp"
+#include "multiformats/multicodec_table.hpp"
+#include "multiformats/span.hpp"
 #include "multiformats/varint.hpp"
 
+#include <algorithm>
 #include <iterator>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include <cstdint>
 
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#define MULTIFORMATS_HAS_IOVEC 1
+#endif
+
 namespace Multiformats {
-    /** @brief Object for containing specific hash */
+    class Multihasher;
+
+    /**
+     * @brief Object for containing specific hash
+     *
+     * The function code, digest length and digest offset are decoded once at
+     * construction. Multihashes of up to inline_capacity bytes, which covers
+     * every 512-bit digest and its header, are stored inline; longer ones
+     * spill to the heap.
+     */
     class Multihash {
-        std::vector<std::uint8_t> buf;
+      public:
+        using ConstIterator = std::uint8_t const*;
+
+        /** @brief Number of bytes stored without a heap allocation */
+        static constexpr std::size_t inline_capacity = 72;
+
+      private:
+        struct Header {
+            std::uint8_t digest_offset{};
+        };
+
+        std::uint64_t code{};
+        Detail::InlineBuffer<inline_capacity, Header> storage;
+
+        std::uint8_t const* data() const { return storage.data(); }
+
+        friend class Multihasher;
+
+        /** @brief Decode and cache the header of the stored bytes */
+        void parse_header();
+
+        /** @brief Replace contents with header and digest */
+        void assign(std::uint64_t func_code, std::uint8_t const* digest,
+                    std::size_t size);
 
-        using ConstIterator = typename decltype(buf)::const_iterator;
+        /** @brief Body of compute(), instantiated for computable() codes */
+        template <Multicodec::Code HashFunction>
+        static Multihash compute_with(ByteSpan plaintext);
 
       public:
         Multihash() = default;
@@ -33,28 +78,183 @@ namespace Multiformats {
         Multihash(std::vector<std::uint8_t> const& plaintext,
                   std::string const& protocol);
 
-        /** @brief Construct multihash from sequence */
+        /** @brief Hash a message made of several fragments, in order */
+        Multihash(Span<ByteSpan const> fragments, Varint const& protocol);
+
+        /** @brief Hash a fragmented message using string name */
+        Multihash(Span<ByteSpan const> fragments, std::string const& protocol);
+
+#ifdef MULTIFORMATS_HAS_IOVEC
+        /** @brief Hash a message described by an iovec array, in order */
+        Multihash(struct iovec const* iov, std::size_t count,
+                  Varint const& protocol);
+#endif
+
+        /** @brief Hash every buffer separately with one digest context */
+        static std::vector<Multihash> hash_each(Span<ByteSpan const> buffers,
+                                                Varint const& protocol);
+
+        /** @brief Whether compute() is available for a function code */
+        static constexpr bool computable(Multicodec::Code code) {
+            using Multicodec::Code;
+            switch (code) {
+            case Code::sha1:
+            case Code::md4:
+            case Code::md5:
+            case Code::sha2_256:
+            case Code::sha2_512:
+            case Code::sha3_224:
+            case Code::sha3_256:
+            case Code::sha3_384:
+            case Code::sha3_512:
+            case Code::shake_128:
+            case Code::shake_256:
+            case Code::murmur3_32:
+            case Code::murmur3_128:
+            case Code::xxh3_64:
+            case Code::xxh3_128:
+            case Code::blake2b_256:
+            case Code::blake2b_512:
+            case Code::blake2s_256:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        /**
+         * @brief Hash with a function chosen at compile time
+         *
+         * The hasher is picked without a runtime dispatch on the function
+         * code. Available for every supported function except the BLAKE2
+         * lengths other than blake2b-256, blake2b-512 and blake2s-256, which
+         * fail to compile; hash those through the constructor.
+         */
+        template <Multicodec::Code HashFunction>
+        static Multihash compute(ByteSpan plaintext) {
+            static_assert(computable(HashFunction),
+                          "compute() is not available for this function");
+            return compute_with<HashFunction>(plaintext);
+        }
+
+        /**
+         * @brief Hash the contents of a file
+         *
+         * Regular files are memory mapped and hashed in large strides with
+         * bounded resident memory; other files are read by a background
+         * thread overlapping I/O with hashing.
+         *
+         * @throw std::system_error if the file can't be read
+         * @throw std::invalid_argument if function code is not supported */
+        static Multihash from_file(std::string const& path,
+                                   Varint const& protocol);
+
+        /** @brief Hash the contents of a file using string name */
+        static Multihash from_file(std::string const& path,
+                                   std::string const& protocol);
+
+        /** @brief Construct multihash from sequence
+         *
+         *  @throw std::invalid_argument if the header can't be parsed or the
+         *  digest length doesn't match the sequence */
         template <typename Iterator>
         Multihash(Iterator begin, Iterator end) {
-            std::copy(begin, end, std::back_inserter(buf));
+            std::copy(begin, end, storage.assign(std::distance(begin, end)));
+            parse_header();
         }
 
+        Multihash(Multihash const& other);
+        Multihash(Multihash&& other) noexcept;
+        Multihash& operator=(Multihash const& other);
+        Multihash& operator=(Multihash&& other) noexcept;
+        ~Multihash();
+
         /** @brief Extract function code from multihash */
-        Varint func_code() const;
+        std::uint64_t func_code() const { return code; }
 
         /** @brief Extract digest length from multihash */
-        Varint len() const;
+        std::uint64_t len() const {
+            return storage.size() - storage.header.digest_offset;
+        }
 
         /** @brief Get size of entire multihash */
-        std::size_t size() const;
+        std::size_t size() const { return storage.size(); }
 
         /** @brief Const iterator to begining of multihash */
-        ConstIterator begin() const;
+        ConstIterator begin() const { return data(); }
 
         /** @brief Const iterator to beginning of digest withing multihash */
-        ConstIterator digest() const;
+        ConstIterator digest() const {
+            return data() + storage.header.digest_offset;
+        }
 
         /** @brief Const iterator to end of multihash */
-        ConstIterator end() const;
+        ConstIterator end() const { return data() + storage.size(); }
+
+        /**
+         * @brief Check that data hashes to this multihash
+         *
+         * The digest is computed into a stack buffer and compared in place.
+         * A truncated digest matches when it is a prefix of the full one;
+         * an empty digest never matches.
+         *
+         * @throw std::invalid_argument if function code is not supported */
+        bool verify(ByteSpan data) const;
+
+        /**
+         * @brief Verify many (data, multihash) pairs on all cores
+         *
+         * Runs on a pool shared by every call. A call made from one of its
+         * workers verifies every pair on that worker instead.
+         *
+         * @return failures, set where data[i] doesn't hash to
+         * multihashes[i] or its function code is not supported
+         * @throw std::invalid_argument if the spans differ in length
+         * @throw the first other failure of a hash, such as std::bad_alloc,
+         * once every worker has stopped */
+        static std::vector<bool> verify_batch(Span<ByteSpan const> data,
+                                              Span<Multihash const> multihashes);
+
+        /** @brief Compare complete multihashes, code and digest */
+        bool operator==(Multihash const& other) const;
+        bool operator!=(Multihash const& other) const {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * @brief Incremental hashing, for messages that arrive in pieces
+     *
+     * Feeding the same bytes through update(), in any split, produces the
+     * same Multihash as hashing them in one go.
+     */
+    class Multihasher {
+      public:
+        /** @brief Implementation detail, the hasher behind the interface */
+        struct Impl;
+
+      private:
+        std::unique_ptr<Impl> impl;
+        std::uint64_t code;
+
+      public:
+        /** @throw std::invalid_argument if function code is not supported */
+        explicit Multihasher(Varint const& protocol);
+
+        /** @throw std::out_of_range if protocol isn't in multicodec table */
+        explicit Multihasher(std::string const& protocol);
+
+        Multihasher(Multihasher&& other) noexcept;
+        Multihasher& operator=(Multihasher&& other) noexcept;
+        ~Multihasher();
+
+        /** @brief Absorb the next piece of the message */
+        void update(ByteSpan data);
+
+        /** @brief Produce the multihash and reset for a new message */
+        Multihash finish();
+
+        /** @brief Function code of the hash being computed */
+        std::uint64_t func_code() const { return code; }
     };
 } // namespace Multiformats
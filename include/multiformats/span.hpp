@@ -0,0 +1,92 @@
+/**
+ * Non-owning view over contiguous memory
+ *
+ * @file span.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats {
+    /**
+     * @brief Minimal stand-in for C++20 std::span
+     *
+     * Implicitly constructible from pointer and size, and from any contiguous
+     * container with data() and size() members whose element pointer converts
+     * to T*.
+     */
+    template <typename T>
+    class Span {
+        T* ptr{};
+        std::size_t count{};
+
+        template <typename Container>
+        using EnableContainer = std::enable_if_t<std::is_convertible_v<
+            std::remove_pointer_t<decltype(std::declval<Container&>().data())> (
+                *)[],
+            T (*)[]>>;
+
+      public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using iterator = T*;
+
+        constexpr Span() = default;
+
+        constexpr Span(T* data, std::size_t size)
+            : ptr(data)
+            , count(size) {}
+
+        constexpr Span(T* begin, T* end)
+            : ptr(begin)
+            , count(end - begin) {}
+
+        template <std::size_t N>
+        constexpr Span(T (&array)[N])
+            : ptr(array)
+            , count(N) {}
+
+        template <typename Container,
+                  typename = EnableContainer<Container const>>
+        constexpr Span(Container const& container)
+            : ptr(container.data())
+            , count(container.size()) {}
+
+        template <typename Container, typename = EnableContainer<Container>>
+        constexpr Span(Container& container)
+            : ptr(container.data())
+            , count(container.size()) {}
+
+        constexpr T* data() const { return ptr; }
+        constexpr std::size_t size() const { return count; }
+        constexpr bool empty() const { return count == 0; }
+
+        constexpr T* begin() const { return ptr; }
+        constexpr T* end() const { return ptr + count; }
+
+        constexpr T& operator[](std::size_t index) const { return ptr[index]; }
+        constexpr T& front() const { return ptr[0]; }
+        constexpr T& back() const { return ptr[count - 1]; }
+
+        /** @throw std::out_of_range if offset is past the end */
+        constexpr Span subspan(std::size_t offset,
+                               std::size_t size = ~std::size_t{}) const {
+            if (offset > count)
+                throw std::out_of_range("subspan offset out of range");
+
+            return {ptr + offset, size < count - offset ? size : count - offset};
+        }
+
+        constexpr Span first(std::size_t size) const { return subspan(0, size); }
+    };
+
+    /** @brief Read-only view of raw bytes */
+    using ByteSpan = Span<std::uint8_t const>;
+} // namespace Multiformats
@@ -115,6 +115,62 @@ namespace Multiformats {
         }
     };
 
+    /** @brief Largest number of bytes a Varint may occupy */
+    constexpr std::size_t varint_max_size = 9;
+
+    /**
+     * @brief Decode an unsigned varint in place, without allocating.
+     *
+     * @param begin Pointer to first byte of the varint
+     * @param end Pointer to end of the buffer
+     * @param value Set to the decoded value on success
+     * @return Number of bytes consumed, or 0 if the sequence is truncated or
+     * longer than varint_max_size
+     */
+    inline std::size_t decode_varint(std::uint8_t const* begin,
+                                     std::uint8_t const* end,
+                                     std::uint64_t& value) {
+        std::uint64_t ret{};
+        for (std::size_t i = 0; i < varint_max_size && begin + i != end;
+             ++i) {
+            ret |= static_cast<std::uint64_t>(begin[i] & 0x7f) << (7 * i);
+            if ((begin[i] & 0x80) == 0) {
+                value = ret;
+                return i + 1;
+            }
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Encode an unsigned varint into a caller provided buffer.
+     *
+     * @param value Number to encode
+     * @param out Buffer of at least varint_max_size bytes
+     * @return Number of bytes written
+     */
+    constexpr std::size_t encode_varint(std::uint64_t value,
+                                        std::uint8_t* out) {
+        std::size_t size{};
+        do {
+            std::uint8_t byte = value & 0x7f;
+            value >>= 7;
+            out[size++] = value ? byte | 0x80 : byte;
+        } while (value);
+
+        return size;
+    }
+
+    /** @brief Number of bytes needed to encode value as a varint */
+    constexpr std::size_t varint_size(std::uint64_t value) {
+        std::size_t size{1};
+        while (value >>= 7)
+            ++size;
+
+        return size;
+    }
+
     /**
      * @brief Extract Varint from sequence.
      *
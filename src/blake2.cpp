@@ -0,0 +1,359 @@
+// BLAKE2b and BLAKE2s -- parameterized digest length hashing
+//
+// File Name: blake2.cpp
+// Date: 2026-10-18
+
+#include "blake2.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MULTIFORMATS_BLAKE2_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    using namespace Multiformats::Blake2;
+
+    constexpr std::array<std::uint64_t, 8> blake2b_iv{
+        0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b,
+        0xa54ff53a5f1d36f1, 0x510e527fade682d1, 0x9b05688c2b3e6c1f,
+        0x1f83d9abfb41bd6b, 0x5be0cd19137e2179};
+
+    constexpr std::array<std::uint32_t, 8> blake2s_iv{
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+    // message schedule, BLAKE2b uses rows 0-9 twice
+    constexpr std::uint8_t sigma[10][16]{
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+        {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+        {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+        {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+        {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+        {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+        {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+        {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+        {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+        {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0}};
+
+    template <typename Word>
+    constexpr auto const& iv() {
+        if constexpr (sizeof(Word) == 8)
+            return blake2b_iv;
+        else
+            return blake2s_iv;
+    }
+
+    template <typename Word>
+    Word load(std::uint8_t const* src) {
+        Word ret{};
+        for (std::size_t i = 0; i < sizeof(Word); ++i)
+            ret |= static_cast<Word>(src[i]) << (8 * i);
+
+        return ret;
+    }
+
+    template <typename Word>
+    constexpr Word rotr(Word value, unsigned shift) {
+        return (value >> shift) |
+               (value << (std::numeric_limits<Word>::digits - shift));
+    }
+
+    // rotation constants R1-R4
+    template <typename Word>
+    constexpr std::array<unsigned, 4> rotations() {
+        if constexpr (sizeof(Word) == 8)
+            return {32, 24, 16, 63};
+        else
+            return {16, 12, 8, 7};
+    }
+
+    template <typename Word>
+    void compress_portable(Word* state, std::uint8_t const* block,
+                           Word const* counter, bool last) {
+        constexpr auto r = rotations<Word>();
+        Word m[16];
+        Word v[16];
+
+        for (auto i = 0; i < 16; ++i)
+            m[i] = load<Word>(block + i * sizeof(Word));
+
+        std::copy_n(state, 8, v);
+        std::copy_n(iv<Word>().cbegin(), 8, v + 8);
+        v[12] ^= counter[0];
+        v[13] ^= counter[1];
+        if (last)
+            v[14] = ~v[14];
+
+        auto g = [&](int a, int b, int c, int d, Word x, Word y) {
+            v[a] = v[a] + v[b] + x;
+            v[d] = rotr(v[d] ^ v[a], r[0]);
+            v[c] = v[c] + v[d];
+            v[b] = rotr(v[b] ^ v[c], r[1]);
+            v[a] = v[a] + v[b] + y;
+            v[d] = rotr(v[d] ^ v[a], r[2]);
+            v[c] = v[c] + v[d];
+            v[b] = rotr(v[b] ^ v[c], r[3]);
+        };
+
+        for (std::size_t round = 0; round < Traits<Word>::rounds; ++round) {
+            auto const* s = sigma[round % 10];
+            g(0, 4, 8, 12, m[s[0]], m[s[1]]);
+            g(1, 5, 9, 13, m[s[2]], m[s[3]]);
+            g(2, 6, 10, 14, m[s[4]], m[s[5]]);
+            g(3, 7, 11, 15, m[s[6]], m[s[7]]);
+            g(0, 5, 10, 15, m[s[8]], m[s[9]]);
+            g(1, 6, 11, 12, m[s[10]], m[s[11]]);
+            g(2, 7, 8, 13, m[s[12]], m[s[13]]);
+            g(3, 4, 9, 14, m[s[14]], m[s[15]]);
+        }
+
+        for (auto i = 0; i < 8; ++i)
+            state[i] ^= v[i] ^ v[i + 8];
+    }
+
+#ifdef MULTIFORMATS_BLAKE2_X86
+    /**
+     * Vectorized kernels
+     *
+     * Each row of the 4x4 working matrix lives in one register, so the four
+     * column (and then diagonal) G functions of a round run in parallel. The
+     * diagonal step is done by rotating rows b, c and d so that diagonals line
+     * up as columns, then rotating them back.
+     */
+    template <int shift>
+    __attribute__((target("avx2"))) inline __m256i rotr_avx2(__m256i x) {
+        if constexpr (shift == 32)
+            return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+        else if constexpr (shift == 24)
+            return _mm256_shuffle_epi8(
+                x, _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15,
+                                    8, 9, 10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12,
+                                    13, 14, 15, 8, 9, 10));
+        else if constexpr (shift == 16)
+            return _mm256_shuffle_epi8(
+                x, _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14,
+                                    15, 8, 9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11,
+                                    12, 13, 14, 15, 8, 9));
+        else
+            return _mm256_or_si256(_mm256_srli_epi64(x, shift),
+                                   _mm256_slli_epi64(x, 64 - shift));
+    }
+
+    // lambdas don't inherit the target attribute, so G is a plain function
+    __attribute__((target("avx2"))) inline void
+    g_avx2(__m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i x,
+           __m256i y) {
+        a = _mm256_add_epi64(_mm256_add_epi64(a, b), x);
+        d = rotr_avx2<32>(_mm256_xor_si256(d, a));
+        c = _mm256_add_epi64(c, d);
+        b = rotr_avx2<24>(_mm256_xor_si256(b, c));
+        a = _mm256_add_epi64(_mm256_add_epi64(a, b), y);
+        d = rotr_avx2<16>(_mm256_xor_si256(d, a));
+        c = _mm256_add_epi64(c, d);
+        b = rotr_avx2<63>(_mm256_xor_si256(b, c));
+    }
+
+    __attribute__((target("avx2"))) void
+    compress_avx2(std::uint64_t* state, std::uint8_t const* block,
+                  std::uint64_t const* counter, bool last) {
+        std::uint64_t m[16];
+        std::memcpy(m, block, sizeof(m));
+
+        auto const h0 =
+            _mm256_loadu_si256(reinterpret_cast<__m256i const*>(state));
+        auto const h1 =
+            _mm256_loadu_si256(reinterpret_cast<__m256i const*>(state + 4));
+
+        __m256i a = h0;
+        __m256i b = h1;
+        __m256i c = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(blake2b_iv.data()));
+        __m256i d = _mm256_xor_si256(
+            _mm256_loadu_si256(
+                reinterpret_cast<__m256i const*>(blake2b_iv.data() + 4)),
+            _mm256_set_epi64x(0, last ? ~0ull : 0ull, counter[1], counter[0]));
+
+        for (auto round = 0; round < 12; ++round) {
+            auto const* s = sigma[round % 10];
+            g_avx2(a, b, c, d,
+                   _mm256_set_epi64x(m[s[6]], m[s[4]], m[s[2]], m[s[0]]),
+                   _mm256_set_epi64x(m[s[7]], m[s[5]], m[s[3]], m[s[1]]));
+
+            b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(0, 3, 2, 1));
+            c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+            d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(2, 1, 0, 3));
+
+            g_avx2(a, b, c, d,
+                   _mm256_set_epi64x(m[s[14]], m[s[12]], m[s[10]], m[s[8]]),
+                   _mm256_set_epi64x(m[s[15]], m[s[13]], m[s[11]], m[s[9]]));
+
+            b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(2, 1, 0, 3));
+            c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+            d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(0, 3, 2, 1));
+        }
+
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(state),
+            _mm256_xor_si256(h0, _mm256_xor_si256(a, c)));
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(state + 4),
+            _mm256_xor_si256(h1, _mm256_xor_si256(b, d)));
+    }
+
+    // SSE2 is baseline on x86_64, so BLAKE2s needs no runtime check
+    template <int shift>
+    inline __m128i rotr_sse2(__m128i x) {
+        return _mm_or_si128(_mm_srli_epi32(x, shift),
+                            _mm_slli_epi32(x, 32 - shift));
+    }
+
+    void compress_sse2(std::uint32_t* state, std::uint8_t const* block,
+                       std::uint32_t const* counter, bool last) {
+        std::uint32_t m[16];
+        std::memcpy(m, block, sizeof(m));
+
+        auto const h0 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(state));
+        auto const h1 =
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(state + 4));
+
+        __m128i a = h0;
+        __m128i b = h1;
+        __m128i c = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(blake2s_iv.data()));
+        __m128i d = _mm_xor_si128(
+            _mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(blake2s_iv.data() + 4)),
+            _mm_set_epi32(0, last ? ~0 : 0, counter[1], counter[0]));
+
+        auto g = [&](__m128i x, __m128i y) {
+            a = _mm_add_epi32(_mm_add_epi32(a, b), x);
+            d = rotr_sse2<16>(_mm_xor_si128(d, a));
+            c = _mm_add_epi32(c, d);
+            b = rotr_sse2<12>(_mm_xor_si128(b, c));
+            a = _mm_add_epi32(_mm_add_epi32(a, b), y);
+            d = rotr_sse2<8>(_mm_xor_si128(d, a));
+            c = _mm_add_epi32(c, d);
+            b = rotr_sse2<7>(_mm_xor_si128(b, c));
+        };
+
+        for (auto round = 0; round < 10; ++round) {
+            auto const* s = sigma[round];
+            g(_mm_set_epi32(m[s[6]], m[s[4]], m[s[2]], m[s[0]]),
+              _mm_set_epi32(m[s[7]], m[s[5]], m[s[3]], m[s[1]]));
+
+            b = _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1));
+            c = _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2));
+            d = _mm_shuffle_epi32(d, _MM_SHUFFLE(2, 1, 0, 3));
+
+            g(_mm_set_epi32(m[s[14]], m[s[12]], m[s[10]], m[s[8]]),
+              _mm_set_epi32(m[s[15]], m[s[13]], m[s[11]], m[s[9]]));
+
+            b = _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3));
+            c = _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2));
+            d = _mm_shuffle_epi32(d, _MM_SHUFFLE(0, 3, 2, 1));
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state),
+                         _mm_xor_si128(h0, _mm_xor_si128(a, c)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4),
+                         _mm_xor_si128(h1, _mm_xor_si128(b, d)));
+    }
+#endif
+
+    template <typename Word>
+    typename Hasher<Word>::Compress select_compress() {
+#ifdef MULTIFORMATS_BLAKE2_X86
+        if constexpr (sizeof(Word) == 8) {
+            if (__builtin_cpu_supports("avx2"))
+                return compress_avx2;
+        } else {
+            return compress_sse2;
+        }
+#endif
+        return compress_portable<Word>;
+    }
+
+    template <typename Word>
+    void compress(Word* state, std::uint8_t const* block, Word const* counter,
+                  bool last) {
+        static auto const impl = select_compress<Word>();
+        impl(state, block, counter, last);
+    }
+} // namespace
+
+namespace Multiformats::Blake2 {
+    template <typename Word>
+    Hasher<Word>::Hasher(std::size_t digest_size)
+        : digest_size(digest_size) {
+        if (digest_size == 0 || digest_size > max_digest_size)
+            throw std::invalid_argument("invalid BLAKE2 digest size");
+
+        reset();
+    }
+
+    template <typename Word>
+    void Hasher<Word>::reset() {
+        state = iv<Word>();
+        counter = {};
+        buf_len = 0;
+
+        // parameter block: digest length, no key, fanout and depth of 1
+        state[0] ^= 0x01010000 ^ static_cast<Word>(digest_size);
+    }
+
+    template <typename Word>
+    void Hasher<Word>::increment(std::size_t bytes) {
+        counter[0] += static_cast<Word>(bytes);
+        if (counter[0] < bytes)
+            ++counter[1];
+    }
+
+    /**
+     * The final block has to be compressed with the last flag set, so a full
+     * block is only compressed once more input shows up behind it */
+    template <typename Word>
+    void Hasher<Word>::update(std::uint8_t const* data, std::size_t size) {
+        if (size == 0)
+            return;
+
+        std::size_t fill = block_size - buf_len;
+        if (size > fill) {
+            std::memcpy(buf.data() + buf_len, data, fill);
+            increment(block_size);
+            compress(state.data(), buf.data(), counter.data(), false);
+            buf_len = 0;
+            data += fill;
+            size -= fill;
+
+            while (size > block_size) {
+                increment(block_size);
+                compress(state.data(), data, counter.data(), false);
+                data += block_size;
+                size -= block_size;
+            }
+        }
+
+        std::memcpy(buf.data() + buf_len, data, size);
+        buf_len += size;
+    }
+
+    template <typename Word>
+    void Hasher<Word>::final(std::uint8_t* out) {
+        increment(buf_len);
+        std::fill(std::next(buf.begin(), buf_len), buf.end(), 0);
+        compress(state.data(), buf.data(), counter.data(), true);
+
+        for (std::size_t i = 0; i < digest_size; ++i)
+            out[i] = static_cast<std::uint8_t>(
+                state[i / sizeof(Word)] >> (8 * (i % sizeof(Word))));
+    }
+
+    template class Hasher<std::uint64_t>;
+    template class Hasher<std::uint32_t>;
+} // namespace Multiformats::Blake2
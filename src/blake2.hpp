@@ -0,0 +1,80 @@
+/**
+ * BLAKE2b and BLAKE2s -- parameterized digest length hashing (RFC 7693)
+ *
+ * @file blake2.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <array>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats::Blake2 {
+    /** @brief Per-variant constants for the BLAKE2 family */
+    template <typename Word>
+    struct Traits;
+
+    template <>
+    struct Traits<std::uint64_t> {
+        static constexpr std::size_t block_size = 128;
+        static constexpr std::size_t max_digest_size = 64;
+        static constexpr std::size_t rounds = 12;
+    };
+
+    template <>
+    struct Traits<std::uint32_t> {
+        static constexpr std::size_t block_size = 64;
+        static constexpr std::size_t max_digest_size = 32;
+        static constexpr std::size_t rounds = 10;
+    };
+
+    /**
+     * @brief Incremental BLAKE2 state, unkeyed with sequential parameters
+     *
+     * The compression function is selected once at startup, using the AVX2
+     * (BLAKE2b) or SSE2 (BLAKE2s) kernels when the CPU supports them.
+     */
+    template <typename Word>
+    class Hasher {
+      public:
+        static constexpr auto block_size = Traits<Word>::block_size;
+        static constexpr auto max_digest_size = Traits<Word>::max_digest_size;
+
+        using Compress = void (*)(Word* state, std::uint8_t const* block,
+                                  Word const* counter, bool last);
+
+      private:
+        std::array<Word, 8> state;
+        std::array<Word, 2> counter{};
+        std::array<std::uint8_t, block_size> buf{};
+        std::size_t buf_len{};
+        std::size_t digest_size;
+
+        void increment(std::size_t bytes);
+
+      public:
+        /** @throw std::invalid_argument if digest_size is 0 or too large */
+        explicit Hasher(std::size_t digest_size);
+
+        /** @brief Absorb more input */
+        void update(std::uint8_t const* data, std::size_t size);
+
+        /** @brief Finish hashing, writes size() bytes to out */
+        void final(std::uint8_t* out);
+
+        /** @brief Start a new digest of the same length */
+        void reset();
+
+        /** @brief Digest length in bytes */
+        std::size_t size() const { return digest_size; }
+    };
+
+    using Blake2b = Hasher<std::uint64_t>;
+    using Blake2s = Hasher<std::uint32_t>;
+
+    extern template class Hasher<std::uint64_t>;
+    extern template class Hasher<std::uint32_t>;
+} // namespace Multiformats::Blake2
@@ -0,0 +1,587 @@
+// Asynchronous hashing of many files
+//
+// File Name: bulk_hasher.cpp
+// Date: 2026-10-18
+
+#include "multiformats/bulk_hasher.hpp"
+#include "multiformats/multicodec.hpp"
+
+#include "file.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+// timed waits need IORING_ENTER_EXT_ARG
+#if defined(__NR_io_uring_setup) && defined(IORING_FEAT_EXT_ARG)
+#define MULTIFORMATS_HAS_IO_URING 1
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+#endif
+
+namespace {
+    using namespace Multiformats;
+
+#ifdef MULTIFORMATS_HAS_IO_URING
+    /** @brief Largest ring io_uring_setup accepts */
+    constexpr std::size_t max_ring_entries = 32768;
+
+    /** @brief Longest the reaper waits without checking on the slots */
+    constexpr std::chrono::milliseconds reap_timeout{100};
+
+    std::error_code last_error() { return {errno, std::generic_category()}; }
+
+    /** @brief An open file and what fstat knows about its length */
+    struct Source {
+        int fd{-1};
+        off_t size{};
+        bool regular{};
+
+        std::error_code open(std::string const& path) {
+            fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return last_error();
+
+            struct stat info {};
+            if (::fstat(fd, &info) != 0) {
+                auto error = last_error();
+                close();
+                return error;
+            }
+
+            regular = S_ISREG(info.st_mode);
+            size = info.st_size;
+            return {};
+        }
+
+        /** @brief True once every byte of a regular file has been read */
+        bool exhausted(off_t offset) const { return regular && offset >= size; }
+
+        void close() {
+            if (fd >= 0)
+                ::close(fd);
+
+            fd = -1;
+        }
+    };
+
+    /**
+     * Minimal io_uring driver using the raw system calls
+     *
+     * Submissions may come from any thread and are serialized by a mutex;
+     * completions are only ever reaped by the thread calling wait().
+     */
+    class Ring {
+        int fd{-1};
+        io_uring_params params{};
+
+        void* sq_ring{MAP_FAILED};
+        void* cq_ring{MAP_FAILED};
+        std::size_t sq_ring_size{};
+        std::size_t cq_ring_size{};
+        io_uring_sqe* sqes{static_cast<io_uring_sqe*>(MAP_FAILED)};
+
+        unsigned* sq_head{};
+        unsigned* sq_tail{};
+        unsigned* sq_mask{};
+        unsigned* sq_array{};
+        unsigned* cq_head{};
+        unsigned* cq_tail{};
+        unsigned* cq_mask{};
+        io_uring_cqe* cqes{};
+
+        std::mutex submit_mutex;
+
+        template <typename T>
+        T* at(void* ring, std::uint32_t offset) {
+            return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+        }
+
+        int enter(unsigned to_submit, unsigned min_complete, unsigned flags,
+                  io_uring_getevents_arg const* arg = nullptr) {
+            return ::syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+                             flags, arg, arg == nullptr ? 0 : sizeof(*arg));
+        }
+
+        void unmap() {
+            if (sqes != MAP_FAILED)
+                ::munmap(sqes, params.sq_entries * sizeof(io_uring_sqe));
+            if (cq_ring != MAP_FAILED && cq_ring != sq_ring)
+                ::munmap(cq_ring, cq_ring_size);
+            if (sq_ring != MAP_FAILED)
+                ::munmap(sq_ring, sq_ring_size);
+
+            ::close(fd);
+        }
+
+        template <typename Prepare>
+        void submit(Prepare&& prepare) {
+            std::lock_guard lock{submit_mutex};
+
+            unsigned const tail = *sq_tail;
+            unsigned const index = tail & *sq_mask;
+            io_uring_sqe& sqe = sqes[index];
+            sqe = {};
+            prepare(sqe);
+            sq_array[index] = index;
+            __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+            while (enter(1, 0, 0) < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+                    continue;
+
+                // a failed enter consumed nothing, withdraw the entry so a
+                // later submission doesn't send it after its slot moved on
+                auto error = last_error();
+                if (__atomic_load_n(sq_head, __ATOMIC_ACQUIRE) == tail)
+                    __atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+
+                throw std::system_error(error, "io_uring submission failed");
+            }
+        }
+
+      public:
+        /** @brief user_data of completions that only wake the reaper */
+        static constexpr std::uint64_t wake = ~std::uint64_t{};
+
+        explicit Ring(unsigned entries) {
+            fd = ::syscall(__NR_io_uring_setup, entries, &params);
+            if (fd < 0)
+                throw std::system_error(last_error(), "io_uring_setup failed");
+
+            if ((params.features & IORING_FEAT_EXT_ARG) == 0) {
+                ::close(fd);
+                throw std::system_error(
+                    std::make_error_code(std::errc::function_not_supported),
+                    "io_uring can't wait with a timeout");
+            }
+
+            sq_ring_size =
+                params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_ring_size =
+                params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+            bool const single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (single_mmap)
+                sq_ring_size = cq_ring_size =
+                    std::max(sq_ring_size, cq_ring_size);
+
+            sq_ring = ::mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+            cq_ring = single_mmap ? sq_ring
+                                  : ::mmap(nullptr, cq_ring_size,
+                                           PROT_READ | PROT_WRITE,
+                                           MAP_SHARED | MAP_POPULATE, fd,
+                                           IORING_OFF_CQ_RING);
+            sqes = static_cast<io_uring_sqe*>(
+                ::mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe),
+                       PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                       IORING_OFF_SQES));
+
+            if (sq_ring == MAP_FAILED || cq_ring == MAP_FAILED ||
+                sqes == MAP_FAILED) {
+                auto error = last_error();
+                unmap();
+                throw std::system_error(error, "failed to map io_uring");
+            }
+
+            sq_head = at<unsigned>(sq_ring, params.sq_off.head);
+            sq_tail = at<unsigned>(sq_ring, params.sq_off.tail);
+            sq_mask = at<unsigned>(sq_ring, params.sq_off.ring_mask);
+            sq_array = at<unsigned>(sq_ring, params.sq_off.array);
+            cq_head = at<unsigned>(cq_ring, params.cq_off.head);
+            cq_tail = at<unsigned>(cq_ring, params.cq_off.tail);
+            cq_mask = at<unsigned>(cq_ring, params.cq_off.ring_mask);
+            cqes = at<io_uring_cqe>(cq_ring, params.cq_off.cqes);
+        }
+
+        Ring(Ring const&) = delete;
+        Ring& operator=(Ring const&) = delete;
+
+        ~Ring() { unmap(); }
+
+        /** @brief Submission queue size, as rounded up by the kernel */
+        std::size_t capacity() const { return params.sq_entries; }
+
+        void readv(std::uint64_t user_data, int file, iovec const* iov,
+                   off_t offset) {
+            submit([&](io_uring_sqe& sqe) {
+                sqe.opcode = IORING_OP_READV;
+                sqe.fd = file;
+                sqe.addr = reinterpret_cast<std::uint64_t>(iov);
+                sqe.len = 1;
+                sqe.off = offset;
+                sqe.user_data = user_data;
+            });
+        }
+
+        void nop(std::uint64_t user_data) {
+            submit([&](io_uring_sqe& sqe) {
+                sqe.opcode = IORING_OP_NOP;
+                sqe.user_data = user_data;
+            });
+        }
+
+        /**
+         * @brief Block for at least one completion or until timeout, then
+         * drain whatever completed
+         */
+        template <typename Handler>
+        void wait(std::chrono::nanoseconds timeout, Handler&& handler) {
+            __kernel_timespec ts{};
+            ts.tv_sec = timeout.count() / 1000000000;
+            ts.tv_nsec = timeout.count() % 1000000000;
+
+            io_uring_getevents_arg arg{};
+            arg.ts = reinterpret_cast<std::uint64_t>(&ts);
+
+            while (enter(0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                         &arg) < 0) {
+                if (errno == ETIME)
+                    break;
+
+                if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                    throw std::system_error(last_error(),
+                                            "io_uring wait failed");
+            }
+
+            // a completion's submission happened under this lock, taking it
+            // orders the submitter's writes before the handler's reads
+            std::lock_guard lock{submit_mutex};
+            unsigned head = *cq_head;
+            unsigned const tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+            for (; head != tail; ++head) {
+                auto const& cqe = cqes[head & *cq_mask];
+                handler(cqe.user_data, cqe.res);
+            }
+
+            __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+        }
+    };
+#endif
+} // namespace
+
+namespace Multiformats {
+    struct BulkHasher::Impl {
+        Options options;
+        Engine engine;
+#ifdef MULTIFORMATS_HAS_IO_URING
+        struct Slot {
+            std::vector<std::uint8_t> buffer;
+            iovec iov{};
+            Source source;
+            std::size_t index{};
+            off_t offset{};
+            Multihasher stream;
+        };
+
+        // slots a failed wait left reads in flight for, declared before the
+        // ring so they outlive it
+        std::vector<Slot> abandoned;
+
+        // declared before the pool so workers are joined before it goes away
+        std::unique_ptr<Ring> ring;
+#endif
+        ThreadPool pool;
+
+        explicit Impl(Options const& options)
+            : options(options)
+            , engine(Engine::ThreadPool)
+            , pool(options.workers) {
+            if (options.queue_depth == 0 || options.buffer_size == 0)
+                throw std::invalid_argument(
+                    "queue depth and buffer size must be non-zero");
+
+#ifdef MULTIFORMATS_HAS_IO_URING
+            if (options.engine != Engine::ThreadPool) {
+                try {
+                    auto entries = std::min<std::size_t>(options.queue_depth,
+                                                         max_ring_entries);
+                    ring = std::make_unique<Ring>(entries);
+                    engine = Engine::IoUring;
+                } catch (std::system_error const&) {
+                    if (options.engine == Engine::IoUring)
+                        throw;
+                }
+            }
+#else
+            if (options.engine == Engine::IoUring)
+                throw std::system_error(
+                    std::make_error_code(std::errc::function_not_supported),
+                    "io_uring is not available on this platform");
+#endif
+        }
+
+        /**
+         * Every worker takes the next unclaimed file and reads it start to
+         * finish, buffer_size bytes at a time */
+        void hash_blocking(std::vector<std::string> const& paths,
+                           Varint const& protocol, Callback const& callback) {
+            std::atomic<std::size_t> next{};
+            auto const workers = std::min(pool.size(), paths.size());
+
+            // a failed read is the file's error, anything else, such as a
+            // digest failing in OpenSSL, stops the workers claiming files
+            // and is rethrown once they have all finished
+            std::mutex failure_mutex;
+            std::exception_ptr failure;
+
+            WaitGroup group;
+            for (std::size_t i = 0; i < workers; ++i) {
+                pool.submit(group, [&] {
+                    try {
+                        Multihasher stream{protocol};
+
+                        for (auto index = next++; index < paths.size();
+                             index = next++) {
+                            std::error_code error;
+                            try {
+                                File::for_each_chunk(
+                                    paths[index],
+                                    [&](std::uint8_t const* data,
+                                        std::size_t count) {
+                                        stream.update({data, count});
+                                    },
+                                    options.buffer_size);
+                            } catch (std::system_error const& e) {
+                                error = e.code();
+                            }
+
+                            auto multihash = stream.finish();
+                            callback(index, error ? Multihash{} : multihash,
+                                     error);
+                        }
+                    } catch (...) {
+                        next = paths.size();
+                        std::lock_guard lock{failure_mutex};
+                        if (!failure)
+                            failure = std::current_exception();
+                    }
+                });
+            }
+
+            group.wait();
+            if (failure)
+                std::rethrow_exception(failure);
+        }
+
+#ifdef MULTIFORMATS_HAS_IO_URING
+        /**
+         * Each slot owns a buffer and at most one file. A file has a single
+         * read in flight, so its chunks are hashed in order, while up to
+         * queue_depth files are read concurrently. The calling thread only
+         * reaps completions; hashing, opening the next file and submitting
+         * the next read happen on the worker pool.
+         */
+        void hash_io_uring(std::vector<std::string> const& paths,
+                           Varint const& protocol, Callback const& callback) {
+            std::vector<Slot> slots;
+            auto const slot_count = std::min(
+                {options.queue_depth, ring->capacity(), paths.size()});
+            slots.reserve(slot_count);
+            for (std::size_t i = 0; i < slot_count; ++i)
+                slots.push_back(
+                    {std::vector<std::uint8_t>(options.buffer_size), {}, {},
+                     0, 0, Multihasher{protocol}});
+
+            std::atomic<std::size_t> next{};
+            std::atomic<std::size_t> retired{};
+
+            // set once a wake couldn't be submitted, after which the ring
+            // isn't trusted with more reads
+            std::atomic<bool> shutdown{};
+
+            // the wake only hurries the reaper, which returns once every
+            // slot has retired
+            auto retire = [&] {
+                try {
+                    ring->nop(Ring::wake);
+                } catch (std::system_error const&) {
+                    shutdown = true;
+                }
+
+                ++retired;
+            };
+
+            // a task that throws, say because a digest failed in OpenSSL,
+            // leaves its slot without a read in flight, so the slot retires
+            // and the others stop claiming files. The exception is rethrown
+            // once every slot has retired.
+            std::mutex failure_mutex;
+            std::exception_ptr failure;
+
+            // a failed submission is the file's error, rather than a
+            // failure of the whole call
+            auto read = [&](std::size_t id) -> std::error_code {
+                if (shutdown)
+                    return std::make_error_code(std::errc::operation_canceled);
+
+                auto& slot = slots[id];
+                slot.iov = {slot.buffer.data(), slot.buffer.size()};
+                try {
+                    ring->readv(id, slot.source.fd, &slot.iov, slot.offset);
+                } catch (std::system_error const& e) {
+                    return e.code();
+                }
+
+                return {};
+            };
+
+            auto fail = [&](std::size_t id, std::error_code error) {
+                auto& slot = slots[id];
+                slot.source.close();
+                slot.stream.finish();
+                callback(slot.index, {}, error);
+            };
+
+            // claim files until one is being read, or retire the slot
+            auto start_next = [&](std::size_t id) {
+                auto& slot = slots[id];
+                for (auto index = next++; index < paths.size();
+                     index = next++) {
+                    slot.index = index;
+                    slot.offset = 0;
+                    if (auto error = slot.source.open(paths[index])) {
+                        callback(index, {}, error);
+                    } else if (slot.source.exhausted(0)) {
+                        slot.source.close();
+                        callback(index, slot.stream.finish(), {});
+                    } else if (auto error = read(id)) {
+                        fail(id, error);
+                    } else {
+                        return;
+                    }
+                }
+
+                retire();
+            };
+
+            auto complete = [&](std::size_t id, int result) {
+                auto& slot = slots[id];
+                if (result > 0) {
+                    slot.stream.update({slot.buffer.data(),
+                                        static_cast<std::size_t>(result)});
+                    slot.offset += result;
+                }
+
+                if (result == -EINTR || result == -EAGAIN ||
+                    (result > 0 && !slot.source.exhausted(slot.offset))) {
+                    auto error = read(id);
+                    if (!error)
+                        return;
+
+                    fail(id, error);
+                } else if (result < 0) {
+                    fail(id, {-result, std::generic_category()});
+                } else {
+                    slot.source.close();
+                    callback(slot.index, slot.stream.finish(), {});
+                }
+
+                start_next(id);
+            };
+
+            // every task on the pool, declared after everything they use
+            // so none outlives it
+            WaitGroup tasks;
+            auto post = [&](std::size_t id, auto task) {
+                pool.submit(tasks, [&, id, task] {
+                    try {
+                        task();
+                    } catch (...) {
+                        next = paths.size();
+                        {
+                            std::lock_guard lock{failure_mutex};
+                            if (!failure)
+                                failure = std::current_exception();
+                        }
+
+                        retire();
+                    }
+                });
+            };
+
+            // once a read is in flight, failing to post even the first
+            // tasks leaves the slots to the ring like a failed wait. The
+            // timeout only matters when a wake was never submitted.
+            std::exception_ptr error;
+            try {
+                for (std::size_t id = 0; id < slot_count; ++id)
+                    post(id, [&, id] { start_next(id); });
+
+                while (retired < slot_count)
+                    ring->wait(reap_timeout,
+                               [&](std::uint64_t user_data, int result) {
+                                   if (user_data == Ring::wake)
+                                       return;
+
+                                   post(user_data, [&, user_data, result] {
+                                       complete(user_data, result);
+                                   });
+                               });
+            } catch (...) {
+                error = std::current_exception();
+                shutdown = true;
+            }
+
+            tasks.wait();
+            if (error) {
+                // reads still in flight write into the slots, keep them
+                // with the ring, and hash with the thread pool from now on
+                abandoned = std::move(slots);
+                engine = Engine::ThreadPool;
+                std::rethrow_exception(error);
+            }
+
+            if (failure)
+                std::rethrow_exception(failure);
+        }
+#endif
+    };
+
+    BulkHasher::BulkHasher()
+        : BulkHasher(Options{}) {}
+
+    BulkHasher::BulkHasher(Options options)
+        : impl(std::make_unique<Impl>(options)) {}
+
+    BulkHasher::~BulkHasher() = default;
+
+    void BulkHasher::hash(std::vector<std::string> const& paths,
+                          Varint const& protocol, Callback const& callback) {
+        // fail early on an unsupported function code
+        Multihasher{protocol};
+
+        if (paths.empty())
+            return;
+
+#ifdef MULTIFORMATS_HAS_IO_URING
+        if (impl->engine == Engine::IoUring)
+            return impl->hash_io_uring(paths, protocol, callback);
+#endif
+
+        impl->hash_blocking(paths, protocol, callback);
+    }
+
+    void BulkHasher::hash(std::vector<std::string> const& paths,
+                          std::string const& protocol,
+                          Callback const& callback) {
+        hash(paths, Multicodec::code(protocol), callback);
+    }
+
+    BulkHasher::Engine BulkHasher::engine() const { return impl->engine; }
+} // namespace Multiformats
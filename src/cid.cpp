@@ -15,8 +15,6 @@
 #include <array>
 #include <sstream>
 
-#include <iostream>
-
 namespace Multiformats {
     Cid::Cid(std::string const& encoded)
         : Cid(Multibase::decode(encoded)) {}
@@ -67,17 +65,13 @@ namespace Multiformats {
 
     std::string Cid::human_readable(Multibase::Protocol const& protocol) {
         static constexpr auto separator = " - ";
-        static constexpr auto get_key = [](auto const& map,
-                                           auto const& value) -> std::string {
-            auto it = std::find_if(
-                map.cbegin(), map.cend(),
-                [&value](auto const& elem) { return value == elem.second; });
-            return it == map.cend() ? "unknown" : it->first;
+        auto get_name = [](std::uint64_t code) {
+            auto name = Multicodec::name(code);
+            return name.empty() ? std::string{"unknown"} : std::string{name};
         };
 
-        std::string codec = get_key(Multicodec::table, content_type);
-        std::string func_str =
-            get_key(Multicodec::table, content_address.func_code());
+        std::string codec = get_name(content_type);
+        std::string func_str = get_name(content_address.func_code());
         std::uint64_t bits = content_address.len() * 8;
         std::vector<std::uint8_t> tmp{content_address.digest(),
                                       content_address.end()};
@@ -0,0 +1,102 @@
+// Compact CID for use as a hash map key
+//
+// File Name: cid_key.cpp
+// Date: 2026-10-18
+
+#include "multiformats/cid_key.hpp"
+
+#include "multiformats/multicodec.hpp"
+#include "multiformats/varint.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Multiformats {
+    CidKey::CidKey(ByteSpan binary) {
+        std::copy(binary.begin(), binary.end(), storage.assign(binary.size()));
+        parse_header();
+    }
+
+    CidKey::CidKey(Cid const& cid) {
+        // a CIDv0 has no version and content type in its binary form
+        auto const v1 = cid.version != 0;
+        auto const header_size =
+            v1 ? cid.version.size() + cid.content_type.size() : 0;
+
+        auto* out = storage.assign(header_size + cid.content_address.size());
+        if (v1) {
+            out = std::copy(cid.version.begin(), cid.version.end(), out);
+            out = std::copy(cid.content_type.begin(), cid.content_type.end(),
+                            out);
+        }
+
+        std::copy(cid.content_address.begin(), cid.content_address.end(),
+                  out);
+        parse_header();
+    }
+
+    void CidKey::parse_header() {
+        auto const* const begin = data();
+        auto const* const end = begin + size();
+        auto const* pos = begin;
+
+        auto const fail = [this] {
+            storage.clear();
+            throw std::invalid_argument("invalid CID");
+        };
+
+        // anything but a CIDv0 starts with its version and content type
+        if (size() != 34 || begin[0] != 0x12 || begin[1] != 0x20) {
+            std::uint64_t version{};
+            std::uint64_t content_type{};
+            auto const version_size = decode_varint(pos, end, version);
+            if (version_size == 0 || version != 1)
+                fail();
+
+            pos += version_size;
+            auto const content_type_size =
+                decode_varint(pos, end, content_type);
+            if (content_type_size == 0)
+                fail();
+
+            pos += content_type_size;
+        }
+
+        std::uint64_t code{};
+        std::uint64_t digest_size{};
+        auto const code_size = decode_varint(pos, end, code);
+        auto const size_size =
+            code_size ? decode_varint(pos + code_size, end, digest_size) : 0;
+        if (size_size == 0 ||
+            digest_size != static_cast<std::size_t>(end - pos) - code_size -
+                               size_size)
+            fail();
+
+        auto const multihash_offset = static_cast<std::uint8_t>(pos - begin);
+        storage.header.multihash_offset = multihash_offset;
+        storage.header.digest_offset =
+            static_cast<std::uint8_t>(multihash_offset + code_size + size_size);
+    }
+
+    Cid CidKey::to_cid() const {
+        if (empty())
+            throw std::invalid_argument("CID key is empty");
+
+        auto const binary = to_binary();
+        return Cid{version(), content_type(),
+                   Multihash(binary.begin() + multihash_offset(), binary.end())};
+    }
+
+    std::uint64_t CidKey::version() const {
+        return multihash_offset() == 0 ? 0 : 1;
+    }
+
+    std::uint64_t CidKey::content_type() const {
+        if (multihash_offset() == 0)
+            return static_cast<std::uint64_t>(Multicodec::Code::dag_pb);
+
+        std::uint64_t ret{};
+        decode_varint(data() + 1, data() + multihash_offset(), ret);
+        return ret;
+    }
+} // namespace Multiformats
@@ -0,0 +1,80 @@
+// Concurrent set of CIDs
+//
+// File Name: cid_set.cpp
+// Date: 2026-10-18
+
+#include "multiformats/cid_set.hpp"
+
+#include "sharded.hpp"
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+#include <cstddef>
+
+namespace {
+    using namespace Multiformats;
+
+    struct Keys {
+        std::unordered_set<CidKey> keys;
+    };
+} // namespace
+
+namespace Multiformats {
+    struct CidSet::Impl {
+        Sharded<Keys> shards;
+
+        explicit Impl(std::size_t count)
+            : shards(count) {}
+    };
+
+    CidSet::CidSet(std::size_t shards) {
+        if (shards == 0)
+            throw std::invalid_argument("set needs at least one shard");
+
+        impl = std::make_unique<Impl>(shards);
+    }
+
+    CidSet::~CidSet() = default;
+
+    bool CidSet::insert(CidKey key) {
+        auto& shard = impl->shards.pick(key.hash());
+
+        // most blocks of a deduplicating ingest have been seen before, so
+        // check under the shared lock first
+        {
+            std::shared_lock lock{shard.mutex};
+            if (shard.keys.count(key) != 0)
+                return false;
+        }
+
+        std::unique_lock lock{shard.mutex};
+        return shard.keys.insert(std::move(key)).second;
+    }
+
+    bool CidSet::contains(CidKey const& key) const {
+        auto& shard = impl->shards.pick(key.hash());
+        std::shared_lock lock{shard.mutex};
+        return shard.keys.count(key) != 0;
+    }
+
+    bool CidSet::erase(CidKey const& key) {
+        auto& shard = impl->shards.pick(key.hash());
+        std::unique_lock lock{shard.mutex};
+        return shard.keys.erase(key) != 0;
+    }
+
+    std::size_t CidSet::size() const {
+        std::size_t ret{};
+        for (std::size_t i = 0; i < impl->shards.count(); ++i) {
+            std::shared_lock lock{impl->shards[i].mutex};
+            ret += impl->shards[i].keys.size();
+        }
+
+        return ret;
+    }
+} // namespace Multiformats
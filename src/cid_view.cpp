@@ -0,0 +1,282 @@
+// Non-owning CID parsed in place
+//
+// File Name: cid_view.cpp
+// Date: 2026-10-18
+
+#include "multiformats/cid_view.hpp"
+
+#include "multiformats/multibase.hpp"
+#include "multiformats/multicodec.hpp"
+#include "multiformats/varint.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    using Multiformats::CidError;
+
+    constexpr std::uint8_t invalid = 0xff;
+    using Lookup = std::array<std::uint8_t, 256>;
+
+    /** @brief Digit of each character, invalid for those not in alphabet */
+    constexpr Lookup make_lookup(char const* alphabet, bool fold_case) {
+        Lookup ret{};
+        for (auto& digit : ret)
+            digit = invalid;
+
+        for (std::uint8_t i = 0; alphabet[i] != '\0'; ++i) {
+            auto const c = static_cast<unsigned char>(alphabet[i]);
+            ret[c] = i;
+            if (fold_case && c >= 'a' && c <= 'z')
+                ret[c - 'a' + 'A'] = i;
+        }
+
+        return ret;
+    }
+
+    constexpr auto base16_lookup = make_lookup("0123456789abcdef", false);
+    constexpr auto base16_upper_lookup =
+        make_lookup("0123456789abcdef", true);
+    constexpr auto base32_lookup =
+        make_lookup("abcdefghijklmnopqrstuvwxyz234567", false);
+    constexpr auto base32_upper_lookup =
+        make_lookup("abcdefghijklmnopqrstuvwxyz234567", true);
+    constexpr auto base58_btc_lookup = make_lookup(
+        "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz", false);
+    constexpr auto base64_lookup = make_lookup(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+        false);
+    constexpr auto base64_url_lookup = make_lookup(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_",
+        false);
+
+    /**
+     * @brief Decode a base of 2^bits, bits at a time from the most
+     * significant, with no padding
+     *
+     * The bits left over at the end must be fewer than a digit and zero, as
+     * in the canonical encoding.
+     */
+    CidError decode_bits(Lookup const& lookup, unsigned bits,
+                         std::string_view digits,
+                         Multiformats::Span<std::uint8_t> buffer,
+                         std::size_t& size) {
+        if (digits.size() * bits / 8 > buffer.size())
+            return CidError::BufferTooSmall;
+
+        std::uint32_t accumulator{};
+        unsigned pending{};
+        auto* out = buffer.data();
+        for (auto const c : digits) {
+            auto const digit = lookup[static_cast<unsigned char>(c)];
+            if (digit == invalid)
+                return CidError::Multibase;
+
+            accumulator = (accumulator << bits) | digit;
+            pending += bits;
+            if (pending >= 8) {
+                pending -= 8;
+                *out++ = static_cast<std::uint8_t>(accumulator >> pending);
+            }
+        }
+
+        if (pending >= bits || (accumulator & ((1u << pending) - 1)) != 0)
+            return CidError::Multibase;
+
+        size = static_cast<std::size_t>(out - buffer.data());
+        return CidError::None;
+    }
+
+    /** @brief Limbs of the base58 number, enough for any CID */
+    constexpr std::size_t base58_limbs = 64;
+
+    /** @brief Digits that surely fit, log2(58) being less than 6 */
+    constexpr std::size_t max_base58_digits = base58_limbs * 32 / 6;
+
+    /**
+     * @brief Decode base58btc with 32-bit limbs
+     *
+     * Five digits are folded into the number at a time, 58^5 fitting in 32
+     * bits, rather than one digit into every byte. Each leading '1' is a
+     * leading zero byte.
+     */
+    CidError decode_base58(std::string_view digits,
+                           Multiformats::Span<std::uint8_t> buffer,
+                           std::size_t& size) {
+        auto const zeros = std::min(digits.find_first_not_of('1'),
+                                    digits.size());
+
+        std::array<std::uint32_t, base58_limbs> limbs;
+        std::size_t used{};
+        for (auto pos = zeros; pos < digits.size();) {
+            std::uint32_t value{};
+            std::uint32_t scale{1};
+            for (auto const end = std::min(pos + 5, digits.size()); pos < end;
+                 ++pos) {
+                auto const digit =
+                    base58_btc_lookup[static_cast<unsigned char>(digits[pos])];
+                if (digit == invalid)
+                    return CidError::Multibase;
+
+                value = value * 58 + digit;
+                scale *= 58;
+            }
+
+            std::uint64_t carry = value;
+            for (std::size_t i = 0; i < used; ++i) {
+                carry += std::uint64_t{limbs[i]} * scale;
+                limbs[i] = static_cast<std::uint32_t>(carry);
+                carry >>= 32;
+            }
+
+            if (carry != 0)
+                limbs[used++] = static_cast<std::uint32_t>(carry);
+        }
+
+        // bytes of the number, most significant first, without leading zeros
+        std::size_t significant = used * 4;
+        if (used != 0) {
+            for (auto top = limbs[used - 1]; (top & 0xff000000) == 0;
+                 top <<= 8)
+                --significant;
+        }
+
+        if (zeros + significant > buffer.size())
+            return CidError::BufferTooSmall;
+
+        auto* out = std::fill_n(buffer.data(), zeros, std::uint8_t{0});
+        for (auto i = significant; i-- != 0;)
+            *out++ = static_cast<std::uint8_t>(limbs[i / 4] >> (i % 4 * 8));
+
+        size = zeros + significant;
+        return CidError::None;
+    }
+
+    /** @brief Decode a base this file has no decoder for */
+    CidError decode_multibase(std::string_view text,
+                              Multiformats::Span<std::uint8_t> buffer,
+                              std::size_t& size) {
+        std::vector<std::uint8_t> binary;
+        try {
+            binary = Multiformats::Multibase::decode(std::string{text});
+        } catch (std::runtime_error const&) {
+            return CidError::Multibase;
+        }
+
+        if (binary.size() > buffer.size())
+            return CidError::BufferTooSmall;
+
+        std::copy(binary.begin(), binary.end(), buffer.data());
+        size = binary.size();
+        return CidError::None;
+    }
+} // namespace
+
+namespace Multiformats {
+    char const* to_string(CidError error) {
+        switch (error) {
+        case CidError::None:
+            return "no error";
+        case CidError::Truncated:
+            return "truncated CID";
+        case CidError::TrailingBytes:
+            return "bytes after the multihash digest";
+        case CidError::Version:
+            return "unsupported CID version";
+        case CidError::Multibase:
+            return "invalid multibase text";
+        case CidError::BufferTooSmall:
+            return "buffer too small for the decoded CID";
+        }
+
+        return "unknown error";
+    }
+
+    CidError CidView::parse(ByteSpan binary, CidView& out) {
+        auto const* const begin = binary.data();
+        auto const* const end = begin + binary.size();
+        if (begin == end)
+            return CidError::Truncated;
+
+        CidView ret;
+        auto const* pos = begin;
+
+        // a sha2-256 multihash with a 32 byte digest is a CIDv0, the same
+        // bytes as the version varint of a CIDv18
+        if (begin[0] == 0x12 && (binary.size() < 2 || begin[1] == 0x20)) {
+            ret.codec = static_cast<std::uint64_t>(Multicodec::Code::dag_pb);
+        } else {
+            auto const version_size = decode_varint(pos, end, ret.cid_version);
+            if (version_size == 0)
+                return CidError::Truncated;
+            if (ret.cid_version != 1)
+                return CidError::Version;
+
+            pos += version_size;
+            auto const codec_size = decode_varint(pos, end, ret.codec);
+            if (codec_size == 0)
+                return CidError::Truncated;
+
+            pos += codec_size;
+        }
+
+        std::uint64_t digest_size{};
+        auto const function_size = decode_varint(pos, end, ret.function);
+        auto const size_size =
+            function_size ? decode_varint(pos + function_size, end, digest_size)
+                          : 0;
+        if (size_size == 0)
+            return CidError::Truncated;
+
+        auto const header_size = function_size + size_size;
+        auto const available =
+            static_cast<std::size_t>(end - pos) - header_size;
+        if (digest_size > available)
+            return CidError::Truncated;
+        if (digest_size < available)
+            return CidError::TrailingBytes;
+
+        ret.bytes = binary;
+        ret.multihash_offset = static_cast<std::uint8_t>(pos - begin);
+        ret.digest_offset =
+            static_cast<std::uint8_t>(ret.multihash_offset + header_size);
+        out = ret;
+        return CidError::None;
+    }
+
+    CidError CidView::parse(std::string_view text, Span<std::uint8_t> buffer,
+                            CidView& out) {
+        if (text.empty())
+            return CidError::Multibase;
+
+        std::size_t size{};
+        CidError error;
+        auto const digits = text.substr(1);
+        if (text.size() == 46 && text.compare(0, 2, "Qm") == 0)
+            error = decode_base58(text, buffer, size);
+        else if (text.front() == 'z' && digits.size() <= max_base58_digits)
+            error = decode_base58(digits, buffer, size);
+        else if (text.front() == 'f')
+            error = decode_bits(base16_lookup, 4, digits, buffer, size);
+        else if (text.front() == 'F')
+            error = decode_bits(base16_upper_lookup, 4, digits, buffer, size);
+        else if (text.front() == 'b')
+            error = decode_bits(base32_lookup, 5, digits, buffer, size);
+        else if (text.front() == 'B')
+            error = decode_bits(base32_upper_lookup, 5, digits, buffer, size);
+        else if (text.front() == 'm')
+            error = decode_bits(base64_lookup, 6, digits, buffer, size);
+        else if (text.front() == 'u')
+            error = decode_bits(base64_url_lookup, 6, digits, buffer, size);
+        else
+            error = decode_multibase(text, buffer, size);
+
+        if (error != CidError::None)
+            return error;
+
+        return parse(ByteSpan{buffer.data(), size}, out);
+    }
+} // namespace Multiformats
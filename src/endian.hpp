@@ -0,0 +1,51 @@
+/**
+ * Fixed byte order loads and stores
+ *
+ * @file endian.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace Multiformats::Endian {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    constexpr bool little = false;
+#else
+    constexpr bool little = true;
+#endif
+
+    inline std::uint32_t bswap32(std::uint32_t x) {
+        return (x >> 24) | ((x >> 8) & 0xff00) | ((x << 8) & 0xff0000) |
+               (x << 24);
+    }
+
+    inline std::uint64_t bswap64(std::uint64_t x) {
+        return (static_cast<std::uint64_t>(bswap32(x)) << 32) |
+               bswap32(x >> 32);
+    }
+
+    inline std::uint32_t load_le32(std::uint8_t const* src) {
+        std::uint32_t ret;
+        std::memcpy(&ret, src, sizeof(ret));
+        return little ? ret : bswap32(ret);
+    }
+
+    inline std::uint64_t load_le64(std::uint8_t const* src) {
+        std::uint64_t ret;
+        std::memcpy(&ret, src, sizeof(ret));
+        return little ? ret : bswap64(ret);
+    }
+
+    inline void store_be32(std::uint8_t* dst, std::uint32_t value) {
+        value = little ? bswap32(value) : value;
+        std::memcpy(dst, &value, sizeof(value));
+    }
+
+    inline void store_be64(std::uint8_t* dst, std::uint64_t value) {
+        value = little ? bswap64(value) : value;
+        std::memcpy(dst, &value, sizeof(value));
+    }
+} // namespace Multiformats::Endian
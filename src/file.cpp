@@ -0,0 +1,264 @@
+// Sequential file reading for hashing
+//
+// File Name: file.cpp
+// Date: 2026-10-18
+
+#include "file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#define MULTIFORMATS_POSIX_FILES 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <cstdio>
+#endif
+
+#include <cerrno>
+
+namespace {
+    using namespace Multiformats::File;
+
+    /** @brief Reads up to size bytes, returns 0 at end of file */
+    using ReadSome = std::function<std::size_t(std::uint8_t*, std::size_t)>;
+
+    /**
+     * Double buffered reader
+     *
+     * The reader thread fills one buffer while the caller consumes the other.
+     * A buffer is owned by the reader while it is empty and by the consumer
+     * while it is full, so the data itself is never touched under the lock.
+     */
+    class ReadAhead {
+        struct Buffer {
+            std::vector<std::uint8_t> data;
+            std::size_t size{};
+            bool full{};
+        };
+
+        std::array<Buffer, 2> buffers;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::exception_ptr error;
+        bool cancelled{};
+
+        void produce(ReadSome const& read_some) {
+            for (std::size_t i = 0;; i ^= 1) {
+                auto& buffer = buffers[i];
+                {
+                    std::unique_lock lock{mutex};
+                    cv.wait(lock, [&] { return !buffer.full || cancelled; });
+                    if (cancelled)
+                        return;
+                }
+
+                std::size_t size{};
+                try {
+                    while (size < buffer.data.size()) {
+                        auto count = read_some(buffer.data.data() + size,
+                                               buffer.data.size() - size);
+                        if (count == 0)
+                            break;
+
+                        size += count;
+                    }
+                } catch (...) {
+                    std::lock_guard lock{mutex};
+                    error = std::current_exception();
+                    size = 0;
+                }
+
+                {
+                    std::lock_guard lock{mutex};
+                    buffer.size = size;
+                    buffer.full = true;
+                }
+                cv.notify_all();
+
+                // an empty buffer marks end of file
+                if (size == 0)
+                    return;
+            }
+        }
+
+      public:
+        explicit ReadAhead(std::size_t stride) {
+            for (auto& buffer : buffers)
+                buffer.data.resize(stride);
+        }
+
+        void run(ReadSome const& read_some, ChunkCallback const& callback) {
+            std::thread reader{[&] { produce(read_some); }};
+
+            try {
+                for (std::size_t i = 0;; i ^= 1) {
+                    auto& buffer = buffers[i];
+                    {
+                        std::unique_lock lock{mutex};
+                        cv.wait(lock, [&] { return buffer.full; });
+                    }
+
+                    if (buffer.size == 0)
+                        break;
+
+                    callback(buffer.data.data(), buffer.size);
+
+                    {
+                        std::lock_guard lock{mutex};
+                        buffer.full = false;
+                    }
+                    cv.notify_all();
+                }
+            } catch (...) {
+                {
+                    std::lock_guard lock{mutex};
+                    cancelled = true;
+                }
+                cv.notify_all();
+                reader.join();
+                throw;
+            }
+
+            reader.join();
+            if (error)
+                std::rethrow_exception(error);
+        }
+    };
+
+#ifdef MULTIFORMATS_POSIX_FILES
+    [[noreturn]] void throw_errno(char const* what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    std::size_t read_fd(int fd, std::uint8_t* buf, std::size_t size,
+                        off_t& offset, bool& seekable) {
+        for (;;) {
+            auto count = seekable ? ::pread(fd, buf, size, offset)
+                                  : ::read(fd, buf, size);
+            if (count >= 0) {
+                offset += count;
+                return count;
+            }
+
+            if (errno == ESPIPE && seekable)
+                seekable = false;
+            else if (errno != EINTR)
+                throw_errno("failed to read file");
+        }
+    }
+#endif
+} // namespace
+
+namespace Multiformats::File {
+#ifdef MULTIFORMATS_POSIX_FILES
+    Mapping::Mapping(std::string const& path)
+        : fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC)) {
+        if (fd < 0)
+            throw_errno("failed to open file");
+
+        struct stat info {};
+        if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) ||
+            info.st_size <= 0)
+            return;
+
+        void* addr = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd,
+                            0);
+        if (addr == MAP_FAILED)
+            return;
+
+        ptr = static_cast<std::uint8_t const*>(addr);
+        length = info.st_size;
+
+        ::madvise(addr, length, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+        // only honoured by some filesystems, harmless elsewhere
+        ::madvise(addr, length, MADV_HUGEPAGE);
+#endif
+    }
+
+    Mapping::~Mapping() {
+        if (ptr != nullptr)
+            ::munmap(const_cast<std::uint8_t*>(ptr), length);
+
+        ::close(fd);
+    }
+
+    void Mapping::will_need(std::size_t offset, std::size_t size) const {
+        if (offset < length)
+            ::madvise(const_cast<std::uint8_t*>(ptr) + offset,
+                      std::min(size, length - offset), MADV_WILLNEED);
+    }
+
+    void Mapping::done_with(std::size_t offset, std::size_t size) const {
+        if (offset < length)
+            ::madvise(const_cast<std::uint8_t*>(ptr) + offset,
+                      std::min(size, length - offset), MADV_DONTNEED);
+    }
+
+    void for_each_chunk(std::string const& path, ChunkCallback const& callback,
+                        std::size_t stride) {
+        Mapping file{path};
+
+        if (file.mapped()) {
+            // keep every stride page aligned for madvise
+            std::size_t const page = ::sysconf(_SC_PAGESIZE);
+            stride = (stride + page - 1) / page * page;
+
+            file.will_need(0, stride);
+            for (std::size_t offset = 0; offset < file.size();
+                 offset += stride) {
+                file.will_need(offset + stride, stride);
+                callback(file.data() + offset,
+                         std::min(stride, file.size() - offset));
+                file.done_with(offset, stride);
+            }
+
+            return;
+        }
+
+        off_t offset{};
+        bool seekable{true};
+        ReadAhead{stride}.run(
+            [&](std::uint8_t* buf, std::size_t size) {
+                return read_fd(file.descriptor(), buf, size, offset, seekable);
+            },
+            callback);
+    }
+#else
+    // no mmap on this platform, always use the buffered reader
+    Mapping::Mapping(std::string const&) {}
+    Mapping::~Mapping() = default;
+    void Mapping::will_need(std::size_t, std::size_t) const {}
+    void Mapping::done_with(std::size_t, std::size_t) const {}
+
+    void for_each_chunk(std::string const& path, ChunkCallback const& callback,
+                        std::size_t stride) {
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> file{
+            std::fopen(path.c_str(), "rb"), std::fclose};
+        if (!file)
+            throw std::system_error(errno, std::generic_category(),
+                                    "failed to open file");
+
+        ReadAhead{stride}.run(
+            [&](std::uint8_t* buf, std::size_t size) {
+                auto count = std::fread(buf, 1, size, file.get());
+                if (count == 0 && std::ferror(file.get()))
+                    throw std::system_error(errno, std::generic_category(),
+                                            "failed to read file");
+                return count;
+            },
+            callback);
+    }
+#endif
+} // namespace Multiformats::File
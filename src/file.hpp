@@ -0,0 +1,68 @@
+/**
+ * Sequential file reading for hashing
+ *
+ * @file file.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats::File {
+    /** @brief Receives consecutive pieces of a file, in order */
+    using ChunkCallback = std::function<void(std::uint8_t const*, std::size_t)>;
+
+    /** @brief Bytes handed to the callback at a time */
+    constexpr std::size_t default_stride = 4 * 1024 * 1024;
+
+    /**
+     * @brief Read-only mapping of a whole regular file
+     *
+     * If the file can't be mapped (not a regular file, empty, or mmap is not
+     * available on this platform) mapped() returns false, and the descriptor
+     * stays open so it can be read instead.
+     */
+    class Mapping {
+        int fd{-1};
+        std::uint8_t const* ptr{};
+        std::size_t length{};
+
+      public:
+        /** @throw std::system_error if the file can't be opened */
+        explicit Mapping(std::string const& path);
+
+        Mapping(Mapping const&) = delete;
+        Mapping& operator=(Mapping const&) = delete;
+        ~Mapping();
+
+        bool mapped() const { return ptr != nullptr; }
+        int descriptor() const { return fd; }
+        std::uint8_t const* data() const { return ptr; }
+        std::size_t size() const { return length; }
+
+        /** @brief Hint that size bytes from offset will be needed soon */
+        void will_need(std::size_t offset, std::size_t size) const;
+
+        /** @brief Drop pages of a range that has been consumed from RSS */
+        void done_with(std::size_t offset, std::size_t size) const;
+    };
+
+    /**
+     * @brief Feed an entire file to callback in stride sized chunks
+     *
+     * Regular files are memory mapped and walked sequentially, prefetching
+     * one stride ahead and releasing pages behind, so resident memory stays
+     * around two strides regardless of file size. Anything that can't be
+     * mapped is read by a background thread into two alternating buffers,
+     * overlapping I/O with the callback.
+     *
+     * @throw std::system_error on open or read failure
+     */
+    void for_each_chunk(std::string const& path, ChunkCallback const& callback,
+                        std::size_t stride = default_stride);
+} // namespace Multiformats::File
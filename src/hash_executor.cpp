@@ -0,0 +1,291 @@
+// Multihash generation on a pool of worker threads
+//
+// File Name: hash_executor.cpp
+// Date: 2026-10-18
+
+#include "multiformats/hash_executor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    using namespace Multiformats;
+
+    struct Job {
+        std::vector<std::uint8_t> owned;
+        ByteSpan data;
+        std::uint64_t code{};
+        std::promise<Multihash> promise;
+        HashExecutor::Callback callback;
+
+        void complete(Multihash const& multihash) {
+            if (callback)
+                callback(multihash, nullptr);
+            else
+                promise.set_value(multihash);
+        }
+
+        void fail(std::exception_ptr error) {
+            if (callback)
+                callback({}, error);
+            else
+                promise.set_exception(error);
+        }
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    // lets a callback's submit() land on its own worker's queue
+    thread_local HashExecutor::Impl const* current_executor{};
+    thread_local std::size_t current_worker{};
+} // namespace
+
+namespace Multiformats {
+    /**
+     * Jobs are counted twice under the executor mutex: queued bounds what
+     * is waiting for backpressure, available is what no worker has claimed
+     * yet. A worker claims jobs by decrementing available before removing
+     * them from a queue, and only ever removes as many as it has claimed,
+     * so a claimed job is always somewhere in the queues.
+     */
+    struct HashExecutor::Impl {
+        Options options;
+        std::vector<Queue> queues;
+        std::vector<std::thread> threads;
+        std::atomic<std::size_t> next_queue{};
+
+        std::mutex mutex;
+        std::condition_variable work_cv;
+        std::condition_variable space_cv;
+        std::size_t queued{};
+        std::size_t available{};
+        bool stopping{};
+
+        explicit Impl(Options const& opts)
+            : options(opts) {
+            if (options.queue_capacity == 0 || options.batch_size == 0)
+                throw std::invalid_argument(
+                    "queue capacity and batch size must be non-zero");
+
+            if (options.workers == 0)
+                options.workers =
+                    std::max(1u, std::thread::hardware_concurrency());
+
+            queues = std::vector<Queue>(options.workers);
+            threads.reserve(options.workers);
+            for (std::size_t i = 0; i < options.workers; ++i)
+                threads.emplace_back([this, i] { work(i); });
+        }
+
+        ~Impl() {
+            {
+                std::lock_guard lock{mutex};
+                stopping = true;
+            }
+            work_cv.notify_all();
+
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        void push(Job&& job) {
+            {
+                std::unique_lock lock{mutex};
+                space_cv.wait(lock, [&] {
+                    return queued < options.queue_capacity;
+                });
+                ++queued;
+            }
+
+            auto const index = current_executor == this
+                                   ? current_worker
+                                   : next_queue++ % queues.size();
+            {
+                std::lock_guard lock{queues[index].mutex};
+                queues[index].jobs.push_back(std::move(job));
+            }
+
+            {
+                std::lock_guard lock{mutex};
+                ++available;
+            }
+            work_cv.notify_one();
+        }
+
+        /** @brief Claim one job, false once stopping with nothing left */
+        bool claim() {
+            std::unique_lock lock{mutex};
+            work_cv.wait(lock, [&] { return available > 0 || stopping; });
+            if (available == 0)
+                return false;
+
+            --available;
+            return true;
+        }
+
+        bool try_claim() {
+            std::lock_guard lock{mutex};
+            if (available == 0)
+                return false;
+
+            --available;
+            return true;
+        }
+
+        bool small(Job const& job) const {
+            return job.data.size() <= options.small_job;
+        }
+
+        /**
+         * Take the claimed job, preferring the front of our own queue and
+         * stealing from the back of the others, along with any small jobs
+         * behind it using the same function code.
+         */
+        void take(std::size_t self, std::vector<Job>& batch) {
+            // the claimed job can move past us as other workers take theirs,
+            // so keep looking until it turns up
+            for (;;) {
+                for (std::size_t i = 0; i < queues.size(); ++i) {
+                    auto& queue = queues[(self + i) % queues.size()];
+                    bool const own = i == 0;
+
+                    std::lock_guard lock{queue.mutex};
+                    auto pop = [&] {
+                        if (own) {
+                            batch.push_back(std::move(queue.jobs.front()));
+                            queue.jobs.pop_front();
+                        } else {
+                            batch.push_back(std::move(queue.jobs.back()));
+                            queue.jobs.pop_back();
+                        }
+                    };
+
+                    if (queue.jobs.empty())
+                        continue;
+
+                    pop();
+                    while (small(batch.front()) && !queue.jobs.empty() &&
+                           batch.size() < options.batch_size) {
+                        auto const& next =
+                            own ? queue.jobs.front() : queue.jobs.back();
+                        if (next.code != batch.front().code || !small(next) ||
+                            !try_claim())
+                            break;
+
+                        pop();
+                    }
+
+                    return;
+                }
+
+                std::this_thread::yield();
+            }
+        }
+
+        static void run(std::vector<Job>& batch) {
+            std::vector<Multihash> results;
+            std::exception_ptr error;
+            try {
+                if (batch.size() == 1) {
+                    results.emplace_back(Span<ByteSpan const>{&batch[0].data, 1},
+                                         batch[0].code);
+                } else {
+                    std::vector<ByteSpan> buffers;
+                    buffers.reserve(batch.size());
+                    for (auto const& job : batch)
+                        buffers.push_back(job.data);
+
+                    results = Multihash::hash_each(buffers, batch[0].code);
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                if (error)
+                    batch[i].fail(error);
+                else
+                    batch[i].complete(results[i]);
+            }
+        }
+
+        void work(std::size_t self) {
+            current_executor = this;
+            current_worker = self;
+
+            std::vector<Job> batch;
+            while (claim()) {
+                take(self, batch);
+                {
+                    std::lock_guard lock{mutex};
+                    queued -= batch.size();
+                }
+                space_cv.notify_all();
+
+                run(batch);
+                batch.clear();
+            }
+        }
+    };
+
+    HashExecutor::HashExecutor()
+        : HashExecutor(Options{}) {}
+
+    HashExecutor::HashExecutor(Options options)
+        : impl(std::make_unique<Impl>(options)) {}
+
+    HashExecutor::~HashExecutor() = default;
+
+    std::future<Multihash>
+    HashExecutor::submit(std::vector<std::uint8_t>&& buffer,
+                         Varint const& protocol) {
+        Job job;
+        job.owned = std::move(buffer);
+        job.data = job.owned;
+        job.code = protocol;
+
+        auto future = job.promise.get_future();
+        impl->push(std::move(job));
+        return future;
+    }
+
+    std::future<Multihash> HashExecutor::submit(ByteSpan buffer,
+                                                Varint const& protocol) {
+        Job job;
+        job.data = buffer;
+        job.code = protocol;
+
+        auto future = job.promise.get_future();
+        impl->push(std::move(job));
+        return future;
+    }
+
+    void HashExecutor::submit(std::vector<std::uint8_t>&& buffer,
+                              Varint const& protocol, Callback callback) {
+        Job job;
+        job.owned = std::move(buffer);
+        job.data = job.owned;
+        job.code = protocol;
+        job.callback = std::move(callback);
+        impl->push(std::move(job));
+    }
+
+    void HashExecutor::submit(ByteSpan buffer, Varint const& protocol,
+                              Callback callback) {
+        Job job;
+        job.data = buffer;
+        job.code = protocol;
+        job.callback = std::move(callback);
+        impl->push(std::move(job));
+    }
+
+    std::size_t HashExecutor::size() const { return impl->threads.size(); }
+} // namespace Multiformats
@@ -0,0 +1,190 @@
+// IPv4 and IPv6 address text forms
+//
+// File Name: ip.cpp
+// Date: 2026-10-18
+
+#include "ip.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+
+namespace {
+    int hex_value(char c) {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+
+        return -1;
+    }
+} // namespace
+
+namespace Multiformats::Ip {
+    bool parse4(std::string_view text, std::uint8_t* out) {
+        std::size_t pos{};
+        for (int part = 0; part < 4; ++part) {
+            if (part != 0) {
+                if (pos == text.size() || text[pos] != '.')
+                    return false;
+
+                ++pos;
+            }
+
+            auto const start = pos;
+            unsigned value{};
+            while (pos < text.size() && pos - start < 3 && text[pos] >= '0' &&
+                   text[pos] <= '9')
+                value = value * 10 + (text[pos++] - '0');
+
+            auto const digits = pos - start;
+            if (digits == 0 || value > 255 || (digits > 1 && text[start] == '0'))
+                return false;
+
+            out[part] = static_cast<std::uint8_t>(value);
+        }
+
+        return pos == text.size();
+    }
+
+    bool parse6(std::string_view text, std::uint8_t* out) {
+        std::array<std::uint16_t, 8> groups{};
+        std::size_t count{};
+        constexpr auto no_gap = std::string_view::npos;
+        std::size_t gap{no_gap};
+        std::size_t pos{};
+
+        if (text.substr(0, 2) == "::") {
+            gap = 0;
+            pos = 2;
+        }
+
+        while (pos < text.size()) {
+            auto const start = pos;
+            unsigned value{};
+            for (int digit; pos < text.size() && pos - start < 4 &&
+                            (digit = hex_value(text[pos])) >= 0;
+                 ++pos)
+                value = value * 16 + digit;
+
+            if (pos == start)
+                return false;
+
+            // a dotted quad takes the last two groups
+            if (pos < text.size() && text[pos] == '.') {
+                std::array<std::uint8_t, 4> ip4;
+                if (count > groups.size() - 2 ||
+                    !parse4(text.substr(start), ip4.data()))
+                    return false;
+
+                groups[count++] = (ip4[0] << 8) | ip4[1];
+                groups[count++] = (ip4[2] << 8) | ip4[3];
+                pos = text.size();
+                break;
+            }
+
+            if (count == groups.size())
+                return false;
+
+            groups[count++] = static_cast<std::uint16_t>(value);
+            if (pos == text.size())
+                break;
+
+            if (text[pos++] != ':' || pos == text.size())
+                return false;
+
+            if (text[pos] == ':') {
+                if (gap != no_gap)
+                    return false;
+
+                gap = count;
+                ++pos;
+            }
+        }
+
+        if (gap == no_gap) {
+            if (count != groups.size())
+                return false;
+        } else {
+            // "::" stands for at least one group of zeros
+            if (count == groups.size())
+                return false;
+
+            auto const shift = groups.size() - count;
+            for (auto i = count; i-- > gap;) {
+                groups[i + shift] = groups[i];
+                groups[i] = 0;
+            }
+        }
+
+        for (auto group : groups) {
+            *out++ = static_cast<std::uint8_t>(group >> 8);
+            *out++ = static_cast<std::uint8_t>(group & 0xff);
+        }
+
+        return true;
+    }
+
+    char* format4(std::uint8_t const* in, char* out) {
+        for (int part = 0; part < 4; ++part) {
+            if (part != 0)
+                *out++ = '.';
+
+            out = std::to_chars(out, out + 3, in[part]).ptr;
+        }
+
+        return out;
+    }
+
+    char* format6(std::uint8_t const* in, char* out) {
+        std::array<std::uint16_t, 8> groups;
+        for (std::size_t i = 0; i < groups.size(); ++i)
+            groups[i] = (in[2 * i] << 8) | in[2 * i + 1];
+
+        bool const mapped = groups[0] == 0 && groups[1] == 0 &&
+                            groups[2] == 0 && groups[3] == 0 &&
+                            groups[4] == 0 && groups[5] == 0xffff;
+        if (mapped) {
+            constexpr std::string_view prefix{"::ffff:"};
+            out = std::copy(prefix.cbegin(), prefix.cend(), out);
+            return format4(in + 12, out);
+        }
+
+        // first longest run of at least two zero groups
+        std::size_t best{groups.size()};
+        std::size_t best_length{1};
+        for (std::size_t i = 0; i < groups.size();) {
+            if (groups[i] != 0) {
+                ++i;
+                continue;
+            }
+
+            auto const start = i;
+            while (i < groups.size() && groups[i] == 0)
+                ++i;
+
+            if (i - start > best_length) {
+                best = start;
+                best_length = i - start;
+            }
+        }
+
+        for (std::size_t i = 0; i < groups.size(); ++i) {
+            if (i == best) {
+                *out++ = ':';
+                *out++ = ':';
+                i += best_length - 1;
+                continue;
+            }
+
+            if (i != 0 && i != best + best_length)
+                *out++ = ':';
+
+            out = std::to_chars(out, out + 4, groups[i], 16).ptr;
+        }
+
+        return out;
+    }
+} // namespace Multiformats::Ip
@@ -0,0 +1,53 @@
+/**
+ * IPv4 and IPv6 address text forms
+ *
+ * @file ip.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats::Ip {
+    /** @brief Longest dotted quad, "255.255.255.255" */
+    constexpr std::size_t max_text4 = 15;
+
+    /** @brief Longest RFC 5952 form, "ffff:...:ffff" or mapped IPv4 */
+    constexpr std::size_t max_text6 = 39;
+
+    /**
+     * @brief Parse a dotted quad into 4 bytes
+     *
+     * Each part is a decimal number up to 255 without leading zeros.
+     *
+     * @return false if text is not an IPv4 address, out is then unspecified
+     */
+    bool parse4(std::string_view text, std::uint8_t* out);
+
+    /**
+     * @brief Parse any RFC 4291 text form into 16 bytes
+     *
+     * Accepts full, "::" compressed and trailing dotted quad forms, hex
+     * digits in either case.
+     *
+     * @return false if text is not an IPv6 address, out is then unspecified
+     */
+    bool parse6(std::string_view text, std::uint8_t* out);
+
+    /** @brief Write 4 bytes as a dotted quad, returns the end of the text */
+    char* format4(std::uint8_t const* in, char* out);
+
+    /**
+     * @brief Write 16 bytes in the RFC 5952 canonical form, returns the end
+     * of the text
+     *
+     * Lower case, no leading zeros, the first longest run of two or more
+     * zero groups compressed to "::", and IPv4-mapped addresses as
+     * "::ffff:" followed by a dotted quad.
+     */
+    char* format6(std::uint8_t const* in, char* out);
+} // namespace Multiformats::Ip
@@ -6,315 +6,733 @@
 
 #include "multiformats/multiaddr.hpp"
 
+#include "multiformats/codec_traits.hpp"
+#include "multiformats/multibase.hpp"
 #include "multiformats/multicodec.hpp"
 #include "multiformats/varint.hpp"
 
-#include <regex>
-#include <sstream>
+#include "ip.hpp"
+#include "multiaddr_protocol.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <cstdint>
+#include <cstring>
+
+#ifdef MULTIFORMATS_HAS_SOCKADDR
+#include <net/if.h>
+#endif
 
 namespace {
     using namespace Multiformats;
 
-    std::uint64_t const ip4{4};
-    std::uint64_t const ip6{41};
+    using Multicodec::Code;
 
-    std::uint64_t const tcp{6};
-    std::uint64_t const udp{273};
-    std::uint64_t const dccp{33};
-    std::uint64_t const sctp{132};
+    /** @brief Make room for size more bytes at the end of out */
+    std::uint8_t* grow(std::vector<std::uint8_t>& out, std::size_t size) {
+        out.resize(out.size() + size);
+        return out.data() + out.size() - size;
+    }
 
-    struct ProtocolInfo {
-        Varint code;
-        int byte_length;
-    };
+    void append_varint(std::uint64_t value, std::vector<std::uint8_t>& out) {
+        std::array<std::uint8_t, varint_max_size> buf;
+        out.insert(out.end(), buf.data(),
+                   buf.data() + encode_varint(value, buf.data()));
+    }
 
-    std::vector<ProtocolInfo> const protocol_info{
-        {4, 4},    {6, 2},    {273, 2},  {33, 2},   {41, 16},  {42, -1},
-        {53, -1},  {54, -1},  {55, -1},  {56, -1},  {132, 2},  {301, 0},
-        {302, 0},  {400, -1}, {421, -1}, {421, -1}, {444, 12}, {445, 37},
-        {446, -1}, {447, -1}, {460, 0},  {480, 0},  {443, 0},  {477, 0},
-        {478, 0},  {479, 0},  {277, 0},  {275, 0},  {276, 0},  {290, 0},
-        {777, -1},
-    };
+    bool ip4_to_binary(std::string_view text, std::vector<std::uint8_t>& out) {
+        return Ip::parse4(text, grow(out, 4));
+    }
 
-    template <typename Iterator>
-    std::vector<std::uint8_t> ip4_to_binary(Iterator begin, Iterator end) {
-        std::regex const pattern{"^(?:[0-9]{1,3}\\.){3}[0-9]{1,3}$"};
-        if (!std::regex_match(begin, end, pattern))
-            throw std::invalid_argument("invalid ip4 address");
+    bool ip6_to_binary(std::string_view text, std::vector<std::uint8_t>& out) {
+        return Ip::parse6(text, grow(out, 16));
+    }
 
-        std::vector<std::uint8_t> ret;
+    bool port_to_binary(std::string_view text,
+                        std::vector<std::uint8_t>& out) {
+        std::uint16_t port{};
+        auto const end = text.data() + text.size();
+        auto const [ptr, error] = std::from_chars(text.data(), end, port);
+        if (error != std::errc{} || ptr != end)
+            return false;
+
+        auto* const value = grow(out, 2);
+        value[0] = static_cast<std::uint8_t>(port >> 8);
+        value[1] = static_cast<std::uint8_t>(port & 0xff);
+        return true;
+    }
 
-        for (auto it = begin; it != end;) {
-            auto period = std::find(it, end, '.');
-            std::string tmp{it, period};
-            ret.push_back(std::strtoul(tmp.c_str(), nullptr, 10));
+    /** @brief Store the text itself, length prefixed if Size is variable */
+    template <int Size>
+    bool text_to_binary(std::string_view text,
+                        std::vector<std::uint8_t>& out) {
+        if constexpr (Size == Multicodec::variable_size)
+            append_varint(text.size(), out);
+        else if (text.size() != Size)
+            return false;
+
+        out.insert(out.end(), text.cbegin(), text.cend());
+        return true;
+    }
 
-            if (period == end)
-                it = end;
-            else
-                it = std::next(period);
+    /**
+     * @brief Store a peer ID as its binary multihash
+     *
+     * The text is either the multihash in base58btc, as in "Qm..." or
+     * "12D3KooW...", or a CIDv1 of a libp2p-key in any multibase.
+     */
+    bool p2p_to_binary(std::string_view text, std::vector<std::uint8_t>& out) {
+        std::vector<std::uint8_t> decoded;
+        try {
+            // a base58btc multihash, which has no multibase prefix
+            auto const legacy = text.substr(0, 2) == "Qm" ||
+                                text.substr(0, 1) == "1";
+            decoded =
+                Multibase::decode((legacy ? "z" : "") + std::string{text});
+        } catch (std::runtime_error const&) {
+            return false;
         }
 
-        return ret;
+        auto const* begin = decoded.data();
+        auto const* const end = begin + decoded.size();
+        if (!decoded.empty() && decoded[0] == 1) {
+            std::uint64_t codec{};
+            auto const used = decode_varint(begin + 1, end, codec);
+            if (used == 0 || codec != static_cast<std::uint64_t>(
+                                          Code::libp2p_key))
+                return false;
+
+            begin += 1 + used;
+        }
+
+        // whole multihash, however the key was hashed
+        std::uint64_t function{};
+        std::uint64_t size{};
+        auto const function_size = decode_varint(begin, end, function);
+        auto const size_size =
+            function_size == 0
+                ? 0
+                : decode_varint(begin + function_size, end, size);
+        if (size_size == 0 ||
+            size != static_cast<std::size_t>(end - begin) - function_size -
+                        size_size)
+            return false;
+
+        append_varint(end - begin, out);
+        out.insert(out.end(), begin, end);
+        return true;
     }
 
-    template <typename Iterator>
-    std::vector<std::uint8_t> ip6_to_binary(Iterator begin, Iterator end) {
-        std::regex const pattern{"^(?:[A-Fa-f0-9]{1,4}:){7}[A-Fa-f0-9]{1,4}$"};
-        if (!std::regex_match(begin, end, pattern))
-            throw std::invalid_argument("invalid ip4 address");
+    /** @brief Write a peer ID in base58btc, its canonical text form */
+    std::string p2p_to_string(ByteSpan value) {
+        return Multibase::encode(Multibase::Protocol::Base58Btc,
+                                 {value.begin(), value.end()})
+            .substr(1);
+    }
 
-        std::vector<std::uint8_t> ret;
+    std::string ip4_to_string(ByteSpan value) {
+        std::array<char, Ip::max_text4> text;
+        return {text.data(), Ip::format4(value.data(), text.data())};
+    }
+
+    std::string ip6_to_string(ByteSpan value) {
+        std::array<char, Ip::max_text6> text;
+        return {text.data(), Ip::format6(value.data(), text.data())};
+    }
 
-        for (auto it = begin; it != end;) {
-            auto colon = std::find(it, end, ':');
+    std::string port_to_string(ByteSpan value) {
+        return std::to_string((value[0] << 8) | value[1]);
+    }
 
-            std::string tmp{it, colon};
-            std::uint16_t value = std::strtoul(tmp.c_str(), nullptr, 16);
+    std::string text_to_string(ByteSpan value) {
+        return {value.begin(), value.end()};
+    }
 
-            ret.push_back(value >> 8);
-            ret.push_back(value & 0xff);
+    struct ProtocolInfo {
+        using Parser = bool (*)(std::string_view, std::vector<std::uint8_t>&);
+        using Formatter = std::string (*)(ByteSpan);
 
-            if (colon == end)
-                it = end;
-            else
-                it = std::next(colon);
-        }
+        std::uint64_t code;
+        std::string_view name;
 
-        return ret;
+        /** @brief See Multicodec::value_size() */
+        int value_size;
+
+        /** @brief Append the binary value parsed from text, returning false
+         * if the text is not a valid value; null if the protocol takes no
+         * value */
+        Parser parse;
+
+        /** @brief Format a binary value, null if the protocol takes no
+         * value */
+        Formatter format;
+
+        /** @brief Value is a path, taking the rest of the address */
+        bool path;
+    };
+
+    // the table is built at compile time, so a throw in these fails the
+    // build
+
+    /** @brief A protocol that takes no value */
+    constexpr ProtocolInfo protocol(Code code) {
+        auto const value = static_cast<std::uint64_t>(code);
+        if (*Multicodec::value_size(code) != 0)
+            throw std::logic_error("protocol needs a parser and formatter");
+
+        return {value, Multicodec::name(value), 0, nullptr, nullptr, false};
     }
 
-    template <typename Iterator>
-    std::vector<std::uint8_t> port_to_binary(Iterator begin, Iterator end) {
-        std::string tmp{begin, end};
-        std::uint16_t port{
-            static_cast<std::uint16_t>(std::strtoul(tmp.c_str(), nullptr, 10))};
-        return {static_cast<std::uint8_t>(port >> 8),
-                static_cast<std::uint8_t>(port & 0xff)};
+    /** @brief A protocol with a value */
+    constexpr ProtocolInfo protocol(Code code, ProtocolInfo::Parser parse,
+                                    ProtocolInfo::Formatter format,
+                                    bool path = false) {
+        auto const value = static_cast<std::uint64_t>(code);
+        if (*Multicodec::value_size(code) == 0)
+            throw std::logic_error("protocol takes no value");
+
+        return {value, Multicodec::name(value), *Multicodec::value_size(code),
+                parse, format, path};
     }
 
-    std::string ip4_to_string(std::vector<std::uint8_t> const& buf) {
-        std::string ret;
-        for (auto it = buf.cbegin(); it != buf.cend(); ++it) {
-            ret += std::to_string(*it);
-            if (it != std::prev(buf.cend()))
-                ret += '.';
+    constexpr auto variable = Multicodec::variable_size;
+
+    constexpr ProtocolInfo protocols[]{
+        protocol(Code::ip4, ip4_to_binary, ip4_to_string),
+        protocol(Code::tcp, port_to_binary, port_to_string),
+        protocol(Code::dccp, port_to_binary, port_to_string),
+        protocol(Code::ip6, ip6_to_binary, ip6_to_string),
+        protocol(Code::ip6zone, text_to_binary<variable>, text_to_string),
+        protocol(Code::dns, text_to_binary<variable>, text_to_string),
+        protocol(Code::dns4, text_to_binary<variable>, text_to_string),
+        protocol(Code::dns6, text_to_binary<variable>, text_to_string),
+        protocol(Code::dnsaddr, text_to_binary<variable>, text_to_string),
+        protocol(Code::sctp, port_to_binary, port_to_string),
+        protocol(Code::udp, port_to_binary, port_to_string),
+        protocol(Code::p2p_webrtc_star),
+        protocol(Code::p2p_webrtc_direct),
+        protocol(Code::p2p_stardust),
+        protocol(Code::p2p_circuit),
+        protocol(Code::udt),
+        protocol(Code::utp),
+        protocol(Code::unix_, text_to_binary<variable>, text_to_string, true),
+        protocol(Code::p2p, p2p_to_binary, p2p_to_string),
+        protocol(Code::https),
+        protocol(Code::onion, text_to_binary<12>, text_to_string),
+        protocol(Code::onion3, text_to_binary<37>, text_to_string),
+        protocol(Code::garlic64, text_to_binary<variable>, text_to_string),
+        protocol(Code::garlic32, text_to_binary<variable>, text_to_string),
+        protocol(Code::quic),
+        protocol(Code::ws),
+        protocol(Code::wss),
+        protocol(Code::p2p_websocket_star),
+        protocol(Code::http),
+    };
+
+    constexpr std::size_t protocol_count = std::size(protocols);
+
+    /** @brief Codes below this are looked up directly */
+    constexpr std::size_t direct_codes = 0x200;
+
+    /** @brief Index + 1 into protocols by code, 0 if not supported */
+    constexpr auto direct = [] {
+        std::array<std::uint8_t, direct_codes> ret{};
+        for (std::size_t i = 0; i < protocol_count; ++i)
+            if (protocols[i].code < direct_codes)
+                ret[protocols[i].code] = static_cast<std::uint8_t>(i + 1);
+
+        return ret;
+    }();
+
+    constexpr std::size_t large_count = [] {
+        std::size_t ret{};
+        for (auto const& info : protocols)
+            if (info.code >= direct_codes)
+                ++ret;
+
+        return ret;
+    }();
+
+    /** @brief Indices into protocols of larger codes, ordered by code */
+    constexpr auto large = [] {
+        std::array<std::uint8_t, large_count> ret{};
+        std::size_t count{};
+        for (std::size_t i = 0; i < protocol_count; ++i) {
+            if (protocols[i].code < direct_codes)
+                continue;
+
+            auto j = count++;
+            for (; j > 0 && protocols[ret[j - 1]].code > protocols[i].code; --j)
+                ret[j] = ret[j - 1];
+
+            ret[j] = static_cast<std::uint8_t>(i);
         }
 
         return ret;
+    }();
+
+    /** @brief Get the protocol for code, nullptr if it isn't supported */
+    ProtocolInfo const* find_protocol(std::uint64_t code) {
+        if (code < direct_codes) {
+            auto const index = direct[code];
+            return index == 0 ? nullptr : &protocols[index - 1];
+        }
+
+        auto const it =
+            std::lower_bound(large.cbegin(), large.cend(), code,
+                             [](std::uint8_t index, std::uint64_t code) {
+                                 return protocols[index].code < code;
+                             });
+
+        return it != large.cend() && protocols[*it].code == code
+                   ? &protocols[*it]
+                   : nullptr;
     }
 
-    std::string ip6_to_string(std::vector<std::uint8_t> const& buf) {
-        std::stringstream ss;
-        ss << std::hex;
-        for (auto it = buf.cbegin(); it != buf.cend(); it += 2) {
-            int value = (*it << 8) | *std::next(it);
-            ss << value;
-            if (it != std::prev(buf.cend(), 2))
-                ss << ':';
+    /**
+     * @brief Decode the component starting at pos
+     *
+     * @return pointer past the component
+     * @throw std::invalid_argument if the component is truncated
+     * @throw std::runtime_error if the protocol is not supported
+     */
+    std::uint8_t const* decode_component(std::uint8_t const* pos,
+                                         std::uint8_t const* end,
+                                         Multiaddr::Component& out) {
+        std::uint64_t code{};
+        auto used = decode_varint(pos, end, code);
+        if (used == 0)
+            throw std::invalid_argument("truncated multiaddr");
+
+        pos += used;
+        auto const* const info = find_protocol(code);
+        if (info == nullptr)
+            throw std::runtime_error("unsupported protocol");
+
+        std::uint64_t size = info->value_size;
+        if (info->value_size == variable) {
+            used = decode_varint(pos, end, size);
+            if (used == 0)
+                throw std::invalid_argument("truncated multiaddr");
+
+            pos += used;
         }
 
-        return ss.str();
-    }
-
-    std::string port_to_string(std::vector<std::uint8_t> const& buf) {
-        if (buf.size() != 2)
-            throw std::invalid_argument("buffer is incorrect size");
-
-        int value = (buf[0] << 8) | buf[1];
-        return std::to_string(value);
-    }
-
-    template <typename Iterator>
-    std::vector<std::uint8_t> to_binary(Varint const& code, Iterator begin,
-                                        Iterator end) {
-        std::uint64_t value = code;
-        switch (value) {
-        case ip4:
-            return ip4_to_binary(begin, end);
-        case ip6:
-            return ip6_to_binary(begin, end);
-        case tcp:
-            [[fallthrough]];
-        case udp:
-            [[fallthrough]];
-        case dccp:
-            [[fallthrough]];
-        case sctp:
-            return port_to_binary(begin, end);
+        if (size > static_cast<std::uint64_t>(end - pos))
+            throw std::invalid_argument("truncated multiaddr");
+
+        out = {code, {pos, static_cast<std::size_t>(size)}};
+        return pos + size;
+    }
+
+    /**
+     * @brief Append the binary form of a multiaddr's text to out
+     *
+     * Calls on_component with the offset in out of each component as it
+     * starts. On error out is left holding part of the address.
+     */
+    template <typename OnComponent>
+    MultiaddrError parse_text(std::string_view text,
+                              std::vector<std::uint8_t>& out,
+                              OnComponent&& on_component) {
+        if (text.empty() || text[0] != '/')
+            return MultiaddrError::Syntax;
+
+        auto const start = out.size();
+        for (std::size_t begin = 0, end; begin != text.size(); begin = end) {
+            end = std::min(text.find('/', begin + 1), text.size());
+            auto const code =
+                Multicodec::find(text.substr(begin + 1, end - begin - 1));
+            if (!code)
+                return MultiaddrError::UnknownProtocol;
+
+            auto const* const info = find_protocol(*code);
+            if (info == nullptr)
+                return MultiaddrError::UnsupportedProtocol;
+
+            on_component(out.size() - start);
+            append_varint(*code, out);
+
+            if (info->parse != nullptr) {
+                begin = end;
+                if (begin == text.size())
+                    return MultiaddrError::MissingValue;
+
+                end = info->path
+                          ? text.size()
+                          : std::min(text.find('/', begin + 1), text.size());
+
+                if (!info->parse(text.substr(begin + 1, end - begin - 1), out))
+                    return MultiaddrError::InvalidValue;
+            }
         }
 
-        // default is to assume string stored in buf
-        return {begin, end};
-    }
-
-    std::string to_string(Varint const& code,
-                          std::vector<std::uint8_t> const& buf) {
-        std::uint64_t value = code;
-        switch (value) {
-        case ip4:
-            return ip4_to_string(buf);
-        case ip6:
-            return ip6_to_string(buf);
-        case tcp:
-            [[fallthrough]];
-        case udp:
-            [[fallthrough]];
-        case dccp:
-            [[fallthrough]];
-        case sctp:
-            return port_to_string(buf);
+        if (out.size() - start > Multiaddr::max_size)
+            return MultiaddrError::TooLong;
+
+        return MultiaddrError::None;
+    }
+
+#ifdef MULTIFORMATS_HAS_SOCKADDR
+    bool takes_port(std::uint64_t code) {
+        switch (static_cast<Code>(code)) {
+        case Code::tcp:
+        case Code::udp:
+        case Code::dccp:
+        case Code::sctp:
+            return true;
+        default:
+            return false;
         }
+    }
 
-        // default is to assume buf is a string
-        return {buf.cbegin(), buf.cend()};
+    /** @brief Interface index of a zone given by number or by name */
+    std::uint32_t zone_index(ByteSpan zone) {
+        auto const* const text = reinterpret_cast<char const*>(zone.data());
+        std::uint32_t index{};
+        auto const [ptr, error] =
+            std::from_chars(text, text + zone.size(), index);
+        if (error == std::errc{} && ptr == text + zone.size())
+            return index;
+
+        // names are at most IF_NAMESIZE - 1 characters, and a NUL would
+        // cut the name short, possibly to another interface's
+        std::array<char, IF_NAMESIZE> name{};
+        if (zone.size() >= name.size() ||
+            std::find(zone.begin(), zone.end(), 0) != zone.end())
+            throw std::invalid_argument("unknown ip6 zone");
+
+        std::copy(zone.begin(), zone.end(), name.begin());
+
+        // replaces any digits from_chars stored from the start of a name
+        index = if_nametoindex(name.data());
+        if (index == 0)
+            throw std::invalid_argument("unknown ip6 zone");
+
+        return index;
     }
+#endif
 } // namespace
 
 namespace Multiformats {
+    std::string Multiaddr::Component::to_string() const {
+        auto const* const info = find_protocol(code);
+        if (info == nullptr)
+            throw std::runtime_error("unsupported protocol");
+
+        return info->format == nullptr ? std::string{} : info->format(value);
+    }
+
+    Multiaddr::ConstIterator::ConstIterator(std::uint8_t const* begin,
+                                            std::uint8_t const* end)
+        : pos(begin)
+        , last(end) {
+        decode();
+    }
+
+    void Multiaddr::ConstIterator::decode() {
+        if (pos != last)
+            next = decode_component(pos, last, current);
+    }
+
+    char const* to_string(MultiaddrError error) {
+        switch (error) {
+        case MultiaddrError::None:
+            return "no error";
+        case MultiaddrError::Syntax:
+            return "invalid multiaddr";
+        case MultiaddrError::UnknownProtocol:
+            return "unknown multicodec";
+        case MultiaddrError::UnsupportedProtocol:
+            return "unsupported multiaddr protocol";
+        case MultiaddrError::MissingValue:
+            return "missing multiaddr value";
+        case MultiaddrError::InvalidValue:
+            return "invalid multiaddr value";
+        case MultiaddrError::TooLong:
+            return "multiaddr is too long";
+        }
+
+        return "unknown multiaddr error";
+    }
+
     Multiaddr::Multiaddr(std::string const& address) {
-        if (address.empty() || address[0] != '/')
-            throw std::invalid_argument("invalid multiaddr");
+        // most addresses are no longer in binary than as text, a few such
+        // as /ip6/:: grow past this and reallocate
+        bytes.reserve(address.size());
+
+        auto const error = parse_text(address, bytes, [this](std::size_t pos) {
+            push_offset(pos);
+        });
+        if (error == MultiaddrError::UnknownProtocol)
+            throw std::out_of_range(Multiformats::to_string(error));
+        if (error != MultiaddrError::None)
+            throw std::invalid_argument(Multiformats::to_string(error));
+    }
 
-        auto begin = address.cbegin();
+    Multiaddr::Multiaddr(std::vector<std::uint8_t> const& raw)
+        : Multiaddr(MultiaddrView{raw}) {}
 
-        for (auto end = begin; begin != address.cend(); begin = end) {
-            end = std::find(std::next(begin), address.cend(), '/');
-            std::string protocol_str{std::next(begin), end};
-            Protocol protocol{Multicodec::table.at(protocol_str)};
+    Multiaddr::Multiaddr(MultiaddrView view)
+        : bytes(view.to_binary().begin(), view.to_binary().end()) {
+        if (bytes.size() > max_size)
+            throw std::invalid_argument("multiaddr is too long");
 
-            auto info_it = std::find_if(
-                protocol_info.cbegin(), protocol_info.cend(),
-                [&](auto const& info) { return info.code == protocol.code; });
+        auto const* const begin = bytes.data();
+        auto const* const end = begin + bytes.size();
 
-            if (info_it == protocol_info.cend())
-                throw std::invalid_argument("unsupported multiaddr protocol");
+        Component component;
+        for (auto const* pos = begin; pos != end;
+             pos = decode_component(pos, end, component))
+            push_offset(pos - begin);
+    }
 
-            // try to get value for protocol
-            if (info_it->byte_length != 0) {
-                begin = end;
-                if (protocol_str == "unix")
-                    end = address.cend();
-                else
-                    end = std::find(std::next(begin), address.cend(), '/');
+    void Multiaddr::push_offset(std::size_t offset) {
+        if (offset > max_size)
+            throw std::invalid_argument("multiaddr is too long");
 
-                protocol.value =
-                    ::to_binary(protocol.code, std::next(begin), end);
-                if (info_it->byte_length >= 0 &&
-                    protocol.value.size() != info_it->byte_length)
-                    throw std::runtime_error("incorrect buffer size");
-            }
+        if (count < inline_components)
+            offsets[count] = static_cast<std::uint16_t>(offset);
 
-            addr.push_back(protocol);
-        }
+        ++count;
     }
 
-    Multiaddr::Multiaddr(std::vector<std::uint8_t> const& raw) {
-        auto it = raw.cbegin();
-        while (it != raw.cend()) {
-            auto [code, next] = make_varint(it, raw.cend());
-            Protocol protocol{code};
-            auto info_it =
-                std::find_if(protocol_info.cbegin(), protocol_info.cend(),
-                             [code = code](auto const& protocol) {
-                                 return code == protocol.code;
-                             });
-            if (info_it == protocol_info.cend())
-                throw std::runtime_error("unsupported protocol");
-
-            std::size_t size;
-            if (info_it->byte_length < 0) {
-                auto [varint, value_it] = make_varint(next, raw.cend());
-                it = value_it;
-                size = varint;
-            } else {
-                it = next;
-                size = info_it->byte_length;
-            }
+    std::size_t Multiaddr::offset(std::size_t index) const {
+        if (index < inline_components)
+            return offsets[index];
 
-            std::copy_n(it, size, std::back_inserter(protocol.value));
-            it += size;
+        // past the inline table, walk on from its last entry
+        auto const* const begin = bytes.data();
+        auto const* const end = begin + bytes.size();
+        auto const* pos = begin + offsets.back();
 
-            addr.push_back(protocol);
-        }
+        Component component;
+        for (auto i = inline_components - 1; i < index; ++i)
+            pos = decode_component(pos, end, component);
+
+        return pos - begin;
     }
 
-    std::string Multiaddr::Protocol::to_string() const {
-        return ::to_string(code, value);
+    Multiaddr Multiaddr::slice(std::size_t first, std::size_t last) const {
+        auto const end_offset = [this](std::size_t index) {
+            return index == count ? bytes.size() : offset(index);
+        };
+
+        auto const begin = end_offset(first);
+        auto const end = end_offset(last);
+
+        Multiaddr ret;
+        ret.bytes.assign(bytes.data() + begin, bytes.data() + end);
+        ret.count = static_cast<std::uint16_t>(last - first);
+        for (std::size_t i = 0; i < ret.count && i < inline_components; ++i)
+            ret.offsets[i] =
+                static_cast<std::uint16_t>(offset(first + i) - begin);
+
+        return ret;
     }
 
-    std::string Multiaddr::to_string() const {
-        std::string ret;
-        for (auto const& address : addr) {
-            auto it = std::find_if(
-                Multicodec::table.cbegin(), Multicodec::table.cend(),
-                [&](auto const& elem) { return address.code == elem.second; });
+    std::string Multiaddr::to_string() const { return view().to_string(); }
 
-            if (it == Multicodec::table.cend())
-                throw std::runtime_error(
-                    "unsupported protocol within multiaddr");
+    Multiaddr Multiaddr::encapsulate(Multiaddr const& other) const {
+        if (bytes.size() + other.bytes.size() > max_size)
+            throw std::invalid_argument("multiaddr is too long");
 
-            auto info_it = std::find_if(
-                protocol_info.cbegin(), protocol_info.cend(),
-                [&](auto const& info) { return address.code == info.code; });
+        Multiaddr ret;
+        ret.bytes.reserve(bytes.size() + other.bytes.size());
+        ret.bytes.assign(bytes.cbegin(), bytes.cend());
+        ret.bytes.insert(ret.bytes.end(), other.bytes.cbegin(),
+                         other.bytes.cend());
 
-            if (info_it == protocol_info.cend())
-                throw std::runtime_error(
-                    "unsupported protocol within multiaddr");
+        ret.count = count + other.count;
+        for (std::size_t i = 0; i < ret.count && i < inline_components; ++i)
+            ret.offsets[i] =
+                i < count ? offsets[i]
+                          : static_cast<std::uint16_t>(
+                                other.offsets[i - count] + bytes.size());
 
-            ret += '/';
-            ret += it->first;
+        return ret;
+    }
 
-            if (info_it->byte_length != 0) {
-                ret += '/';
-                ret += address.to_string();
+    Multiaddr Multiaddr::decapsulate(Code code) const {
+        std::size_t index{}, last{count};
+        for (auto const& component : *this) {
+            if (Code{component.code} == code)
+                last = index;
+
+            ++index;
+        }
+
+        return slice(0, last);
+    }
+
+    bool Multiaddr::starts_with(Multiaddr const& prefix) const {
+        // both are valid, so a byte prefix ends on a component boundary
+        return prefix.bytes.size() <= bytes.size() &&
+               std::equal(prefix.bytes.cbegin(), prefix.bytes.cend(),
+                          bytes.cbegin());
+    }
+
+    std::pair<Multiaddr, Multiaddr>
+    Multiaddr::split_at(std::size_t index) const {
+        if (index > count)
+            throw std::out_of_range("split index past end of multiaddr");
+
+        return {slice(0, index), slice(index, count)};
+    }
+
+#ifdef MULTIFORMATS_HAS_SOCKADDR
+    Multiaddr Multiaddr::from_sockaddr(sockaddr const& address,
+                                       Code transport) {
+        if (!takes_port(static_cast<std::uint64_t>(transport)))
+            throw std::invalid_argument("transport does not take a port");
+
+        Multiaddr ret;
+        auto& bytes = ret.bytes;
+
+        // longest is a named zone, ip6 and a two byte transport code
+        bytes.reserve(3 + IF_NAMESIZE + 17 + 4);
+
+        auto const append = [&](Code code, void const* value,
+                                std::size_t size) {
+            ret.push_offset(bytes.size());
+            append_varint(static_cast<std::uint64_t>(code), bytes);
+            auto const* const begin = static_cast<std::uint8_t const*>(value);
+            bytes.insert(bytes.end(), begin, begin + size);
+        };
+
+        // ports are in network byte order, as in the binary form
+        switch (address.sa_family) {
+        case AF_INET: {
+            auto const& in = reinterpret_cast<sockaddr_in const&>(address);
+            append(Code::ip4, &in.sin_addr, 4);
+            append(transport, &in.sin_port, 2);
+            break;
+        }
+        case AF_INET6: {
+            auto const& in6 = reinterpret_cast<sockaddr_in6 const&>(address);
+            if (in6.sin6_scope_id != 0) {
+                std::array<char, IF_NAMESIZE> name;
+                auto* end = name.data();
+                if (if_indextoname(in6.sin6_scope_id, name.data()) != nullptr)
+                    end += std::strlen(name.data());
+                else
+                    end = std::to_chars(name.data(), name.data() + name.size(),
+                                        in6.sin6_scope_id)
+                              .ptr;
+
+                ret.push_offset(bytes.size());
+                append_varint(static_cast<std::uint64_t>(Code::ip6zone),
+                              bytes);
+                append_varint(end - name.data(), bytes);
+                bytes.insert(bytes.end(), name.data(), end);
             }
+
+            append(Code::ip6, &in6.sin6_addr, 16);
+            append(transport, &in6.sin6_port, 2);
+            break;
+        }
+        default:
+            throw std::invalid_argument("address is not AF_INET or AF_INET6");
         }
 
         return ret;
     }
 
-    std::vector<std::uint8_t> Multiaddr::to_binary() const {
-        std::vector<std::uint8_t> ret;
-        for (auto const& address : addr) {
-            auto it = std::find_if(protocol_info.cbegin(), protocol_info.cend(),
-                                   [&](auto const& protocol) {
-                                       return address.code == protocol.code;
-                                   });
+    socklen_t Multiaddr::to_sockaddr(sockaddr_storage& out) const {
+        auto it = begin();
+        auto const last = end();
+
+        std::uint32_t scope{};
+        if (it != last && Code{it->code} == Code::ip6zone) {
+            scope = zone_index(it->value);
+            if (++it == last || Code{it->code} != Code::ip6)
+                throw std::invalid_argument("ip6zone must be followed by ip6");
+        }
+
+        if (it == last)
+            throw std::invalid_argument("expected an ip address");
+
+        auto const ip = *it;
+        if (++it == last || !takes_port(it->code))
+            throw std::invalid_argument("expected a port after ip address");
+
+        auto const port = it->value;
+        switch (static_cast<Code>(ip.code)) {
+        case Code::ip4: {
+            sockaddr_in in{};
+            in.sin_family = AF_INET;
+            std::memcpy(&in.sin_addr, ip.value.data(), 4);
+            std::memcpy(&in.sin_port, port.data(), 2);
+            std::memcpy(&out, &in, sizeof(in));
+            return sizeof(in);
+        }
+        case Code::ip6: {
+            sockaddr_in6 in6{};
+            in6.sin6_family = AF_INET6;
+            in6.sin6_scope_id = scope;
+            std::memcpy(&in6.sin6_addr, ip.value.data(), 16);
+            std::memcpy(&in6.sin6_port, port.data(), 2);
+            std::memcpy(&out, &in6, sizeof(in6));
+            return sizeof(in6);
+        }
+        default:
+            throw std::invalid_argument("expected an ip address");
+        }
+    }
+#endif
+
+    Multiaddr::ConstIterator Multiaddr::begin() const {
+        return {bytes.data(), bytes.data() + bytes.size()};
+    }
 
-            if (it == protocol_info.cend())
-                throw std::runtime_error(
-                    "unsupported protocol within multiaddr");
+    Multiaddr::ConstIterator Multiaddr::end() const {
+        auto const* const end = bytes.data() + bytes.size();
+        return {end, end};
+    }
 
-            std::copy(address.code.begin(), address.code.end(),
-                      std::back_inserter(ret));
+    Multiaddr::Component Multiaddr::front() const { return *begin(); }
 
-            if (it->byte_length != 0) {
-                if (it->byte_length < 0) {
-                    Varint len{address.value.size()};
-                    std::copy(len.begin(), len.end(), std::back_inserter(ret));
-                }
+    std::string MultiaddrView::to_string() const {
+        std::string ret;
+        for (auto const& component : *this) {
+            auto const* const info = find_protocol(component.code);
+            ret += '/';
+            ret += info->name;
 
-                std::copy(address.value.cbegin(), address.value.cend(),
-                          std::back_inserter(ret));
+            if (info->format != nullptr) {
+                ret += '/';
+                ret += info->format(component.value);
             }
         }
 
         return ret;
     }
 
-    std::size_t Multiaddr::size() const { return addr.size(); }
+    Multiaddr::Component Multiaddr::back() const {
+        auto const* const data = bytes.data();
+        return *ConstIterator{data + offset(count - 1), data + bytes.size()};
+    }
 
-    Multiaddr::ConstIterator Multiaddr::begin() const { return addr.cbegin(); }
+    MultiaddrError
+    MultiaddrProtocol::to_binary(std::string_view text,
+                                 std::vector<std::uint8_t>& out) {
+        return parse_text(text, out, [](std::size_t) {});
+    }
 
-    Multiaddr::ConstIterator Multiaddr::end() const { return addr.cend(); }
+    MultiaddrProtocol::Value MultiaddrProtocol::value(std::uint64_t code) {
+        auto const* const info = find_protocol(code);
+        if (info == nullptr)
+            throw std::invalid_argument("unsupported multiaddr protocol");
 
-    Multiaddr::ConstReference Multiaddr::front() const { return addr.front(); }
+        if (info->parse == nullptr)
+            return Value::None;
 
-    Multiaddr::ConstReference Multiaddr::back() const { return addr.back(); }
-}; // namespace Multiformats
+        return info->path ? Value::Path : Value::Part;
+    }
+} // namespace Multiformats
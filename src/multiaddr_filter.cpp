@@ -0,0 +1,314 @@
+// Allow and deny lists of IP prefixes for Multiaddrs
+//
+// File Name: multiaddr_filter.cpp
+// Date: 2026-10-18
+
+#include "multiformats/multiaddr_filter.hpp"
+
+#include "multiformats/multicodec_table.hpp"
+
+#include "ip.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats {
+    namespace {
+        using Multicodec::Code;
+
+        constexpr std::size_t key_bits = 128;
+
+        // IPv4 addresses are keyed as ::ffff:a.b.c.d
+        constexpr std::size_t ip4_offset = 96;
+
+        int countl_zero(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+            return value == 0 ? 64 : __builtin_clzll(value);
+#else
+            int ret{};
+            for (std::uint64_t bit = std::uint64_t{1} << 63;
+                 bit != 0 && (value & bit) == 0; bit >>= 1)
+                ++ret;
+
+            return ret;
+#endif
+        }
+
+        std::uint64_t load64(std::uint8_t const* bytes) {
+            std::uint64_t ret{};
+            for (int i = 0; i < 8; ++i)
+                ret = ret << 8 | bytes[i];
+
+            return ret;
+        }
+
+        template <typename Key>
+        Key make_key(std::array<std::uint8_t, 16> const& bytes) {
+            return {load64(bytes.data()), load64(bytes.data() + 8)};
+        }
+
+        template <typename Key>
+        Key make_ip4_key(std::uint8_t const* ip4) {
+            return {0, 0xffff00000000 | std::uint64_t{ip4[0]} << 24 |
+                           std::uint64_t{ip4[1]} << 16 |
+                           std::uint64_t{ip4[2]} << 8 | ip4[3]};
+        }
+
+        /** @brief Bit at index, counting from the most significant */
+        template <typename Key>
+        unsigned bit(Key const& key, std::size_t index) {
+            return index < 64 ? (key.high >> (63 - index)) & 1
+                              : (key.low >> (127 - index)) & 1;
+        }
+
+        /** @brief Clear every bit from index length on */
+        template <typename Key>
+        Key truncate(Key key, std::size_t length) {
+            if (length == 0)
+                return {};
+            if (length < 64)
+                return {key.high & ~(~std::uint64_t{} >> length), 0};
+            if (length < 128)
+                key.low &= ~(~std::uint64_t{} >> (length - 64));
+
+            return key;
+        }
+
+        /** @brief The 16 bits of key from index start on */
+        template <typename Key>
+        std::uint32_t index_bits_of(Key const& key, std::size_t start) {
+            return start < 64 ? (key.high >> (48 - start)) & 0xffff
+                              : (key.low >> (112 - start)) & 0xffff;
+        }
+
+        /** @brief Number of leading bits the keys share */
+        template <typename Key>
+        std::size_t common_length(Key const& lhs, Key const& rhs) {
+            if (auto const diff = lhs.high ^ rhs.high)
+                return countl_zero(diff);
+
+            return 64 + countl_zero(lhs.low ^ rhs.low);
+        }
+    } // namespace
+
+    void MultiaddrFilter::add(std::string_view cidr, Action action) {
+        auto const slash = cidr.find('/');
+        if (slash == std::string_view::npos)
+            throw std::invalid_argument("missing prefix length");
+
+        auto const address = cidr.substr(0, slash);
+        auto const length_text = cidr.substr(slash + 1);
+
+        std::size_t length{};
+        auto const end = length_text.data() + length_text.size();
+        auto const [ptr, error] =
+            std::from_chars(length_text.data(), end, length);
+        if (error != std::errc{} || ptr != end || length_text.empty())
+            throw std::invalid_argument("invalid prefix length");
+
+        std::array<std::uint8_t, 16> bytes;
+        if (Ip::parse4(address, bytes.data())) {
+            if (length > 32)
+                throw std::invalid_argument("invalid prefix length");
+
+            add(make_ip4_key<Key>(bytes.data()), ip4_offset + length, action);
+        } else if (Ip::parse6(address, bytes.data())) {
+            if (length > key_bits)
+                throw std::invalid_argument("invalid prefix length");
+
+            add(make_key<Key>(bytes), length, action);
+        } else {
+            throw std::invalid_argument("invalid prefix address");
+        }
+    }
+
+    void MultiaddrFilter::add(Key key, std::size_t length, Action action) {
+        key = truncate(key, length);
+
+        auto const set_action = [this, action](std::uint32_t index) {
+            auto& node = nodes[index];
+            count += (action != Action::None) - (node.action != Action::None);
+            node.action = action;
+        };
+
+        auto const new_node = [this](Key prefix, std::size_t length) {
+            Node node;
+            node.prefix = prefix;
+            node.length = static_cast<std::uint8_t>(length);
+            nodes.push_back(node);
+            return static_cast<std::uint32_t>(nodes.size() - 1);
+        };
+
+        // every node on the way matches key up to its length; indices are
+        // used throughout as pushing a node may move the others
+        std::uint32_t index{};
+        std::uint32_t changed{};
+        while (true) {
+            if (nodes[index].length == length) {
+                set_action(index);
+                changed = index;
+                break;
+            }
+
+            auto const side = bit(key, nodes[index].length);
+            auto const child = nodes[index].children[side];
+            if (child == 0) {
+                if (action == Action::None)
+                    return;
+
+                auto const leaf = new_node(key, length);
+                nodes[index].children[side] = leaf;
+                set_action(leaf);
+                changed = leaf;
+                break;
+            }
+
+            auto const child_length = std::size_t{nodes[child].length};
+            auto const common =
+                std::min({common_length(key, nodes[child].prefix), length,
+                          child_length});
+
+            // the child's prefix is a prefix of key, carry on below it
+            if (common == child_length) {
+                index = child;
+                continue;
+            }
+
+            if (action == Action::None)
+                return;
+
+            // key is a prefix of the child's prefix: insert it above the
+            // child, otherwise branch where the two first differ
+            auto const parent = new_node(truncate(key, common), common);
+            nodes[parent].children[bit(nodes[child].prefix, common)] = child;
+            nodes[index].children[side] = parent;
+
+            if (common == length) {
+                set_action(parent);
+            } else {
+                auto const leaf = new_node(key, length);
+                nodes[parent].children[bit(key, common)] = leaf;
+                set_action(leaf);
+            }
+
+            changed = parent;
+            break;
+        }
+
+        if (nodes.size() >= index_threshold && ip4_index.entries.empty()) {
+            for (auto* index : {&ip4_index, &ip6_index}) {
+                index->entries.resize(std::size_t{1} << index_bits);
+                fill(*index, 0, Action::None);
+            }
+        } else {
+            // changed is above any other node added, so only the walks
+            // through it can now start or see an action somewhere else
+            reindex(ip4_index, changed);
+            reindex(ip6_index, changed);
+        }
+    }
+
+    void MultiaddrFilter::reindex(Index& index, std::uint32_t node) {
+        auto const& changed = nodes[node];
+        if (index.entries.empty() ||
+            changed.length > index.length + index_bits ||
+            common_length(changed.prefix, index.base) <
+                std::min(std::size_t{changed.length}, index.length))
+            return;
+
+        auto above = Action::None;
+        std::uint32_t current{};
+        while (current != node) {
+            if (nodes[current].action != Action::None)
+                above = nodes[current].action;
+
+            current = nodes[current]
+                          .children[bit(changed.prefix, nodes[current].length)];
+        }
+
+        fill(index, node, above);
+    }
+
+    void MultiaddrFilter::fill(Index& index, std::uint32_t node,
+                               Action above) {
+        auto const& current = nodes[node];
+        auto const end = index.length + index_bits;
+
+        auto first = index.entries.begin();
+        auto last = index.entries.end();
+        if (current.length > index.length) {
+            first += index_bits_of(current.prefix, index.length);
+            last = first + (std::size_t{1} << (end - current.length));
+        }
+
+        std::fill(first, last,
+                  node << 2 | static_cast<std::uint32_t>(above));
+
+        if (current.action != Action::None)
+            above = current.action;
+
+        for (auto const child : current.children) {
+            if (child != 0 && nodes[child].length <= end &&
+                common_length(nodes[child].prefix, index.base) >=
+                    std::min(std::size_t{nodes[child].length}, index.length))
+                fill(index, child, above);
+        }
+    }
+
+    MultiaddrFilter::Action MultiaddrFilter::match(Key key,
+                                                   Index const& index) const {
+        auto ret = Action::None;
+        auto const* node = &nodes[0];
+        if (!index.entries.empty()) {
+            auto const entry =
+                index.entries[index_bits_of(key, index.length)];
+            ret = static_cast<Action>(entry & 3);
+            node = &nodes[entry >> 2];
+        }
+
+        while (true) {
+            if (node->action != Action::None)
+                ret = node->action;
+
+            if (node->length == key_bits)
+                return ret;
+
+            auto const child = node->children[bit(key, node->length)];
+            if (child == 0)
+                return ret;
+
+            node = &nodes[child];
+            if (common_length(key, node->prefix) < node->length)
+                return ret;
+        }
+    }
+
+    MultiaddrFilter::Action
+    MultiaddrFilter::match(MultiaddrView multiaddr) const {
+        auto it = multiaddr.begin();
+        auto const last = multiaddr.end();
+        if (it != last && Code{it->code} == Code::ip6zone)
+            ++it;
+
+        if (it == last)
+            return Action::None;
+
+        switch (Code{it->code}) {
+        case Code::ip4:
+            return match(make_ip4_key<Key>(it->value.data()), ip4_index);
+        case Code::ip6: {
+            std::array<std::uint8_t, 16> bytes;
+            std::copy(it->value.begin(), it->value.end(), bytes.begin());
+            return match(make_key<Key>(bytes), ip6_index);
+        }
+        default:
+            return Action::None;
+        }
+    }
+} // namespace Multiformats
@@ -0,0 +1,246 @@
+// Selecting Multiaddrs by the shape of their protocols
+//
+// File Name: multiaddr_index.cpp
+// Date: 2026-10-18
+
+#include "multiformats/multiaddr_index.hpp"
+
+#include "multiformats/multicodec.hpp"
+
+#include "multiaddr_protocol.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+    /**
+     * @brief Match steps against a sequence, "**" steps as the "*" of a
+     * glob
+     *
+     * On a mismatch the latest gap takes one more element and matching
+     * resumes after it, which is enough as gaps match anything.
+     */
+    template <typename Steps, typename Iterator, typename Matches>
+    bool glob(Steps const& steps, Iterator it, Iterator end,
+              Matches const& matches) {
+        auto step = steps.begin();
+        auto gap = steps.end();
+        auto resume = it;
+        while (it != end) {
+            if (step != steps.end() && step->gap) {
+                gap = step++;
+                resume = it;
+            } else if (step != steps.end() && matches(*step, *it)) {
+                ++step;
+                ++it;
+            } else if (gap != steps.end()) {
+                step = std::next(gap);
+                it = ++resume;
+            } else {
+                return false;
+            }
+        }
+
+        return std::all_of(step, steps.end(),
+                           [](auto const& rest) { return rest.gap; });
+    }
+} // namespace
+
+namespace Multiformats {
+    MultiaddrPattern::MultiaddrPattern(std::string_view pattern) {
+        if (pattern.empty() || pattern[0] != '/')
+            throw std::invalid_argument("invalid multiaddr pattern");
+
+        for (std::size_t begin = 0, end; begin != pattern.size();
+             begin = end) {
+            end = std::min(pattern.find('/', begin + 1), pattern.size());
+            auto const name = pattern.substr(begin + 1, end - begin - 1);
+
+            Step step;
+            if (name == "**") {
+                step.gap = true;
+                if (steps.empty() || !steps.back().gap)
+                    steps.push_back(std::move(step));
+
+                continue;
+            }
+
+            step.code = Multicodec::code(name);
+            auto const value = MultiaddrProtocol::value(step.code);
+            if (value != MultiaddrProtocol::Value::None) {
+                begin = end;
+                if (begin == pattern.size())
+                    throw std::invalid_argument("missing multiaddr value");
+
+                end = value == MultiaddrProtocol::Value::Path
+                          ? pattern.size()
+                          : std::min(pattern.find('/', begin + 1),
+                                     pattern.size());
+
+                auto const text = pattern.substr(begin + 1, end - begin - 1);
+                if (text != "*") {
+                    // the value's binary form, as the protocol parses it
+                    Multiaddr const literal{"/" + std::string{name} + "/" +
+                                            std::string{text}};
+                    auto const component = literal.front();
+                    step.value.assign(component.value.begin(),
+                                      component.value.end());
+                    step.any_value = false;
+                    values = true;
+                }
+            }
+
+            steps.push_back(std::move(step));
+        }
+    }
+
+    bool MultiaddrPattern::matches(MultiaddrView multiaddr) const {
+        auto const matches = [](Step const& step,
+                                Multiaddr::Component const& component) {
+            return step.code == component.code &&
+                   (step.any_value ||
+                    std::equal(step.value.begin(), step.value.end(),
+                               component.value.begin(),
+                               component.value.end()));
+        };
+
+        return glob(steps, multiaddr.begin(), multiaddr.end(), matches);
+    }
+
+    bool
+    MultiaddrPattern::matches_codes(Span<std::uint64_t const> codes) const {
+        return glob(steps, codes.begin(), codes.end(),
+                    [](Step const& step, std::uint64_t code) {
+                        return step.code == code;
+                    });
+    }
+
+    struct MultiaddrIndex::Impl {
+        /** @brief The addresses with one signature */
+        struct Group {
+            std::vector<std::uint64_t> codes;
+            std::vector<Multiaddr> addresses;
+        };
+
+        struct Location {
+            std::size_t group;
+            std::size_t index;
+        };
+
+        std::vector<Group> groups;
+        std::map<std::vector<std::uint64_t>, std::size_t> by_codes;
+
+        // keyed on views of the addresses in groups, a Multiaddr keeps its
+        // buffer when the vector holding it moves it
+        std::unordered_map<MultiaddrView, Location> locations;
+
+        // signature of the address being added, kept to reuse its capacity
+        std::vector<std::uint64_t> codes;
+
+        Group& group(MultiaddrView multiaddr, std::size_t& index) {
+            codes.clear();
+            for (auto const& component : multiaddr)
+                codes.push_back(component.code);
+
+            auto const it = by_codes.find(codes);
+            if (it != by_codes.end()) {
+                index = it->second;
+            } else {
+                index = groups.size();
+                groups.push_back({codes, {}});
+                by_codes.emplace(codes, index);
+            }
+
+            return groups[index];
+        }
+    };
+
+    MultiaddrIndex::MultiaddrIndex()
+        : impl(std::make_unique<Impl>()) {}
+
+    MultiaddrIndex::~MultiaddrIndex() = default;
+
+    bool MultiaddrIndex::add(Multiaddr multiaddr) {
+        if (contains(multiaddr.view()))
+            return false;
+
+        std::size_t index{};
+        auto& group = impl->group(multiaddr.view(), index);
+        auto const& added = group.addresses.emplace_back(std::move(multiaddr));
+        impl->locations.emplace(added.view(),
+                                Impl::Location{index,
+                                               group.addresses.size() - 1});
+        return true;
+    }
+
+    bool MultiaddrIndex::remove(MultiaddrView multiaddr) {
+        auto const it = impl->locations.find(multiaddr);
+        if (it == impl->locations.end())
+            return false;
+
+        auto const location = it->second;
+        impl->locations.erase(it);
+
+        // fill the gap with the group's last address
+        auto& addresses = impl->groups[location.group].addresses;
+        if (location.index + 1 != addresses.size()) {
+            addresses[location.index] = std::move(addresses.back());
+            impl->locations[addresses[location.index].view()] = location;
+        }
+
+        addresses.pop_back();
+        return true;
+    }
+
+    bool MultiaddrIndex::contains(MultiaddrView multiaddr) const {
+        return impl->locations.count(multiaddr) != 0;
+    }
+
+    void MultiaddrIndex::query(MultiaddrPattern const& pattern,
+                               Callback const& callback) const {
+        for (auto const& group : impl->groups) {
+            if (group.addresses.empty() || !pattern.matches_codes(group.codes))
+                continue;
+
+            for (auto const& multiaddr : group.addresses) {
+                if (!pattern.has_values() || pattern.matches(multiaddr))
+                    callback(multiaddr);
+            }
+        }
+    }
+
+    std::size_t MultiaddrIndex::count(MultiaddrPattern const& pattern) const {
+        std::size_t ret{};
+        for (auto const& group : impl->groups) {
+            if (group.addresses.empty() || !pattern.matches_codes(group.codes))
+                continue;
+
+            if (!pattern.has_values()) {
+                ret += group.addresses.size();
+                continue;
+            }
+
+            for (auto const& multiaddr : group.addresses)
+                ret += pattern.matches(multiaddr);
+        }
+
+        return ret;
+    }
+
+    std::size_t MultiaddrIndex::size() const { return impl->locations.size(); }
+
+    std::size_t MultiaddrIndex::signatures() const {
+        return static_cast<std::size_t>(std::count_if(
+            impl->groups.begin(), impl->groups.end(),
+            [](Impl::Group const& group) { return !group.addresses.empty(); }));
+    }
+} // namespace Multiformats
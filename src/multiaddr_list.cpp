@@ -0,0 +1,204 @@
+// Bulk parsing of Multiaddrs from text, one per line
+//
+// File Name: multiaddr_list.cpp
+// Date: 2026-10-18
+
+#include "multiformats/multiaddr_list.hpp"
+
+#include "file.hpp"
+#include "multiaddr_protocol.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <cstdint>
+
+namespace {
+    using namespace Multiformats;
+
+    /** @brief What one chunk of the text parsed to */
+    struct Part {
+        std::vector<std::uint8_t> bytes;
+        std::vector<std::size_t> ends;
+
+        // line numbers counted from the start of the chunk
+        std::vector<MultiaddrList::LineError> errors;
+        std::size_t lines{};
+
+        // what stopped the parse, such as std::bad_alloc, rethrown once
+        // every chunk is done
+        std::exception_ptr failure;
+    };
+
+    /** @brief Cut text into pieces of about chunk_size, at line breaks */
+    std::vector<std::string_view> split(std::string_view text,
+                                        std::size_t chunk_size) {
+        std::vector<std::string_view> ret;
+        while (!text.empty()) {
+            auto end = text.size() <= chunk_size
+                           ? std::string_view::npos
+                           : text.find('\n', chunk_size - 1);
+            end = end == std::string_view::npos ? text.size() : end + 1;
+
+            ret.push_back(text.substr(0, end));
+            text.remove_prefix(end);
+        }
+
+        return ret;
+    }
+
+    void parse_chunk(std::string_view text, Part& part) {
+        // typical lines are no longer in binary than as text, so this
+        // rarely needs to grow
+        part.bytes.reserve(text.size());
+
+        for (std::size_t begin = 0; begin < text.size();) {
+            auto const end = std::min(text.find('\n', begin), text.size());
+            auto line = text.substr(begin, end - begin);
+            begin = end + 1;
+            ++part.lines;
+
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+
+            if (line.empty())
+                continue;
+
+            auto const size = part.bytes.size();
+            auto const error = MultiaddrProtocol::to_binary(line, part.bytes);
+            if (error == MultiaddrError::None) {
+                part.ends.push_back(part.bytes.size());
+            } else {
+                part.bytes.resize(size);
+                part.errors.push_back({part.lines, error});
+            }
+        }
+    }
+} // namespace
+
+namespace Multiformats {
+    MultiaddrList MultiaddrList::parse(std::string_view text) {
+        return parse(text, Options{});
+    }
+
+    MultiaddrList MultiaddrList::parse(std::string_view text,
+                                       Options const& options) {
+        if (options.chunk_size == 0)
+            throw std::invalid_argument("chunk size must be non-zero");
+
+        auto const chunks = split(text, options.chunk_size);
+        std::vector<Part> parts(chunks.size());
+
+        MultiaddrList ret;
+        if (chunks.empty())
+            return ret;
+
+        if (chunks.size() == 1) {
+            parse_chunk(chunks.front(), parts.front());
+            ret.bytes = std::move(parts.front().bytes);
+            ret.ends = std::move(parts.front().ends);
+            ret.failures = std::move(parts.front().errors);
+            return ret;
+        }
+
+        auto const workers =
+            options.workers != 0
+                ? options.workers
+                : std::max(1u, std::thread::hardware_concurrency());
+        ThreadPool pool{std::min(workers, chunks.size())};
+
+        {
+            WaitGroup group;
+            for (std::size_t i = 0; i < chunks.size(); ++i)
+                pool.submit(group, [&, i] {
+                    try {
+                        parse_chunk(chunks[i], parts[i]);
+                    } catch (...) {
+                        parts[i].failure = std::current_exception();
+                    }
+                });
+
+            group.wait();
+        }
+
+        for (auto const& part : parts)
+            if (part.failure)
+                std::rethrow_exception(part.failure);
+
+        // where each part lands in the joined list
+        struct Position {
+            std::size_t byte;
+            std::size_t address;
+        };
+
+        std::vector<Position> positions(parts.size());
+        Position total{};
+        std::size_t line{};
+        for (std::size_t i = 0; i < parts.size(); ++i) {
+            positions[i] = total;
+            total.byte += parts[i].bytes.size();
+            total.address += parts[i].ends.size();
+
+            for (auto const& error : parts[i].errors)
+                ret.failures.push_back({line + error.line, error.error});
+
+            line += parts[i].lines;
+        }
+
+        ret.bytes.resize(total.byte);
+        ret.ends.resize(total.address);
+
+        WaitGroup group;
+        for (std::size_t i = 0; i < parts.size(); ++i)
+            pool.submit(group, [&, i] {
+                auto& part = parts[i];
+                auto const [byte, address] = positions[i];
+                std::copy(part.bytes.begin(), part.bytes.end(),
+                          ret.bytes.begin() + byte);
+                std::transform(part.ends.begin(), part.ends.end(),
+                               ret.ends.begin() + address,
+                               [byte = byte](std::size_t end) {
+                                   return byte + end;
+                               });
+
+                // release the part's memory as soon as it has been copied
+                part = {};
+            });
+
+        group.wait();
+        return ret;
+    }
+
+    MultiaddrList MultiaddrList::from_file(std::string const& path) {
+        return from_file(path, Options{});
+    }
+
+    MultiaddrList MultiaddrList::from_file(std::string const& path,
+                                           Options const& options) {
+        File::Mapping file{path};
+        if (file.mapped()) {
+            // chunks are parsed out of order, read ahead over all of it
+            file.will_need(0, file.size());
+            return parse({reinterpret_cast<char const*>(file.data()),
+                          file.size()},
+                         options);
+        }
+
+        // read anything else whole, holding it open meanwhile so that a
+        // pipe always has a reader
+        std::string text;
+        File::for_each_chunk(path,
+                             [&text](std::uint8_t const* data,
+                                     std::size_t size) {
+                                 text.append(
+                                     reinterpret_cast<char const*>(data),
+                                     size);
+                             });
+
+        return parse(text, options);
+    }
+} // namespace Multiformats
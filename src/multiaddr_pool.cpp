@@ -0,0 +1,136 @@
+// Interning pool for Multiaddrs
+//
+// File Name: multiaddr_pool.cpp
+// Date: 2026-10-18
+
+#include "multiformats/multiaddr_pool.hpp"
+
+#include "sharded.hpp"
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+#include <cstddef>
+
+namespace {
+    using namespace Multiformats;
+
+    /** @brief An interned address, or an address being looked up */
+    struct Key {
+        MultiaddrView view;
+        std::size_t hash;
+        Multiaddr const* address;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(Key const& key) const noexcept {
+            return key.hash;
+        }
+    };
+
+    struct KeyEqual {
+        bool operator()(Key const& lhs, Key const& rhs) const {
+            return lhs.hash == rhs.hash && lhs.view == rhs.view;
+        }
+    };
+
+    struct Addresses {
+        // a deque never moves its elements, so handles and the views in
+        // index stay valid
+        std::deque<Multiaddr> addresses;
+        std::unordered_set<Key, KeyHash, KeyEqual> index;
+    };
+} // namespace
+
+namespace Multiformats {
+    struct MultiaddrPool::Impl {
+        Sharded<Addresses> shards;
+
+        explicit Impl(std::size_t count)
+            : shards(count) {}
+
+        Key key(MultiaddrView view) const {
+            return {view, std::hash<MultiaddrView>{}(view), nullptr};
+        }
+
+        Handle find(Key const& key) const {
+            auto& shard = shards.pick(key.hash);
+            std::shared_lock lock{shard.mutex};
+            auto const it = shard.index.find(key);
+            return it == shard.index.end() ? nullptr : it->address;
+        }
+
+        /**
+         * @brief Store multiaddr, found by key, unless another thread got
+         * there first
+         *
+         * multiaddr is only moved from if it is stored, key may view it.
+         */
+        Handle insert(Key const& key, Multiaddr&& multiaddr) {
+            auto& shard = shards.pick(key.hash);
+            std::unique_lock lock{shard.mutex};
+            auto const it = shard.index.find(key);
+            if (it != shard.index.end())
+                return it->address;
+
+            auto const& stored =
+                shard.addresses.emplace_back(std::move(multiaddr));
+            shard.index.insert({stored.view(), key.hash, &stored});
+            return &stored;
+        }
+    };
+
+    MultiaddrPool::MultiaddrPool(std::size_t shards) {
+        if (shards == 0)
+            throw std::invalid_argument("pool needs at least one shard");
+
+        impl = std::make_unique<Impl>(shards);
+    }
+
+    MultiaddrPool::~MultiaddrPool() = default;
+
+    MultiaddrPool::Handle MultiaddrPool::intern(MultiaddrView view) {
+        auto const key = impl->key(view);
+        if (auto const handle = impl->find(key))
+            return handle;
+
+        // copy and validate before taking the lock
+        return impl->insert(key, Multiaddr{view});
+    }
+
+    MultiaddrPool::Handle MultiaddrPool::intern(Multiaddr const& multiaddr) {
+        auto const key = impl->key(multiaddr.view());
+        if (auto const handle = impl->find(key))
+            return handle;
+
+        return impl->insert(key, Multiaddr{multiaddr});
+    }
+
+    MultiaddrPool::Handle MultiaddrPool::intern(Multiaddr&& multiaddr) {
+        auto const key = impl->key(multiaddr.view());
+        if (auto const handle = impl->find(key))
+            return handle;
+
+        return impl->insert(key, std::move(multiaddr));
+    }
+
+    MultiaddrPool::Handle MultiaddrPool::find(MultiaddrView view) const {
+        return impl->find(impl->key(view));
+    }
+
+    std::size_t MultiaddrPool::size() const {
+        std::size_t ret{};
+        for (std::size_t i = 0; i < impl->shards.count(); ++i) {
+            std::shared_lock lock{impl->shards[i].mutex};
+            ret += impl->shards[i].addresses.size();
+        }
+
+        return ret;
+    }
+} // namespace Multiformats
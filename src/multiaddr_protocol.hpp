@@ -0,0 +1,41 @@
+/**
+ * Text form details of the protocols multiaddrs support
+ *
+ * @file multiaddr_protocol.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include "multiformats/multiaddr.hpp"
+
+#include <string_view>
+#include <vector>
+
+#include <cstdint>
+
+namespace Multiformats::MultiaddrProtocol {
+    /** @brief What follows a protocol's name in a multiaddr's text */
+    enum class Value {
+        /** @brief Nothing, as for /quic */
+        None,
+
+        /** @brief One part, as for /tcp/80 */
+        Part,
+
+        /** @brief The rest of the text, as for /unix/tmp/socket */
+        Path
+    };
+
+    /** @throw std::invalid_argument if multiaddrs don't support the code */
+    Value value(std::uint64_t code);
+
+    /**
+     * @brief Append the binary form of a multiaddr's text to out, without
+     * throwing on invalid text
+     *
+     * On error out is left holding part of the address.
+     */
+    MultiaddrError to_binary(std::string_view text,
+                             std::vector<std::uint8_t>& out);
+} // namespace Multiformats::MultiaddrProtocol
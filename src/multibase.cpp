@@ -11,16 +11,15 @@
 #include <algorithm>
 #include <array>
 #include <iomanip>
-#include <regex>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
-#include <unordered_map>
+#include <string_view>
+#include <tuple>
 
 #include <cctype>
 #include <cstring>
 
-#include <iostream>
-
 namespace {
     using namespace Multiformats::Multibase;
 
@@ -38,7 +37,7 @@ namespace {
     count_consecutive(Iterator begin, Iterator end, Value value) {
 
         Iterator ret = begin;
-        while (*ret == value && ret != end)
+        while (ret != end && *ret == value)
             ++ret;
 
         return {std::distance(begin, ret), ret};
@@ -95,39 +94,65 @@ namespace {
         throw std::runtime_error("invalid protocol");
     }
 
-    std::array const patterns{std::regex{"^.*$"},
-                              std::regex{"^0[0-1]*$"},
-                              std::regex{"^7[0-7]*$"},
-                              std::regex{"^9[0-9]*$"},
-                              std::regex{"^f[0-9a-f]*"},
-                              std::regex{"^F[0-9A-F]*$"},
-                              std::regex{"^v[0-9a-v]*$"},
-                              std::regex{"^V[0-9A-V]*$"},
-                              std::regex{"^t[0-9a-v=]*$"},
-                              std::regex{"^T[0-9A-V=]*$"},
-                              std::regex{"^b[2-7a-z]*$"},
-                              std::regex{"^B[2-7A-Z]*$"},
-                              std::regex{"^c[2-7a-z=]*$"},
-                              std::regex{"^C[2-7A-Z=]*$"},
-                              std::regex{"^h[13-7a-km-uw-z]*$"},
-                              std::regex{"^Z[1-9A-HJ-Za-km-z]*$"},
-                              std::regex{"^(z|1|Q)[1-9A-HJ-Za-km-z]*$"},
-                              std::regex{"^m[0-9a-zA-Z+/]*$"},
-                              std::regex{"^M[0-9a-zA-Z+/=]*$"},
-                              std::regex{"^u[0-9a-zA-Z_-]*$"},
-                              std::regex{"^U[0-9a-zA-Z_=-]*$"}};
+    constexpr std::size_t protocol_count = 21;
+
+    /** @brief Set of characters from a spec like "0-9a-f" */
+    class Charset {
+        std::array<std::uint64_t, 4> bits{};
+
+        constexpr void insert(unsigned char c) {
+            bits[c / 64] |= std::uint64_t{1} << (c % 64);
+        }
+
+      public:
+        constexpr Charset(std::string_view spec) {
+            for (std::size_t i = 0; i < spec.size(); ++i) {
+                if (i + 2 < spec.size() && spec[i + 1] == '-') {
+                    for (int c = spec[i]; c <= spec[i + 2]; ++c)
+                        insert(static_cast<unsigned char>(c));
+
+                    i += 2;
+                } else {
+                    insert(static_cast<unsigned char>(spec[i]));
+                }
+            }
+        }
+
+        constexpr bool contains(char c) const {
+            auto u = static_cast<unsigned char>(c);
+            return bits[u / 64] & (std::uint64_t{1} << (u % 64));
+        }
+    };
+
+    /**
+     * @brief Characters allowed after the prefix, indexed by protocol,
+     * identity allows any
+     */
+    constexpr std::array<Charset, protocol_count> charsets{
+        Charset{""},                 Charset{"0-1"},
+        Charset{"0-7"},              Charset{"0-9"},
+        Charset{"0-9a-f"},           Charset{"0-9A-F"},
+        Charset{"0-9a-v"},           Charset{"0-9A-V"},
+        Charset{"0-9a-v="},          Charset{"0-9A-V="},
+        Charset{"2-7a-z"},           Charset{"2-7A-Z"},
+        Charset{"2-7a-z="},          Charset{"2-7A-Z="},
+        Charset{"13-7a-km-uw-z"},    Charset{"1-9A-HJ-Za-km-z"},
+        Charset{"1-9A-HJ-Za-km-z"},  Charset{"0-9a-zA-Z+/"},
+        Charset{"0-9a-zA-Z+/="},     Charset{"0-9a-zA-Z_-"},
+        Charset{"0-9a-zA-Z_=-"}};
 
     Protocol validate(std::string const& str) {
         if (str.empty())
             throw std::runtime_error("empty string");
 
         auto protocol = get_protocol(str.front());
-        if (patterns.size() < static_cast<std::uint32_t>(protocol))
+        if (charsets.size() <= static_cast<std::uint32_t>(protocol))
             throw std::runtime_error("unknown protocol");
 
-        std::regex pattern = patterns[static_cast<std::uint32_t>(protocol)];
-
-        if (!std::regex_match(str, pattern))
+        auto const& charset = charsets[static_cast<std::uint32_t>(protocol)];
+        if (protocol != Protocol::Identity &&
+            !std::all_of(std::next(str.cbegin()), str.cend(),
+                         [&](char c) { return charset.contains(c); }))
             throw std::runtime_error("invalid characters for protocol");
 
         return protocol;
@@ -274,9 +299,15 @@ namespace {
 
         if (input.size() > 1) {
             auto it = std::next(input.cbegin());
-            for (; *it == '0' && it != input.cend(); ++it)
+            for (; it != input.cend() && *it == '0'; ++it)
                 leading_zeros++;
 
+            // all zeros, with no number after them
+            if (it == input.cend()) {
+                output.assign(leading_zeros, 0);
+                return;
+            }
+
             std::size_t ms_bits{3};
             while ((convert(*it) & (1 << ms_bits)) == 0 && ms_bits > 0)
                 ms_bits--;
@@ -560,7 +591,7 @@ namespace {
 
         std::size_t padding_count{};
         if (padding) {
-            for (auto it = input.crbegin(); *it == '=' && it != input.crend();
+            for (auto it = input.crbegin(); it != input.crend() && *it == '=';
                  ++it)
                 ++padding_count;
         }
@@ -578,7 +609,9 @@ namespace {
             std::uint8_t value =
                 std::distance(lookup.cbegin(),
                               std::find(lookup.cbegin(), lookup.cend(), *it));
-            *out |= value << offset;
+            // the last character may carry only padding bits, past the end
+            if (out != output.end())
+                *out |= value << offset;
 
             auto carry_back = value >> (8 - offset);
             if (offset > 3 && out != output.begin())
@@ -710,7 +743,7 @@ namespace {
 
         // erase any leading zeros
         auto zero_end = buf.begin();
-        while (*zero_end == 0 && zero_end != buf.end())
+        while (zero_end != buf.end() && *zero_end == 0)
             ++zero_end;
 
         if (buf.front() == 0)
@@ -720,7 +753,6 @@ namespace {
         auto inserter = std::back_inserter(output);
         inserter = ' ';
         std::fill_n(inserter, leading_zeros, '1');
-        std::cout << output << std::endl;
         std::transform(buf.cbegin(), buf.cend(), inserter,
                        [&](auto& elem) { return lookup[elem]; });
     }
@@ -735,7 +767,9 @@ namespace {
         auto [leading_zeros, it] =
             count_consecutive(std::next(input.cbegin()), input.cend(), '1');
 
-        output.push_back(0);
+        // all '1's is only zero bytes, with no number after them
+        if (it != input.cend())
+            output.push_back(0);
 
         for (; it != input.cend(); ++it) {
             std::uint32_t carry =
@@ -783,7 +817,8 @@ namespace {
     // Base64Pad
     std::string add_padding(std::string const& input) {
         std::string tmp{input};
-        std::fill_n(std::back_inserter(tmp), 4 - ((input.size() - 1) % 4), '=');
+        std::fill_n(std::back_inserter(tmp), (4 - ((input.size() - 1) % 4)) % 4,
+                    '=');
         return tmp;
     }
 
@@ -828,15 +863,29 @@ namespace {
     template <>
     void decode<Protocol::Base64Pad>(std::string const& input,
                                      std::vector<std::uint8_t>& output) {
+        auto const size = input.size() - 1;
+        if (size == 0)
+            throw std::runtime_error("input is empty");
+
+        if (size % 4 != 0)
+            throw std::runtime_error("incorrect alignment for Base64");
+
         auto [padding_count, it] =
             count_consecutive(input.crbegin(), input.crend(), '=');
-        std::fill_n(std::back_inserter(output),
-                    ((input.size() - padding_count - 1) * 3) / 4, 0);
+        if (padding_count > 2)
+            throw std::runtime_error("invalid padding for Base64");
+
+        // EVP_DecodeBlock writes 3 bytes for every 4 characters, padding
+        // included, so trim the bytes that the padding stands for after
+        auto const offset = output.size();
+        output.resize(offset + (size / 4) * 3);
         if (EVP_DecodeBlock(
-                output.data(),
+                output.data() + offset,
                 reinterpret_cast<unsigned const char*>(input.c_str() + 1),
-                input.size() - 1) == -1)
+                size) == -1)
             throw std::runtime_error("decoding error");
+
+        output.resize(output.size() - padding_count);
     }
 
     // Base64
@@ -917,52 +966,55 @@ namespace {
     };
 
     template <Protocol protocol>
-    constexpr auto make_coder_entry() {
-        return std::make_pair(protocol,
-                              Coder{encode<protocol>, decode<protocol>});
+    constexpr void add_coder(std::array<Coder, protocol_count>& coders) {
+        coders[static_cast<std::size_t>(protocol)] =
+            Coder{encode<protocol>, decode<protocol>};
     }
 
     template <Protocol upper, Protocol lower>
-    constexpr auto make_upper_coder_entry() {
-        return std::make_pair(upper,
-                              Coder{[](std::vector<std::uint8_t> const& input,
-                                       std::string& output) {
-                                        encode_upper<lower>(input, output);
-                                    },
-                                    [](std::string const& input,
-                                       std::vector<std::uint8_t>& output) {
-                                        decode_upper<lower>(input, output);
-                                    }});
+    constexpr void add_upper_coder(std::array<Coder, protocol_count>& coders) {
+        coders[static_cast<std::size_t>(upper)] =
+            Coder{[](std::vector<std::uint8_t> const& input,
+                     std::string& output) { encode_upper<lower>(input, output); },
+                  [](std::string const& input,
+                     std::vector<std::uint8_t>& output) {
+                      decode_upper<lower>(input, output);
+                  }};
     }
 
-    std::unordered_map<Protocol, Coder> const coders{
-        make_coder_entry<Protocol::Base2>(),
-        make_coder_entry<Protocol::Base8>(),
-        make_coder_entry<Protocol::Base10>(),
-        make_coder_entry<Protocol::Base16>(),
-        make_upper_coder_entry<Protocol::Base16Upper, Protocol::Base16>(),
-        make_coder_entry<Protocol::Base32Hex>(),
-        make_upper_coder_entry<Protocol::Base32HexUpper, Protocol::Base32Hex>(),
-        make_coder_entry<Protocol::Base32HexPad>(),
-        make_upper_coder_entry<Protocol::Base32HexPadUpper,
-                               Protocol::Base32HexPad>(),
-        make_coder_entry<Protocol::Base32>(),
-        make_upper_coder_entry<Protocol::Base32Upper, Protocol::Base32>(),
-        make_coder_entry<Protocol::Base32Pad>(),
-        make_upper_coder_entry<Protocol::Base32PadUpper, Protocol::Base32Pad>(),
-        make_coder_entry<Protocol::Base58Btc>(),
-        make_coder_entry<Protocol::Base58Flickr>(),
-        make_coder_entry<Protocol::Base32Z>(),
-        make_coder_entry<Protocol::Base64>(),
-        make_coder_entry<Protocol::Base64Pad>(),
-        make_coder_entry<Protocol::Base64Url>(),
-        make_coder_entry<Protocol::Base64UrlPad>()};
-
-    auto find_coder(Protocol protocol) {
-        auto it = coders.find(protocol);
-        if (it == coders.end())
+    /** @brief Coders indexed by protocol, identity has none */
+    constexpr auto coders = [] {
+        std::array<Coder, protocol_count> ret{};
+        add_coder<Protocol::Base2>(ret);
+        add_coder<Protocol::Base8>(ret);
+        add_coder<Protocol::Base10>(ret);
+        add_coder<Protocol::Base16>(ret);
+        add_upper_coder<Protocol::Base16Upper, Protocol::Base16>(ret);
+        add_coder<Protocol::Base32Hex>(ret);
+        add_upper_coder<Protocol::Base32HexUpper, Protocol::Base32Hex>(ret);
+        add_coder<Protocol::Base32HexPad>(ret);
+        add_upper_coder<Protocol::Base32HexPadUpper, Protocol::Base32HexPad>(
+            ret);
+        add_coder<Protocol::Base32>(ret);
+        add_upper_coder<Protocol::Base32Upper, Protocol::Base32>(ret);
+        add_coder<Protocol::Base32Pad>(ret);
+        add_upper_coder<Protocol::Base32PadUpper, Protocol::Base32Pad>(ret);
+        add_coder<Protocol::Base58Btc>(ret);
+        add_coder<Protocol::Base58Flickr>(ret);
+        add_coder<Protocol::Base32Z>(ret);
+        add_coder<Protocol::Base64>(ret);
+        add_coder<Protocol::Base64Pad>(ret);
+        add_coder<Protocol::Base64Url>(ret);
+        add_coder<Protocol::Base64UrlPad>(ret);
+        return ret;
+    }();
+
+    Coder find_coder(Protocol protocol) {
+        auto index = static_cast<std::size_t>(protocol);
+        if (index >= coders.size() || coders[index].encoder == nullptr)
             throw std::runtime_error("unsupported protocol");
-        return it->second;
+
+        return coders[index];
     }
 } // namespace
 
@@ -8,97 +8,273 @@
 #include "multiformats/multicodec.hpp"
 #include "multiformats/varint.hpp"
 
+#include "blake2.hpp"
+#include "file.hpp"
+#include "murmur3.hpp"
+#include "thread_pool.hpp"
+#include "xxh3.hpp"
+
 #include "openssl/evp.h"
 
 #include <array>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <utility>
 
 namespace {
     using namespace Multiformats;
-    std::uint64_t const blake2b_512{0xb240};
-    std::uint64_t const blake2s_256{0xb260};
-    std::uint64_t const md4{0xd4};
-    std::uint64_t const md5{0xd5};
-    std::uint64_t const sha1{0x11};
-    std::uint64_t const sha2_256{0x12};
-    std::uint64_t const sha2_512{0x13};
-    std::uint64_t const sha3_224{0x17};
-    std::uint64_t const sha3_256{0x16};
-    std::uint64_t const sha3_384{0x15};
-    std::uint64_t const sha3_512{0x14};
-    std::uint64_t const shake_128{0x18};
-    std::uint64_t const shake_256{0x19};
+    using Multicodec::Code;
+
+    // BLAKE2 codes are contiguous, one per byte of digest length
+    constexpr auto blake2b_8 = static_cast<std::uint64_t>(Code::blake2b_8);
+    constexpr auto blake2b_512 = static_cast<std::uint64_t>(Code::blake2b_512);
+    constexpr auto blake2s_8 = static_cast<std::uint64_t>(Code::blake2s_8);
+    constexpr auto blake2s_256 = static_cast<std::uint64_t>(Code::blake2s_256);
+
+    // large enough for any supported digest
+    constexpr std::size_t max_digest_size = 64;
 
     class OpenSSLHasher {
+        EVP_MD const* md;
         EVP_MD_CTX* ctx;
 
       public:
         OpenSSLHasher(EVP_MD const* md)
-            : ctx(EVP_MD_CTX_new()) {
-
-            EVP_DigestInit(ctx, md);
-            if (ctx == nullptr)
+            : md(md)
+            , ctx(EVP_MD_CTX_new()) {
+            if (ctx == nullptr || EVP_DigestInit_ex(ctx, md, nullptr) != 1) {
+                EVP_MD_CTX_free(ctx);
                 throw std::invalid_argument(
                     "OpenSSL doesn't support this hash");
+            }
         }
 
-        std::vector<std::uint8_t>
-        hash(std::vector<std::uint8_t> const& plaintext) {
-            int size = EVP_MD_CTX_size(ctx);
-            std::vector<std::uint8_t> digest;
-            std::fill_n(std::back_inserter(digest), size, 0);
-            unsigned digest_len{};
+        OpenSSLHasher(OpenSSLHasher&& other) noexcept
+            : md(other.md)
+            , ctx(std::exchange(other.ctx, nullptr)) {}
+
+        OpenSSLHasher(OpenSSLHasher const&) = delete;
+        OpenSSLHasher& operator=(OpenSSLHasher const&) = delete;
+
+        std::size_t size() const { return EVP_MD_CTX_size(ctx); }
+
+        void update(std::uint8_t const* data, std::size_t size) {
+            EVP_DigestUpdate(ctx, data, size);
+        }
 
-            EVP_DigestUpdate(ctx, plaintext.data(), plaintext.size());
-            EVP_DigestFinal(ctx, digest.data(), &digest_len);
+        void final(std::uint8_t* digest) {
+            unsigned digest_len{};
+            EVP_DigestFinal_ex(ctx, digest, &digest_len);
 
-            if (digest_len != size)
+            if (digest_len != size())
                 throw std::runtime_error("digest size does not match");
+        }
 
-            return digest;
+        /** @brief Start a new digest, reusing the context */
+        void reset() {
+            if (EVP_DigestInit_ex(ctx, md, nullptr) != 1)
+                throw std::runtime_error("failed to reset digest");
         }
 
         ~OpenSSLHasher() { EVP_MD_CTX_free(ctx); }
     };
 
-    template <typename Hasher, typename... Args>
-    auto hash_impl(std::vector<std::uint8_t> const& plaintext, Args... args) {
+    /**
+     * Construct the hasher and hand it to visitor, which feeds it input and
+     * collects the digest. Keeping the hasher on the stack of a template means
+     * no allocation and no virtual calls per update.
+     */
+    template <typename Hasher, typename Visitor, typename... Args>
+    auto hash_impl(Visitor&& visitor, Args... args) {
         Hasher hasher(args...);
-        return hasher.hash(plaintext);
-    }
-
-    auto hash(Varint const& protocol,
-              std::vector<std::uint8_t> const& plaintext) {
-        switch (static_cast<std::uint64_t>(protocol)) {
-        case sha1:
-            return hash_impl<OpenSSLHasher>(plaintext, EVP_sha1());
-        case blake2b_512:
-            return hash_impl<OpenSSLHasher>(plaintext, EVP_blake2b512());
-        case blake2s_256:
-            return hash_impl<OpenSSLHasher>(plaintext, EVP_blake2s256());
-        case md4:
-            return hash_impl<OpenSSLHasher>(plaintext, EVP_md4());
-        case md5:
-            return hash_impl<OpenSSLHasher>(plaintext, EVP_md5());
-        case sha2_256:
-            return hash_impl<OpenSSLHasher>(plaintext, EVP_sha256());
-        case sha2_512:
-            return hash_impl<OpenSSLHasher>(plaintext, EVP_sha512());
-        case sha3_224:
-            return hash_impl<OpenSSLHasher>(plaintext, EVP_sha3_224());
-        case sha3_256:
-            return hash_impl<OpenSSLHasher>(plaintext, EVP_sha3_256());
-        case sha3_384:
-            return hash_impl<OpenSSLHasher>(plaintext, EVP_sha3_384());
-        case sha3_512:
-            return hash_impl<OpenSSLHasher>(plaintext, EVP_sha3_512());
-        case shake_128:
-            return hash_impl<OpenSSLHasher>(plaintext, EVP_shake128());
-        case shake_256:
-            return hash_impl<OpenSSLHasher>(plaintext, EVP_shake256());
+        return visitor(hasher);
+    }
+
+    template <Code>
+    constexpr bool unsupported = false;
+
+    /** @brief Hash with the function named by a compile time code */
+    template <Code C, typename Visitor>
+    auto hash(Visitor&& visitor) {
+        constexpr auto value = static_cast<std::uint64_t>(C);
+
+        if constexpr (value >= blake2b_8 && value <= blake2b_512)
+            return hash_impl<Blake2::Blake2b>(visitor, value - blake2b_8 + 1);
+        else if constexpr (value >= blake2s_8 && value <= blake2s_256)
+            return hash_impl<Blake2::Blake2s>(visitor, value - blake2s_8 + 1);
+        else if constexpr (C == Code::sha1)
+            return hash_impl<OpenSSLHasher>(visitor, EVP_sha1());
+        else if constexpr (C == Code::md4)
+            return hash_impl<OpenSSLHasher>(visitor, EVP_md4());
+        else if constexpr (C == Code::md5)
+            return hash_impl<OpenSSLHasher>(visitor, EVP_md5());
+        else if constexpr (C == Code::sha2_256)
+            return hash_impl<OpenSSLHasher>(visitor, EVP_sha256());
+        else if constexpr (C == Code::sha2_512)
+            return hash_impl<OpenSSLHasher>(visitor, EVP_sha512());
+        else if constexpr (C == Code::sha3_224)
+            return hash_impl<OpenSSLHasher>(visitor, EVP_sha3_224());
+        else if constexpr (C == Code::sha3_256)
+            return hash_impl<OpenSSLHasher>(visitor, EVP_sha3_256());
+        else if constexpr (C == Code::sha3_384)
+            return hash_impl<OpenSSLHasher>(visitor, EVP_sha3_384());
+        else if constexpr (C == Code::sha3_512)
+            return hash_impl<OpenSSLHasher>(visitor, EVP_sha3_512());
+        else if constexpr (C == Code::shake_128)
+            return hash_impl<OpenSSLHasher>(visitor, EVP_shake128());
+        else if constexpr (C == Code::shake_256)
+            return hash_impl<OpenSSLHasher>(visitor, EVP_shake256());
+        else if constexpr (C == Code::murmur3_32)
+            return hash_impl<Murmur3::Hasher32>(visitor);
+        else if constexpr (C == Code::murmur3_128)
+            return hash_impl<Murmur3::Hasher128>(visitor);
+        else if constexpr (C == Code::xxh3_64)
+            return hash_impl<Xxh3::Hasher>(visitor, 8);
+        else if constexpr (C == Code::xxh3_128)
+            return hash_impl<Xxh3::Hasher>(visitor, 16);
+        else
+            static_assert(unsupported<C>, "unsupported hash function");
+    }
+
+    template <typename Visitor>
+    auto hash(std::uint64_t code, Visitor&& visitor) {
+        if (code >= blake2b_8 && code <= blake2b_512)
+            return hash_impl<Blake2::Blake2b>(visitor, code - blake2b_8 + 1);
+
+        if (code >= blake2s_8 && code <= blake2s_256)
+            return hash_impl<Blake2::Blake2s>(visitor, code - blake2s_8 + 1);
+
+        switch (static_cast<Code>(code)) {
+        case Code::sha1:
+            return hash<Code::sha1>(visitor);
+        case Code::md4:
+            return hash<Code::md4>(visitor);
+        case Code::md5:
+            return hash<Code::md5>(visitor);
+        case Code::sha2_256:
+            return hash<Code::sha2_256>(visitor);
+        case Code::sha2_512:
+            return hash<Code::sha2_512>(visitor);
+        case Code::sha3_224:
+            return hash<Code::sha3_224>(visitor);
+        case Code::sha3_256:
+            return hash<Code::sha3_256>(visitor);
+        case Code::sha3_384:
+            return hash<Code::sha3_384>(visitor);
+        case Code::sha3_512:
+            return hash<Code::sha3_512>(visitor);
+        case Code::shake_128:
+            return hash<Code::shake_128>(visitor);
+        case Code::shake_256:
+            return hash<Code::shake_256>(visitor);
+        case Code::murmur3_32:
+            return hash<Code::murmur3_32>(visitor);
+        case Code::murmur3_128:
+            return hash<Code::murmur3_128>(visitor);
+        case Code::xxh3_64:
+            return hash<Code::xxh3_64>(visitor);
+        case Code::xxh3_128:
+            return hash<Code::xxh3_128>(visitor);
+        default:
+            break;
         }
 
         throw std::invalid_argument("unsupported hash function");
     }
+
+    /** @brief Hash a sequence of fragments as one message into digest */
+    template <typename Fragments>
+    std::size_t hash_fragments(std::uint64_t code, Fragments const& fragments,
+                               std::uint8_t* digest) {
+        return hash(code, [&](auto& hasher) {
+            for (auto const& fragment : fragments)
+                hasher.update(fragment.data(), fragment.size());
+
+            hasher.final(digest);
+            return hasher.size();
+        });
+    }
+
+    /** @brief Workers shared by every verify_batch() call */
+    ThreadPool& verify_pool() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    /** @brief Set on the threads of verify_pool() */
+    thread_local bool on_verify_pool{};
+
+#ifdef MULTIFORMATS_HAS_IOVEC
+    /** @brief An iovec array, iterated as fragments with data() and size() */
+    class IovecFragments {
+        struct iovec const* first;
+        struct iovec const* last;
+
+      public:
+        struct Fragment {
+            struct iovec const* iov;
+
+            std::uint8_t const* data() const {
+                return static_cast<std::uint8_t const*>(iov->iov_base);
+            }
+
+            std::size_t size() const { return iov->iov_len; }
+        };
+
+        struct Iterator {
+            struct iovec const* pos;
+
+            Fragment operator*() const { return {pos}; }
+
+            Iterator& operator++() {
+                ++pos;
+                return *this;
+            }
+
+            bool operator!=(Iterator const& other) const {
+                return pos != other.pos;
+            }
+        };
+
+        IovecFragments(struct iovec const* iov, std::size_t count)
+            : first(iov)
+            , last(iov + count) {}
+
+        Iterator begin() const { return {first}; }
+        Iterator end() const { return {last}; }
+    };
+#endif
+} // namespace
+
+namespace Multiformats {
+    /** @brief Type erased hasher behind Multihasher */
+    struct Multihasher::Impl {
+        virtual ~Impl() = default;
+        virtual void update(std::uint8_t const* data, std::size_t size) = 0;
+        virtual std::size_t final(std::uint8_t* digest) = 0;
+    };
+} // namespace Multiformats
+
+namespace {
+    template <typename Hasher>
+    class StreamingHasher : public Multihasher::Impl {
+        Hasher hasher;
+
+      public:
+        explicit StreamingHasher(Hasher&& hasher)
+            : hasher(std::move(hasher)) {}
+
+        void update(std::uint8_t const* data, std::size_t size) override {
+            hasher.update(data, size);
+        }
+
+        std::size_t final(std::uint8_t* digest) override {
+            hasher.final(digest);
+            hasher.reset();
+            return hasher.size();
+        }
+    };
 } // namespace
 
 namespace Multiformats {
@@ -108,15 +284,10 @@ namespace Multiformats {
      * @throw std::invalid_argument if function code is not supported */
     Multihash::Multihash(std::vector<std::uint8_t> const& plaintext,
                          Varint const& protocol) {
-        std::vector<std::uint8_t> digest = hash(protocol, plaintext);
-        Varint len{digest.size()};
-
-        buf.reserve(protocol.size() + len.size() + digest.size());
-
-        // bundle it all up
-        std::copy(protocol.begin(), protocol.end(), std::back_inserter(buf));
-        std::copy(len.begin(), len.end(), std::back_inserter(buf));
-        std::copy(digest.cbegin(), digest.cend(), std::back_inserter(buf));
+        std::array<std::uint8_t, max_digest_size> digest;
+        auto size = hash_fragments(protocol, std::array{ByteSpan{plaintext}},
+                                   digest.data());
+        assign(protocol, digest.data(), size);
     }
 
     /**
@@ -125,25 +296,294 @@ namespace Multiformats {
      * @throw std::out_of_range if protocol isn't in multicodec table */
     Multihash::Multihash(std::vector<std::uint8_t> const& plaintext,
                          std::string const& protocol)
-        : Multihash(plaintext, Multicodec::table.at(protocol)) {}
+        : Multihash(plaintext, Multicodec::code(protocol)) {}
+
+    /**
+     * @param fragments pieces of the message, hashed in order as if they were
+     * one contiguous buffer
+     * @param protocol function code of hash
+     * @throw std::invalid_argument if function code is not supported */
+    Multihash::Multihash(Span<ByteSpan const> fragments,
+                         Varint const& protocol) {
+        std::array<std::uint8_t, max_digest_size> digest;
+        auto size = hash_fragments(protocol, fragments, digest.data());
+        assign(protocol, digest.data(), size);
+    }
+
+    /**
+     * @param fragments pieces of the message, hashed in order
+     * @param protocol name of hash function
+     * @throw std::out_of_range if protocol isn't in multicodec table */
+    Multihash::Multihash(Span<ByteSpan const> fragments,
+                         std::string const& protocol)
+        : Multihash(fragments, Multicodec::code(protocol)) {}
 
-    Varint Multihash::func_code() const { return {buf.cbegin(), buf.cend()}; }
+#ifdef MULTIFORMATS_HAS_IOVEC
+    /**
+     * @param iov array of buffers, hashed in order
+     * @param count number of entries in iov
+     * @param protocol function code of hash
+     * @throw std::invalid_argument if function code is not supported */
+    Multihash::Multihash(struct iovec const* iov, std::size_t count,
+                         Varint const& protocol) {
+        IovecFragments const fragments{iov, count};
 
-    Varint Multihash::len() const {
-        auto [fn, len_it] = make_varint(buf.cbegin(), buf.cend());
-        auto [len, digest_it] = make_varint(len_it, buf.cend());
-        return len;
+        std::array<std::uint8_t, max_digest_size> digest;
+        auto size = hash_fragments(protocol, fragments, digest.data());
+        assign(protocol, digest.data(), size);
     }
+#endif
 
-    std::size_t Multihash::size() const { return buf.size(); }
+    /**
+     * One digest context is set up and reused for every buffer, which avoids
+     * the per-hash setup cost when hashing many small blocks.
+     *
+     * @param buffers independent messages to hash
+     * @param protocol function code of hash
+     * @throw std::invalid_argument if function code is not supported */
+    std::vector<Multihash> Multihash::hash_each(Span<ByteSpan const> buffers,
+                                                Varint const& protocol) {
+        std::vector<Multihash> ret(buffers.size());
+        hash(protocol, [&](auto& hasher) {
+            std::array<std::uint8_t, max_digest_size> digest;
+            for (std::size_t i = 0; i < buffers.size(); ++i) {
+                if (i != 0)
+                    hasher.reset();
+
+                hasher.update(buffers[i].data(), buffers[i].size());
+                hasher.final(digest.data());
+                ret[i].assign(protocol, digest.data(), hasher.size());
+            }
+        });
 
-    Multihash::ConstIterator Multihash::begin() const { return buf.cbegin(); }
+        return ret;
+    }
+
+    template <Multicodec::Code HashFunction>
+    Multihash Multihash::compute_with(ByteSpan plaintext) {
+        std::array<std::uint8_t, max_digest_size> digest;
+        auto size = hash<HashFunction>([&](auto& hasher) {
+            hasher.update(plaintext.data(), plaintext.size());
+            hasher.final(digest.data());
+            return hasher.size();
+        });
 
-    Multihash::ConstIterator Multihash::digest() const {
-        auto [fn, len_it] = make_varint(buf.cbegin(), buf.cend());
-        auto [len, digest_it] = make_varint(len_it, buf.cend());
-        return digest_it;
+        Multihash ret;
+        ret.assign(static_cast<std::uint64_t>(HashFunction), digest.data(),
+                   size);
+        return ret;
     }
 
-    Multihash::ConstIterator Multihash::end() const { return buf.cend(); }
+    template Multihash Multihash::compute_with<Code::sha1>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::md4>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::md5>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::sha2_256>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::sha2_512>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::sha3_224>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::sha3_256>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::sha3_384>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::sha3_512>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::shake_128>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::shake_256>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::murmur3_32>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::murmur3_128>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::xxh3_64>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::xxh3_128>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::blake2b_256>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::blake2b_512>(ByteSpan);
+    template Multihash Multihash::compute_with<Code::blake2s_256>(ByteSpan);
+
+    Multihash Multihash::from_file(std::string const& path,
+                                   Varint const& protocol) {
+        std::array<std::uint8_t, max_digest_size> digest;
+        auto size = hash(protocol, [&](auto& hasher) {
+            File::for_each_chunk(path,
+                                 [&](std::uint8_t const* data,
+                                     std::size_t count) {
+                                     hasher.update(data, count);
+                                 });
+            hasher.final(digest.data());
+            return hasher.size();
+        });
+
+        Multihash ret;
+        ret.assign(protocol, digest.data(), size);
+        return ret;
+    }
+
+    /** @throw std::out_of_range if protocol isn't in multicodec table */
+    Multihash Multihash::from_file(std::string const& path,
+                                   std::string const& protocol) {
+        return from_file(path, Multicodec::code(protocol));
+    }
+
+    void Multihash::assign(std::uint64_t func_code, std::uint8_t const* digest,
+                           std::size_t size) {
+        std::array<std::uint8_t, 2 * varint_max_size> header;
+        auto const code_size = encode_varint(func_code, header.data());
+        auto const header_size =
+            code_size + encode_varint(size, header.data() + code_size);
+
+        auto out = storage.assign(header_size + size);
+        out = std::copy_n(header.data(), header_size, out);
+        std::copy_n(digest, size, out);
+
+        code = func_code;
+        storage.header.digest_offset = header_size;
+    }
+
+    Multihash::Multihash(Multihash const& other) = default;
+
+    Multihash::Multihash(Multihash&& other) noexcept
+        : code(std::exchange(other.code, 0))
+        , storage(std::move(other.storage)) {}
+
+    Multihash& Multihash::operator=(Multihash const& other) {
+        // copy first, so a failed allocation leaves this untouched
+        if (this != &other)
+            *this = Multihash{other};
+
+        return *this;
+    }
+
+    Multihash& Multihash::operator=(Multihash&& other) noexcept {
+        if (this != &other) {
+            code = std::exchange(other.code, 0);
+            storage = std::move(other.storage);
+        }
+
+        return *this;
+    }
+
+    Multihash::~Multihash() = default;
+
+    void Multihash::parse_header() {
+        auto const begin = data();
+        auto const end = begin + storage.size();
+
+        std::uint64_t digest_len{};
+        auto const code_size = decode_varint(begin, end, code);
+        auto const len_size =
+            code_size ? decode_varint(begin + code_size, end, digest_len) : 0;
+
+        if (len_size == 0 ||
+            digest_len != storage.size() - code_size - len_size) {
+            code = 0;
+            storage.clear();
+            throw std::invalid_argument("invalid multihash");
+        }
+
+        storage.header.digest_offset = code_size + len_size;
+    }
+
+    bool Multihash::verify(ByteSpan data) const {
+        std::array<std::uint8_t, max_digest_size> computed;
+        auto const size =
+            hash_fragments(code, std::array{data}, computed.data());
+
+        // an empty digest is a prefix of anything, so it proves nothing
+        return len() != 0 && len() <= size &&
+               std::equal(digest(), end(), computed.cbegin());
+    }
+
+    /**
+     * Workers, the calling thread among them, claim chunks of pairs from a
+     * shared counter so a few large blocks can't leave the others idle */
+    std::vector<bool>
+    Multihash::verify_batch(Span<ByteSpan const> data,
+                            Span<Multihash const> multihashes) {
+        if (data.size() != multihashes.size())
+            throw std::invalid_argument(
+                "data and multihashes differ in length");
+
+        if (data.empty())
+            return {};
+
+        constexpr std::size_t chunk = 16;
+        std::vector<std::uint8_t> failed(data.size());
+        std::atomic<std::size_t> next{};
+        auto work = [&] {
+            for (auto begin = next.fetch_add(chunk); begin < data.size();
+                 begin = next.fetch_add(chunk)) {
+                auto const end = std::min(begin + chunk, data.size());
+                for (auto i = begin; i < end; ++i) {
+                    try {
+                        failed[i] = !multihashes[i].verify(data[i]);
+                    } catch (std::invalid_argument const&) {
+                        failed[i] = true;
+                    }
+                }
+            }
+        };
+
+        // anything else, such as a digest failing in OpenSSL, stops the
+        // batch and is rethrown once no helper touches this frame
+        std::mutex error_mutex;
+        std::exception_ptr error;
+        auto run = [&] {
+            try {
+                work();
+            } catch (...) {
+                next = data.size();
+                std::lock_guard lock{error_mutex};
+                if (!error)
+                    error = std::current_exception();
+            }
+        };
+
+        // a worker waiting on its own pool could wait forever, so a nested
+        // call does all the work itself
+        auto& pool = verify_pool();
+        auto const helpers =
+            on_verify_pool
+                ? 0
+                : std::min(pool.size(), (data.size() + chunk - 1) / chunk) - 1;
+        WaitGroup group;
+        for (std::size_t i = 0; i < helpers; ++i)
+            pool.submit(group, [&] {
+                on_verify_pool = true;
+                run();
+            });
+
+        run();
+        group.wait();
+        if (error)
+            std::rethrow_exception(error);
+
+        return {failed.cbegin(), failed.cend()};
+    }
+
+    bool Multihash::operator==(Multihash const& other) const {
+        return size() == other.size() &&
+               std::equal(begin(), end(), other.begin());
+    }
+
+    Multihasher::Multihasher(Varint const& protocol)
+        : impl(hash(protocol,
+                    [](auto& hasher) -> std::unique_ptr<Impl> {
+                        using Hasher = std::decay_t<decltype(hasher)>;
+                        return std::make_unique<StreamingHasher<Hasher>>(
+                            std::move(hasher));
+                    }))
+        , code(protocol) {}
+
+    Multihasher::Multihasher(std::string const& protocol)
+        : Multihasher(Multicodec::code(protocol)) {}
+
+    Multihasher::Multihasher(Multihasher&& other) noexcept = default;
+    Multihasher& Multihasher::operator=(Multihasher&& other) noexcept = default;
+    Multihasher::~Multihasher() = default;
+
+    void Multihasher::update(ByteSpan data) {
+        impl->update(data.data(), data.size());
+    }
+
+    Multihash Multihasher::finish() {
+        std::array<std::uint8_t, max_digest_size> digest;
+        auto size = impl->final(digest.data());
+
+        Multihash ret;
+        ret.assign(code, digest.data(), size);
+        return ret;
+    }
 } // namespace Multiformats
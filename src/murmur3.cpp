@@ -0,0 +1,177 @@
+// MurmurHash3 -- fast non-cryptographic hashing for indexing
+//
+// File Name: murmur3.cpp
+// Date: 2026-10-18
+
+#include "murmur3.hpp"
+
+#include "endian.hpp"
+
+#include <algorithm>
+
+#include <cstring>
+
+namespace {
+    using namespace Multiformats::Endian;
+
+    constexpr std::uint32_t c1_32{0xcc9e2d51};
+    constexpr std::uint32_t c2_32{0x1b873593};
+    constexpr std::uint64_t c1_64{0x87c37b91114253d5};
+    constexpr std::uint64_t c2_64{0x4cf5ad432745937f};
+
+    constexpr std::uint32_t rotl32(std::uint32_t x, int r) {
+        return (x << r) | (x >> (32 - r));
+    }
+
+    constexpr std::uint64_t rotl64(std::uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    constexpr std::uint32_t fmix32(std::uint32_t h) {
+        h ^= h >> 16;
+        h *= 0x85ebca6b;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35;
+        h ^= h >> 16;
+        return h;
+    }
+
+    constexpr std::uint64_t fmix64(std::uint64_t k) {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccd;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53;
+        k ^= k >> 33;
+        return k;
+    }
+
+    constexpr std::uint32_t mix_k1(std::uint32_t k1) {
+        return rotl32(k1 * c1_32, 15) * c2_32;
+    }
+
+    constexpr std::uint64_t mix_k1(std::uint64_t k1) {
+        return rotl64(k1 * c1_64, 31) * c2_64;
+    }
+
+    constexpr std::uint64_t mix_k2(std::uint64_t k2) {
+        return rotl64(k2 * c2_64, 33) * c1_64;
+    }
+
+    void body32(std::uint32_t& h1, std::uint8_t const* data,
+                std::size_t blocks) {
+        for (std::size_t i = 0; i < blocks; ++i, data += 4) {
+            h1 ^= mix_k1(load_le32(data));
+            h1 = rotl32(h1, 13) * 5 + 0xe6546b64;
+        }
+    }
+
+    void body128(std::uint64_t& h1, std::uint64_t& h2,
+                 std::uint8_t const* data, std::size_t blocks) {
+        for (std::size_t i = 0; i < blocks; ++i, data += 16) {
+            h1 ^= mix_k1(load_le64(data));
+            h1 = (rotl64(h1, 27) + h2) * 5 + 0x52dce729;
+
+            h2 ^= mix_k2(load_le64(data + 8));
+            h2 = (rotl64(h2, 31) + h1) * 5 + 0x38495ab5;
+        }
+    }
+
+    /**
+     * Top up the partial block from data, then run every whole block
+     * straight from the input, buffering what is left over
+     */
+    template <std::size_t BlockSize, typename Body>
+    void absorb(std::uint8_t* buf, std::size_t& buf_len,
+                std::uint8_t const* data, std::size_t size, Body&& body) {
+        if (size == 0)
+            return;
+
+        if (buf_len != 0) {
+            auto fill = std::min(BlockSize - buf_len, size);
+            std::memcpy(buf + buf_len, data, fill);
+            buf_len += fill;
+            data += fill;
+            size -= fill;
+
+            if (buf_len < BlockSize)
+                return;
+
+            body(buf, 1);
+            buf_len = 0;
+        }
+
+        body(data, size / BlockSize);
+        data += size / BlockSize * BlockSize;
+        buf_len = size % BlockSize;
+        std::memcpy(buf, data, buf_len);
+    }
+} // namespace
+
+namespace Multiformats::Murmur3 {
+    void Hasher32::reset() {
+        h1 = 0;
+        buf_len = 0;
+        total_len = 0;
+    }
+
+    void Hasher32::update(std::uint8_t const* data, std::size_t size) {
+        total_len += size;
+        absorb<block_size>(buf.data(), buf_len, data, size,
+                           [&](std::uint8_t const* blocks, std::size_t count) {
+                               body32(h1, blocks, count);
+                           });
+    }
+
+    void Hasher32::final(std::uint8_t* out) {
+        std::uint32_t k1{};
+        for (auto i = buf_len; i-- > 0;)
+            k1 = (k1 << 8) | buf[i];
+
+        auto h = h1;
+        if (buf_len != 0)
+            h ^= mix_k1(k1);
+
+        // the reference hashes the length as a 32 bit int
+        h ^= static_cast<std::uint32_t>(total_len);
+        store_be32(out, fmix32(h));
+    }
+
+    void Hasher128::reset() {
+        h1 = 0;
+        h2 = 0;
+        buf_len = 0;
+        total_len = 0;
+    }
+
+    void Hasher128::update(std::uint8_t const* data, std::size_t size) {
+        total_len += size;
+        absorb<block_size>(buf.data(), buf_len, data, size,
+                           [&](std::uint8_t const* blocks, std::size_t count) {
+                               body128(h1, h2, blocks, count);
+                           });
+    }
+
+    void Hasher128::final(std::uint8_t* out) {
+        std::array<std::uint8_t, block_size> tail{};
+        std::memcpy(tail.data(), buf.data(), buf_len);
+
+        auto a = h1;
+        auto b = h2;
+        if (buf_len > 8)
+            b ^= mix_k2(load_le64(tail.data() + 8));
+        if (buf_len != 0)
+            a ^= mix_k1(load_le64(tail.data()));
+
+        a ^= total_len;
+        b ^= total_len;
+        a += b;
+        b += a;
+        a = fmix64(a);
+        b = fmix64(b);
+        a += b;
+        b += a;
+
+        store_be64(out, a);
+        store_be64(out + 8, b);
+    }
+} // namespace Multiformats::Murmur3
@@ -0,0 +1,74 @@
+/**
+ * MurmurHash3 -- fast non-cryptographic hashing for indexing
+ *
+ * @file murmur3.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <array>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats::Murmur3 {
+    /**
+     * @brief Incremental MurmurHash3_x86_32 with seed 0
+     *
+     * The digest is the 32 bit result in big endian order.
+     */
+    class Hasher32 {
+        std::uint32_t h1;
+        std::array<std::uint8_t, 4> buf{};
+        std::size_t buf_len{};
+        std::uint64_t total_len{};
+
+      public:
+        static constexpr std::size_t block_size = 4;
+
+        Hasher32() { reset(); }
+
+        /** @brief Absorb more input */
+        void update(std::uint8_t const* data, std::size_t size);
+
+        /** @brief Finish hashing, writes size() bytes to out */
+        void final(std::uint8_t* out);
+
+        /** @brief Start a new digest */
+        void reset();
+
+        /** @brief Digest length in bytes */
+        std::size_t size() const { return 4; }
+    };
+
+    /**
+     * @brief Incremental MurmurHash3_x64_128 with seed 0
+     *
+     * The digest is h1 followed by h2, each in big endian order.
+     */
+    class Hasher128 {
+        std::uint64_t h1;
+        std::uint64_t h2;
+        std::array<std::uint8_t, 16> buf{};
+        std::size_t buf_len{};
+        std::uint64_t total_len{};
+
+      public:
+        static constexpr std::size_t block_size = 16;
+
+        Hasher128() { reset(); }
+
+        /** @brief Absorb more input */
+        void update(std::uint8_t const* data, std::size_t size);
+
+        /** @brief Finish hashing, writes size() bytes to out */
+        void final(std::uint8_t* out);
+
+        /** @brief Start a new digest */
+        void reset();
+
+        /** @brief Digest length in bytes */
+        std::size_t size() const { return 16; }
+    };
+} // namespace Multiformats::Murmur3
@@ -0,0 +1,60 @@
+/**
+ * Lock striping for the concurrent containers
+ *
+ * @file sharded.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <memory>
+#include <shared_mutex>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats {
+    /**
+     * @brief A power of two of shards, each behind its own lock
+     *
+     * @tparam Data members of one shard, guarded by its mutex
+     */
+    template <typename Data>
+    class Sharded {
+      public:
+        // on its own cache line, so locking one shard doesn't slow its
+        // neighbours
+        struct alignas(64) Shard : Data {
+            mutable std::shared_mutex mutex;
+        };
+
+      private:
+        std::unique_ptr<Shard[]> shards;
+        unsigned bits{};
+
+      public:
+        /** @param count minimum number of shards, rounded up to a power of
+         * two */
+        explicit Sharded(std::size_t count) {
+            while ((std::size_t{1} << bits) < count)
+                ++bits;
+
+            shards = std::make_unique<Shard[]>(std::size_t{1} << bits);
+        }
+
+        std::size_t count() const { return std::size_t{1} << bits; }
+
+        Shard& operator[](std::size_t index) const { return shards[index]; }
+
+        /** @brief Pick a shard with the high bits of the spread hash, the
+         * set buckets use the low ones */
+        Shard& pick(std::size_t hash) const {
+            if (bits == 0)
+                return shards[0];
+
+            auto const spread =
+                static_cast<std::uint64_t>(hash) * 0x9e3779b97f4a7c15;
+            return shards[spread >> (64 - bits)];
+        }
+    };
+} // namespace Multiformats
@@ -0,0 +1,141 @@
+/**
+ * Fixed size pool of worker threads
+ *
+ * @file thread_pool.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <cstddef>
+
+namespace Multiformats {
+    /**
+     * @brief Block until the tasks it counts have called done()
+     *
+     * Tasks refer to the frame that submitted them, so the destructor waits
+     * too: a throw between submitting and wait() can't unwind that frame
+     * under them. Declare it after whatever its tasks use.
+     */
+    class WaitGroup {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t pending{};
+
+      public:
+        WaitGroup() = default;
+        WaitGroup(WaitGroup const&) = delete;
+        WaitGroup& operator=(WaitGroup const&) = delete;
+        ~WaitGroup() { wait(); }
+
+        /** @brief Expect one more call to done() */
+        void add() {
+            std::lock_guard lock{mutex};
+            ++pending;
+        }
+
+        void done() {
+            std::lock_guard lock{mutex};
+            if (--pending == 0)
+                cv.notify_all();
+        }
+
+        void wait() {
+            std::unique_lock lock{mutex};
+            cv.wait(lock, [&] { return pending == 0; });
+        }
+    };
+
+    /** @brief Worker threads pulling tasks from one FIFO queue */
+    class ThreadPool {
+        std::vector<std::thread> threads;
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool stopping{};
+
+        void work() {
+            for (;;) {
+                std::function<void()> task;
+                {
+                    std::unique_lock lock{mutex};
+                    cv.wait(lock, [&] { return stopping || !tasks.empty(); });
+                    if (tasks.empty())
+                        return;
+
+                    task = std::move(tasks.front());
+                    tasks.pop_front();
+                }
+
+                task();
+            }
+        }
+
+      public:
+        /** @param count number of threads, 0 picks one per hardware thread */
+        explicit ThreadPool(std::size_t count = 0) {
+            if (count == 0)
+                count = std::max(1u, std::thread::hardware_concurrency());
+
+            threads.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+                threads.emplace_back([this] { work(); });
+        }
+
+        ThreadPool(ThreadPool const&) = delete;
+        ThreadPool& operator=(ThreadPool const&) = delete;
+
+        /** @brief Runs every queued task, then joins */
+        ~ThreadPool() {
+            {
+                std::lock_guard lock{mutex};
+                stopping = true;
+            }
+            cv.notify_all();
+
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        /** @brief Queue a task, tasks must not throw */
+        void submit(std::function<void()> task) {
+            {
+                std::lock_guard lock{mutex};
+                tasks.push_back(std::move(task));
+            }
+            cv.notify_one();
+        }
+
+        /**
+         * @brief Queue a task that calls group.done() when it returns,
+         * tasks must not throw
+         *
+         * group counts the task only once it is queued, so if this throws,
+         * waiting on group still returns once the earlier tasks have run */
+        template <typename Task>
+        void submit(WaitGroup& group, Task task) {
+            std::function<void()> counted{
+                [&group, task = std::move(task)]() mutable {
+                    task();
+                    group.done();
+                }};
+            {
+                std::lock_guard lock{mutex};
+                tasks.push_back(std::move(counted));
+                group.add();
+            }
+            cv.notify_one();
+        }
+
+        std::size_t size() const { return threads.size(); }
+    };
+
+} // namespace Multiformats
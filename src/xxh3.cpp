@@ -0,0 +1,570 @@
+// XXH3 -- fast non-cryptographic hashing for indexing
+//
+// File Name: xxh3.cpp
+// Date: 2026-10-18
+
+#include "xxh3.hpp"
+
+#include "endian.hpp"
+
+#include <stdexcept>
+
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MULTIFORMATS_XXH3_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    using namespace Multiformats::Endian;
+    using Multiformats::Xxh3::Hasher;
+
+    constexpr std::uint32_t prime32_1{0x9e3779b1};
+    constexpr std::uint32_t prime32_2{0x85ebca77};
+    constexpr std::uint32_t prime32_3{0xc2b2ae3d};
+    constexpr std::uint64_t prime64_1{0x9e3779b185ebca87};
+    constexpr std::uint64_t prime64_2{0xc2b2ae3d27d4eb4f};
+    constexpr std::uint64_t prime64_3{0x165667b19e3779f9};
+    constexpr std::uint64_t prime64_4{0x85ebca77c2b2ae63};
+    constexpr std::uint64_t prime64_5{0x27d4eb2f165667c5};
+    constexpr std::uint64_t prime_mx1{0x165667919e3779f9};
+    constexpr std::uint64_t prime_mx2{0x9fb21c651e98df25};
+
+    alignas(64) constexpr std::uint8_t secret[192]{
+        0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c,
+        0xf7, 0x21, 0xad, 0x1c, 0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb,
+        0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f, 0xcb, 0x79, 0xe6, 0x4e,
+        0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+        0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6,
+        0x81, 0x3a, 0x26, 0x4c, 0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb,
+        0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3, 0x71, 0x64, 0x48, 0x97,
+        0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+        0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7,
+        0xc7, 0x0b, 0x4f, 0x1d, 0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31,
+        0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64, 0xea, 0xc5, 0xac, 0x83,
+        0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+        0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26,
+        0x29, 0xd4, 0x68, 0x9e, 0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc,
+        0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce, 0x45, 0xcb, 0x3a, 0x8f,
+        0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e};
+
+    constexpr std::size_t secret_size = sizeof(secret);
+    constexpr std::size_t secret_size_min = 136;
+    constexpr std::size_t secret_consume_rate = 8;
+    constexpr std::size_t secret_limit = secret_size - Hasher::stripe_size;
+    constexpr std::size_t stripes_per_block = secret_limit / secret_consume_rate;
+    constexpr std::size_t secret_lastacc_start = 7;
+    constexpr std::size_t secret_mergeaccs_start = 11;
+    constexpr std::size_t midsize_max = 240;
+    constexpr std::size_t midsize_start_offset = 3;
+    constexpr std::size_t midsize_last_offset = 17;
+
+    constexpr std::array<std::uint64_t, 8> init_acc{
+        prime32_3, prime64_1, prime64_2, prime64_3,
+        prime64_4, prime32_2, prime64_5, prime32_1};
+
+    struct U128 {
+        std::uint64_t low;
+        std::uint64_t high;
+    };
+
+    U128 mult64to128(std::uint64_t lhs, std::uint64_t rhs) {
+#ifdef __SIZEOF_INT128__
+        auto const product = static_cast<unsigned __int128>(lhs) * rhs;
+        return {static_cast<std::uint64_t>(product),
+                static_cast<std::uint64_t>(product >> 64)};
+#else
+        std::uint64_t const lo_lo = (lhs & 0xffffffff) * (rhs & 0xffffffff);
+        std::uint64_t const hi_lo = (lhs >> 32) * (rhs & 0xffffffff);
+        std::uint64_t const lo_hi = (lhs & 0xffffffff) * (rhs >> 32);
+        std::uint64_t const hi_hi = (lhs >> 32) * (rhs >> 32);
+        std::uint64_t const cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+        return {(cross << 32) | (lo_lo & 0xffffffff),
+                (hi_lo >> 32) + (cross >> 32) + hi_hi};
+#endif
+    }
+
+    std::uint64_t mul128_fold64(std::uint64_t lhs, std::uint64_t rhs) {
+        auto const product = mult64to128(lhs, rhs);
+        return product.low ^ product.high;
+    }
+
+    constexpr std::uint64_t mult32to64(std::uint64_t lhs, std::uint64_t rhs) {
+        return (lhs & 0xffffffff) * (rhs & 0xffffffff);
+    }
+
+    constexpr std::uint32_t rotl32(std::uint32_t x, int r) {
+        return (x << r) | (x >> (32 - r));
+    }
+
+    constexpr std::uint64_t rotl64(std::uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    constexpr std::uint64_t xorshift64(std::uint64_t v, int shift) {
+        return v ^ (v >> shift);
+    }
+
+    constexpr std::uint64_t xxh64_avalanche(std::uint64_t h) {
+        h ^= h >> 33;
+        h *= prime64_2;
+        h ^= h >> 29;
+        h *= prime64_3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    constexpr std::uint64_t avalanche(std::uint64_t h) {
+        return xorshift64(xorshift64(h, 37) * prime_mx1, 32);
+    }
+
+    constexpr std::uint64_t rrmxmx(std::uint64_t h, std::uint64_t len) {
+        h ^= rotl64(h, 49) ^ rotl64(h, 24);
+        h *= prime_mx2;
+        h ^= (h >> 35) + len;
+        h *= prime_mx2;
+        return xorshift64(h, 28);
+    }
+
+    std::uint64_t secret64(std::size_t offset) {
+        return load_le64(secret + offset);
+    }
+
+    std::uint64_t mix16(std::uint8_t const* input, std::uint8_t const* key,
+                        std::uint64_t seed = 0) {
+        return mul128_fold64(load_le64(input) ^ (load_le64(key) + seed),
+                             load_le64(input + 8) ^ (load_le64(key + 8) - seed));
+    }
+
+    // inputs of up to 240 bytes are hashed in one go, never accumulated
+
+    std::uint64_t short64(std::uint8_t const* input, std::size_t len) {
+        if (len == 0)
+            return xxh64_avalanche(secret64(56) ^ secret64(64));
+
+        if (len <= 3) {
+            std::uint32_t const combined =
+                (std::uint32_t{input[0]} << 16) |
+                (std::uint32_t{input[len >> 1]} << 24) | input[len - 1] |
+                (static_cast<std::uint32_t>(len) << 8);
+            std::uint64_t const bitflip =
+                load_le32(secret) ^ load_le32(secret + 4);
+            return xxh64_avalanche(combined ^ bitflip);
+        }
+
+        if (len <= 8) {
+            std::uint64_t const input64 =
+                load_le32(input + len - 4) +
+                (std::uint64_t{load_le32(input)} << 32);
+            return rrmxmx(input64 ^ (secret64(8) ^ secret64(16)), len);
+        }
+
+        if (len <= 16) {
+            auto const lo = load_le64(input) ^ (secret64(24) ^ secret64(32));
+            auto const hi =
+                load_le64(input + len - 8) ^ (secret64(40) ^ secret64(48));
+            return avalanche(len + bswap64(lo) + hi + mul128_fold64(lo, hi));
+        }
+
+        std::uint64_t acc = len * prime64_1;
+        if (len <= 128) {
+            if (len > 32) {
+                if (len > 64) {
+                    if (len > 96) {
+                        acc += mix16(input + 48, secret + 96);
+                        acc += mix16(input + len - 64, secret + 112);
+                    }
+                    acc += mix16(input + 32, secret + 64);
+                    acc += mix16(input + len - 48, secret + 80);
+                }
+                acc += mix16(input + 16, secret + 32);
+                acc += mix16(input + len - 32, secret + 48);
+            }
+            acc += mix16(input, secret);
+            acc += mix16(input + len - 16, secret + 16);
+            return avalanche(acc);
+        }
+
+        for (std::size_t i = 0; i < 8; ++i)
+            acc += mix16(input + 16 * i, secret + 16 * i);
+
+        auto acc_end = mix16(input + len - 16,
+                             secret + secret_size_min - midsize_last_offset);
+        acc = avalanche(acc);
+        for (std::size_t i = 8; i < len / 16; ++i)
+            acc_end += mix16(input + 16 * i,
+                             secret + 16 * (i - 8) + midsize_start_offset);
+
+        return avalanche(acc + acc_end);
+    }
+
+    U128 mix32(U128 acc, std::uint8_t const* input_1,
+               std::uint8_t const* input_2, std::uint8_t const* key,
+               std::uint64_t seed) {
+        acc.low += mix16(input_1, key, seed);
+        acc.low ^= load_le64(input_2) + load_le64(input_2 + 8);
+        acc.high += mix16(input_2, key + 16, seed);
+        acc.high ^= load_le64(input_1) + load_le64(input_1 + 8);
+        return acc;
+    }
+
+    U128 finish_mid128(U128 acc, std::size_t len) {
+        U128 h;
+        h.low = avalanche(acc.low + acc.high);
+        h.high = 0 - avalanche(acc.low * prime64_1 + acc.high * prime64_4 +
+                               len * prime64_2);
+        return h;
+    }
+
+    U128 short128(std::uint8_t const* input, std::size_t len) {
+        if (len == 0)
+            return {xxh64_avalanche(secret64(64) ^ secret64(72)),
+                    xxh64_avalanche(secret64(80) ^ secret64(88))};
+
+        if (len <= 3) {
+            std::uint32_t const combined_lo =
+                (std::uint32_t{input[0]} << 16) |
+                (std::uint32_t{input[len >> 1]} << 24) | input[len - 1] |
+                (static_cast<std::uint32_t>(len) << 8);
+            std::uint32_t const combined_hi = rotl32(bswap32(combined_lo), 13);
+            std::uint64_t const bitflip_lo =
+                load_le32(secret) ^ load_le32(secret + 4);
+            std::uint64_t const bitflip_hi =
+                load_le32(secret + 8) ^ load_le32(secret + 12);
+            return {xxh64_avalanche(combined_lo ^ bitflip_lo),
+                    xxh64_avalanche(combined_hi ^ bitflip_hi)};
+        }
+
+        if (len <= 8) {
+            std::uint64_t const input64 =
+                load_le32(input) +
+                (std::uint64_t{load_le32(input + len - 4)} << 32);
+            auto const keyed = input64 ^ (secret64(16) ^ secret64(24));
+            auto m = mult64to128(keyed, prime64_1 + (len << 2));
+            m.high += m.low << 1;
+            m.low ^= m.high >> 3;
+            m.low = xorshift64(m.low, 35);
+            m.low *= prime_mx2;
+            m.low = xorshift64(m.low, 28);
+            m.high = avalanche(m.high);
+            return m;
+        }
+
+        if (len <= 16) {
+            auto const bitflip_lo = secret64(32) ^ secret64(40);
+            auto const bitflip_hi = secret64(48) ^ secret64(56);
+            auto const input_lo = load_le64(input);
+            auto input_hi = load_le64(input + len - 8);
+            auto m = mult64to128(input_lo ^ input_hi ^ bitflip_lo, prime64_1);
+            m.low += static_cast<std::uint64_t>(len - 1) << 54;
+            input_hi ^= bitflip_hi;
+            m.high += input_hi + mult32to64(input_hi, prime32_2 - 1);
+            m.low ^= bswap64(m.high);
+
+            auto h = mult64to128(m.low, prime64_2);
+            h.high += m.high * prime64_2;
+            return {avalanche(h.low), avalanche(h.high)};
+        }
+
+        U128 acc{len * prime64_1, 0};
+        if (len <= 128) {
+            if (len > 32) {
+                if (len > 64) {
+                    if (len > 96)
+                        acc = mix32(acc, input + 48, input + len - 64,
+                                    secret + 96, 0);
+                    acc = mix32(acc, input + 32, input + len - 48, secret + 64,
+                                0);
+                }
+                acc = mix32(acc, input + 16, input + len - 32, secret + 32, 0);
+            }
+            acc = mix32(acc, input, input + len - 16, secret, 0);
+            return finish_mid128(acc, len);
+        }
+
+        for (std::size_t i = 32; i < 160; i += 32)
+            acc = mix32(acc, input + i - 32, input + i - 16, secret + i - 32,
+                        0);
+
+        acc.low = avalanche(acc.low);
+        acc.high = avalanche(acc.high);
+        for (std::size_t i = 160; i <= len; i += 32)
+            acc = mix32(acc, input + i - 32, input + i - 16,
+                        secret + midsize_start_offset + i - 160, 0);
+
+        acc = mix32(acc, input + len - 16, input + len - 32,
+                    secret + secret_size_min - midsize_last_offset - 16, 0);
+        return finish_mid128(acc, len);
+    }
+
+    // long inputs: 8 lanes of accumulators, one 64 byte stripe at a time,
+    // with a scramble of the lanes after every block of stripes
+
+    [[maybe_unused]] void accumulate_portable(std::uint64_t* acc, std::uint8_t const* input,
+                             std::uint8_t const* key, std::size_t stripes) {
+        for (std::size_t n = 0; n < stripes; ++n) {
+            auto const* in = input + n * Hasher::stripe_size;
+            auto const* k = key + n * secret_consume_rate;
+            for (std::size_t i = 0; i < 8; ++i) {
+                auto const data = load_le64(in + 8 * i);
+                auto const data_key = data ^ load_le64(k + 8 * i);
+                acc[i ^ 1] += data;
+                acc[i] += mult32to64(data_key, data_key >> 32);
+            }
+        }
+    }
+
+    [[maybe_unused]] void scramble_portable(std::uint64_t* acc, std::uint8_t const* key) {
+        for (std::size_t i = 0; i < 8; ++i)
+            acc[i] = (xorshift64(acc[i], 47) ^ load_le64(key + 8 * i)) *
+                     prime32_1;
+    }
+
+#ifdef MULTIFORMATS_XXH3_X86
+    void accumulate_sse2(std::uint64_t* acc, std::uint8_t const* input,
+                         std::uint8_t const* key, std::size_t stripes) {
+        __m128i a[4];
+        for (std::size_t i = 0; i < 4; ++i)
+            a[i] = _mm_loadu_si128(reinterpret_cast<__m128i const*>(acc) + i);
+
+        for (std::size_t n = 0; n < stripes; ++n) {
+            auto const* in = reinterpret_cast<__m128i const*>(
+                input + n * Hasher::stripe_size);
+            auto const* k = reinterpret_cast<__m128i const*>(
+                key + n * secret_consume_rate);
+            for (std::size_t i = 0; i < 4; ++i) {
+                auto const data = _mm_loadu_si128(in + i);
+                auto const data_key = _mm_xor_si128(data, _mm_loadu_si128(k + i));
+                auto const product = _mm_mul_epu32(
+                    data_key, _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+                auto const swapped =
+                    _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                a[i] = _mm_add_epi64(product, _mm_add_epi64(a[i], swapped));
+            }
+        }
+
+        for (std::size_t i = 0; i < 4; ++i)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(acc) + i, a[i]);
+    }
+
+    void scramble_sse2(std::uint64_t* acc, std::uint8_t const* key) {
+        auto const prime = _mm_set1_epi32(static_cast<int>(prime32_1));
+        for (std::size_t i = 0; i < 4; ++i) {
+            auto* lane = reinterpret_cast<__m128i*>(acc) + i;
+            auto a = _mm_loadu_si128(lane);
+            a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+            a = _mm_xor_si128(
+                a, _mm_loadu_si128(reinterpret_cast<__m128i const*>(key) + i));
+            auto const lo = _mm_mul_epu32(a, prime);
+            auto const hi = _mm_mul_epu32(
+                _mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+            _mm_storeu_si128(lane, _mm_add_epi64(lo, _mm_slli_epi64(hi, 32)));
+        }
+    }
+
+    __attribute__((target("avx2"))) void
+    accumulate_avx2(std::uint64_t* acc, std::uint8_t const* input,
+                    std::uint8_t const* key, std::size_t stripes) {
+        __m256i a[2];
+        for (std::size_t i = 0; i < 2; ++i)
+            a[i] =
+                _mm256_loadu_si256(reinterpret_cast<__m256i const*>(acc) + i);
+
+        for (std::size_t n = 0; n < stripes; ++n) {
+            auto const* in = reinterpret_cast<__m256i const*>(
+                input + n * Hasher::stripe_size);
+            auto const* k = reinterpret_cast<__m256i const*>(
+                key + n * secret_consume_rate);
+            for (std::size_t i = 0; i < 2; ++i) {
+                auto const data = _mm256_loadu_si256(in + i);
+                auto const data_key =
+                    _mm256_xor_si256(data, _mm256_loadu_si256(k + i));
+                auto const product = _mm256_mul_epu32(
+                    data_key,
+                    _mm256_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+                auto const swapped =
+                    _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                a[i] =
+                    _mm256_add_epi64(product, _mm256_add_epi64(a[i], swapped));
+            }
+        }
+
+        for (std::size_t i = 0; i < 2; ++i)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc) + i, a[i]);
+    }
+
+    __attribute__((target("avx2"))) void
+    scramble_avx2(std::uint64_t* acc, std::uint8_t const* key) {
+        auto const prime = _mm256_set1_epi32(static_cast<int>(prime32_1));
+        for (std::size_t i = 0; i < 2; ++i) {
+            auto* lane = reinterpret_cast<__m256i*>(acc) + i;
+            auto a = _mm256_loadu_si256(lane);
+            a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+            a = _mm256_xor_si256(
+                a,
+                _mm256_loadu_si256(reinterpret_cast<__m256i const*>(key) + i));
+            auto const lo = _mm256_mul_epu32(a, prime);
+            auto const hi = _mm256_mul_epu32(
+                _mm256_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+            _mm256_storeu_si256(lane,
+                                _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32)));
+        }
+    }
+#endif
+
+    struct Kernels {
+        Hasher::Accumulate accumulate;
+        Hasher::Scramble scramble;
+    };
+
+    Kernels select_kernels() {
+#ifdef MULTIFORMATS_XXH3_X86
+        if (__builtin_cpu_supports("avx2"))
+            return {accumulate_avx2, scramble_avx2};
+
+        return {accumulate_sse2, scramble_sse2};
+#else
+        return {accumulate_portable, scramble_portable};
+#endif
+    }
+
+    Kernels const& kernels() {
+        static auto const impl = select_kernels();
+        return impl;
+    }
+
+    std::uint64_t merge_accs(std::uint64_t const* acc, std::uint8_t const* key,
+                             std::uint64_t start) {
+        for (std::size_t i = 0; i < 4; ++i)
+            start += mul128_fold64(acc[2 * i] ^ load_le64(key + 16 * i),
+                                   acc[2 * i + 1] ^ load_le64(key + 16 * i + 8));
+
+        return avalanche(start);
+    }
+} // namespace
+
+namespace Multiformats::Xxh3 {
+    Hasher::Hasher(std::size_t digest_size)
+        : digest_size(digest_size) {
+        if (digest_size != 8 && digest_size != 16)
+            throw std::invalid_argument("invalid XXH3 digest size");
+
+        reset();
+    }
+
+    void Hasher::reset() {
+        acc = init_acc;
+        buf_len = 0;
+        stripes_so_far = 0;
+        total_len = 0;
+    }
+
+    /** @brief Accumulate whole stripes, scrambling at block boundaries */
+    void Hasher::consume(std::uint64_t* acc, std::size_t& stripes_so_far,
+                         std::uint8_t const* input, std::size_t stripes) const {
+        auto const& impl = kernels();
+        auto const* key = secret + stripes_so_far * secret_consume_rate;
+        auto until_scramble = stripes_per_block - stripes_so_far;
+
+        while (stripes >= until_scramble) {
+            impl.accumulate(acc, input, key, until_scramble);
+            impl.scramble(acc, secret + secret_limit);
+            input += until_scramble * stripe_size;
+            stripes -= until_scramble;
+            until_scramble = stripes_per_block;
+            stripes_so_far = 0;
+            key = secret;
+        }
+
+        impl.accumulate(acc, input, key, stripes);
+        stripes_so_far += stripes;
+    }
+
+    /**
+     * Input is buffered until more than a buffer's worth has arrived, so
+     * short messages stay whole for the one shot paths. After that the last
+     * stripe is always held back, the final accumulation needs it.
+     */
+    void Hasher::update(std::uint8_t const* data, std::size_t size) {
+        if (size == 0)
+            return;
+
+        total_len += size;
+        if (size <= buffer_size - buf_len) {
+            std::memcpy(buf.data() + buf_len, data, size);
+            buf_len += size;
+            return;
+        }
+
+        if (buf_len != 0) {
+            auto const fill = buffer_size - buf_len;
+            std::memcpy(buf.data() + buf_len, data, fill);
+            data += fill;
+            size -= fill;
+            consume(acc.data(), stripes_so_far, buf.data(),
+                    buffer_size / stripe_size);
+            buf_len = 0;
+        }
+
+        if (size > buffer_size) {
+            auto const stripes = (size - 1) / stripe_size;
+            consume(acc.data(), stripes_so_far, data, stripes);
+            data += stripes * stripe_size;
+            size -= stripes * stripe_size;
+
+            // keep the previous stripe in case the remainder is shorter
+            std::memcpy(buf.data() + buffer_size - stripe_size,
+                        data - stripe_size, stripe_size);
+        }
+
+        std::memcpy(buf.data(), data, size);
+        buf_len = size;
+    }
+
+    void Hasher::final(std::uint8_t* out) {
+        if (total_len <= midsize_max) {
+            if (digest_size == 8) {
+                store_be64(out, short64(buf.data(), total_len));
+            } else {
+                auto const h = short128(buf.data(), total_len);
+                store_be64(out, h.high);
+                store_be64(out + 8, h.low);
+            }
+
+            return;
+        }
+
+        alignas(32) auto lanes = acc;
+        auto stripes = stripes_so_far;
+        std::array<std::uint8_t, stripe_size> last_stripe;
+        std::uint8_t const* last = last_stripe.data();
+        if (buf_len >= stripe_size) {
+            consume(lanes.data(), stripes, buf.data(),
+                    (buf_len - 1) / stripe_size);
+            last = buf.data() + buf_len - stripe_size;
+        } else {
+            auto const catchup = stripe_size - buf_len;
+            std::memcpy(last_stripe.data(),
+                        buf.data() + buffer_size - catchup, catchup);
+            std::memcpy(last_stripe.data() + catchup, buf.data(), buf_len);
+        }
+
+        kernels().accumulate(lanes.data(), last,
+                             secret + secret_limit - secret_lastacc_start, 1);
+
+        auto const low = merge_accs(lanes.data(),
+                                    secret + secret_mergeaccs_start,
+                                    total_len * prime64_1);
+        if (digest_size == 8) {
+            store_be64(out, low);
+            return;
+        }
+
+        auto const high = merge_accs(
+            lanes.data(), secret + secret_size - 64 - secret_mergeaccs_start,
+            ~(total_len * prime64_2));
+        store_be64(out, high);
+        store_be64(out + 8, low);
+    }
+} // namespace Multiformats::Xxh3
@@ -0,0 +1,63 @@
+/**
+ * XXH3 -- fast non-cryptographic hashing for indexing
+ *
+ * @file xxh3.hpp
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <array>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Multiformats::Xxh3 {
+    /**
+     * @brief Incremental XXH3 with seed 0 and the default secret
+     *
+     * Produces XXH3_64bits (8 byte digest) or XXH3_128bits (16 byte digest)
+     * in the canonical big endian form. Long inputs are accumulated a 64 byte
+     * stripe at a time; on x86-64 with AVX2 or SSE2 kernels selected once at
+     * startup.
+     */
+    class Hasher {
+      public:
+        static constexpr std::size_t stripe_size = 64;
+        static constexpr std::size_t buffer_size = 4 * stripe_size;
+
+        using Accumulate = void (*)(std::uint64_t* acc,
+                                    std::uint8_t const* input,
+                                    std::uint8_t const* secret,
+                                    std::size_t stripes);
+        using Scramble = void (*)(std::uint64_t* acc,
+                                  std::uint8_t const* secret);
+
+      private:
+        alignas(32) std::array<std::uint64_t, 8> acc;
+        std::array<std::uint8_t, buffer_size> buf;
+        std::size_t buf_len;
+        std::size_t stripes_so_far;
+        std::uint64_t total_len;
+        std::size_t digest_size;
+
+        void consume(std::uint64_t* acc, std::size_t& stripes_so_far,
+                     std::uint8_t const* input, std::size_t stripes) const;
+
+      public:
+        /** @throw std::invalid_argument if digest_size is not 8 or 16 */
+        explicit Hasher(std::size_t digest_size);
+
+        /** @brief Absorb more input */
+        void update(std::uint8_t const* data, std::size_t size);
+
+        /** @brief Finish hashing, writes size() bytes to out */
+        void final(std::uint8_t* out);
+
+        /** @brief Start a new digest of the same length */
+        void reset();
+
+        /** @brief Digest length in bytes */
+        std::size_t size() const { return digest_size; }
+    };
+} // namespace Multiformats::Xxh3
@@ -0,0 +1,141 @@
+// Tests for bulk file hashing
+//
+// File Name: bulk-hasher-test.cpp
+// Date: 2026-10-18
+
+#include "multiformats/bulk_hasher.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+
+using Multiformats::BulkHasher;
+using Multiformats::Multihash;
+
+class BulkHasherTests : public ::testing::TestWithParam<BulkHasher::Engine> {
+  protected:
+    std::vector<std::string> paths;
+
+    void SetUp() override {
+        // sizes around the read size, and an empty file
+        for (std::size_t size : {0, 1, 4095, 4096, 4097, 100000}) {
+            std::vector<char> contents(size);
+            for (std::size_t i = 0; i < size; ++i)
+                contents[i] = static_cast<char>(i * 13 + paths.size());
+
+            paths.push_back("bulk-hasher-" + std::to_string(paths.size()) +
+                            ".bin");
+            std::ofstream{paths.back(), std::ios::binary}.write(
+                contents.data(), contents.size());
+        }
+    }
+
+    void TearDown() override {
+        for (auto const& path : paths)
+            std::remove(path.c_str());
+    }
+};
+
+TEST_P(BulkHasherTests, MatchesFromFile) {
+    BulkHasher::Options options;
+    options.engine = GetParam();
+    options.queue_depth = 4;
+    options.buffer_size = 4096;
+    options.workers = 3;
+
+    std::unique_ptr<BulkHasher> hasher;
+    try {
+        hasher = std::make_unique<BulkHasher>(options);
+    } catch (std::system_error const&) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+
+    std::mutex mutex;
+    std::vector<Multihash> results(paths.size());
+    std::vector<int> calls(paths.size());
+    hasher->hash(paths, "sha2-256",
+                 [&](std::size_t index, Multihash const& multihash,
+                     std::error_code error) {
+                     std::lock_guard lock{mutex};
+                     EXPECT_FALSE(error) << error.message();
+                     results[index] = multihash;
+                     ++calls[index];
+                 });
+
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        EXPECT_EQ(calls[i], 1);
+        EXPECT_EQ(results[i], Multihash::from_file(paths[i], "sha2-256"));
+    }
+}
+
+TEST_P(BulkHasherTests, MissingFile) {
+    BulkHasher::Options options;
+    options.engine = GetParam();
+
+    std::unique_ptr<BulkHasher> hasher;
+    try {
+        hasher = std::make_unique<BulkHasher>(options);
+    } catch (std::system_error const&) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+
+    std::mutex mutex;
+    std::vector<std::error_code> errors(2);
+    hasher->hash({"does-not-exist", paths.back()}, "sha2-256",
+                 [&](std::size_t index, Multihash const&,
+                     std::error_code error) {
+                     std::lock_guard lock{mutex};
+                     errors[index] = error;
+                 });
+
+    EXPECT_EQ(errors[0], std::errc::no_such_file_or_directory);
+    EXPECT_FALSE(errors[1]);
+}
+
+TEST_P(BulkHasherTests, HashFailure) {
+    BulkHasher::Options options;
+    options.engine = GetParam();
+    options.workers = 3;
+
+    std::unique_ptr<BulkHasher> hasher;
+    try {
+        hasher = std::make_unique<BulkHasher>(options);
+    } catch (std::system_error const&) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+
+    // stands in for a digest failing on a worker
+    EXPECT_THROW(hasher->hash(paths, "sha2-256",
+                              [](std::size_t, Multihash const&,
+                                 std::error_code) {
+                                  throw std::runtime_error("hash failed");
+                              }),
+                 std::runtime_error);
+
+    // the hasher is still usable, on the same engine
+    EXPECT_EQ(hasher->engine(), GetParam());
+    std::atomic<std::size_t> calls{};
+    hasher->hash(paths, "sha2-256",
+                 [&](std::size_t, Multihash const&, std::error_code) {
+                     ++calls;
+                 });
+    EXPECT_EQ(calls, paths.size());
+}
+
+TEST_P(BulkHasherTests, NotSupported) {
+    try {
+        BulkHasher::Options options;
+        options.engine = GetParam();
+        BulkHasher hasher{options};
+        EXPECT_THROW(hasher.hash(paths, "tcp", {}), std::invalid_argument);
+    } catch (std::system_error const&) {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Engines, BulkHasherTests,
+                         ::testing::Values(BulkHasher::Engine::IoUring,
+                                           BulkHasher::Engine::ThreadPool));
@@ -0,0 +1,170 @@
+// Tests for the compact CID key
+//
+// File Name: cid-key-test.cpp
+// Date: 2026-10-18
+
+#include "multiformats/cid_key.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <cstdint>
+
+using Multiformats::Cid;
+using Multiformats::CidKey;
+using Multiformats::Multibase::Protocol;
+
+namespace {
+    std::string const encoded{
+        "zb2rhe5P4gXftAwvA4eXQ5HJwsER2owDyS9sKaQRRVQPn93bA"};
+
+    /** @brief CIDv1 of raw content with an identity multihash of size */
+    std::vector<std::uint8_t> identity_cid(std::size_t size) {
+        std::vector<std::uint8_t> ret{0x01, 0x55, 0x00};
+        ret.push_back(static_cast<std::uint8_t>(size));
+        for (std::size_t i = 0; i < size; ++i)
+            ret.push_back(static_cast<std::uint8_t>(i * 7));
+
+        return ret;
+    }
+
+    std::vector<std::uint8_t> bytes(Multiformats::ByteSpan span) {
+        return {span.begin(), span.end()};
+    }
+} // namespace
+
+TEST(CidKeyTests, FromBinary) {
+    auto const binary = Multiformats::Multibase::decode(encoded);
+    CidKey const key{binary};
+
+    EXPECT_EQ(bytes(key.to_binary()), binary);
+    EXPECT_EQ(key.version(), 1);
+    EXPECT_EQ(key.content_type(), 0x55);
+    EXPECT_EQ(bytes(key.multihash()),
+              std::vector<std::uint8_t>(binary.begin() + 2, binary.end()));
+    EXPECT_EQ(bytes(key.digest()),
+              std::vector<std::uint8_t>(binary.begin() + 4, binary.end()));
+    EXPECT_EQ(key.to_cid().to_string(Protocol::Base58Btc), encoded);
+
+    EXPECT_EQ(CidKey{Cid{encoded}}, key);
+}
+
+TEST(CidKeyTests, CidV0) {
+    auto const binary = Multiformats::Multibase::decode(encoded);
+    std::vector<std::uint8_t> const v0(binary.begin() + 2, binary.end());
+    auto v1 = binary;
+    v1[1] = 0x70;
+
+    CidKey const key{v0};
+    EXPECT_EQ(key.version(), 0);
+    EXPECT_EQ(key.content_type(), 0x70);
+    EXPECT_EQ(bytes(key.multihash()), v0);
+    EXPECT_EQ(CidKey{key.to_cid()}, key);
+    EXPECT_EQ(CidKey{Cid{v0}}, key);
+
+    // the same content, but a different CID
+    EXPECT_NE(key, CidKey{v1});
+    EXPECT_EQ(std::hash<CidKey>{}(key), std::hash<CidKey>{}(CidKey{v1}));
+}
+
+TEST(CidKeyTests, Invalid) {
+    auto const binary = Multiformats::Multibase::decode(encoded);
+
+    auto truncated = binary;
+    truncated.pop_back();
+    auto version = binary;
+    version[0] = 2;
+    std::vector<std::uint8_t> const header_only{0x01, 0x55};
+
+    for (auto const& invalid :
+         {std::vector<std::uint8_t>{}, truncated, version, header_only,
+          std::vector<std::uint8_t>(binary.begin() + 2, binary.end() - 1)})
+        EXPECT_THROW(CidKey{invalid}, std::invalid_argument);
+
+    EXPECT_THROW(CidKey{}.to_cid(), std::invalid_argument);
+    EXPECT_TRUE(CidKey{}.empty());
+    EXPECT_EQ(CidKey{}, CidKey{});
+}
+
+TEST(CidKeyTests, HeapFallback) {
+    auto const small = identity_cid(CidKey::inline_capacity - 4);
+    auto const large = identity_cid(100);
+
+    for (auto const& binary : {small, large}) {
+        CidKey key{binary};
+        EXPECT_EQ(bytes(key.to_binary()), binary);
+        EXPECT_EQ(bytes(key.digest()),
+                  std::vector<std::uint8_t>(binary.begin() + 4, binary.end()));
+
+        CidKey copy{key};
+        EXPECT_EQ(copy, key);
+        EXPECT_EQ(std::hash<CidKey>{}(copy), std::hash<CidKey>{}(key));
+
+        CidKey moved{std::move(copy)};
+        EXPECT_EQ(moved, key);
+
+        // the moved from key is empty, and hashes like one
+        EXPECT_TRUE(copy.empty());
+        EXPECT_EQ(copy, CidKey{});
+        EXPECT_EQ(std::hash<CidKey>{}(copy), std::hash<CidKey>{}(CidKey{}));
+        EXPECT_TRUE(copy.digest().empty());
+
+        CidKey assigned{Multiformats::Multibase::decode(encoded)};
+        assigned = moved;
+        EXPECT_EQ(assigned, key);
+        assigned = CidKey{small};
+        EXPECT_EQ(bytes(assigned.to_binary()), small);
+
+        EXPECT_EQ(CidKey{key.to_cid()}, key);
+    }
+}
+
+TEST(CidKeyTests, Order) {
+    std::vector<std::vector<std::uint8_t>> binaries{
+        identity_cid(3), identity_cid(1), identity_cid(2), identity_cid(80),
+        Multiformats::Multibase::decode(encoded)};
+
+    std::vector<CidKey> keys;
+    for (auto const& binary : binaries)
+        keys.emplace_back(binary);
+
+    std::sort(binaries.begin(), binaries.end());
+    std::sort(keys.begin(), keys.end());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(bytes(keys[i].to_binary()), binaries[i]) << i;
+        if (i != 0) {
+            EXPECT_LT(keys[i - 1], keys[i]);
+            EXPECT_GT(keys[i], keys[i - 1]);
+        }
+    }
+
+    EXPECT_LE(keys[0], keys[0]);
+    EXPECT_GE(keys[0], keys[0]);
+    EXPECT_EQ(keys[0].compare(keys[0]), 0);
+}
+
+TEST(CidKeyTests, HashSet) {
+    std::unordered_set<CidKey> keys;
+    std::set<std::vector<std::uint8_t>> expected;
+    for (std::size_t size = 1; size < 120; ++size) {
+        auto binary = identity_cid(size);
+        keys.emplace(binary);
+        expected.insert(binary);
+
+        // a sha2-256 multihash with the size as its first digest bytes
+        binary = Multiformats::Multibase::decode(encoded);
+        binary[4] = static_cast<std::uint8_t>(size);
+        keys.emplace(binary);
+        expected.insert(binary);
+    }
+
+    EXPECT_EQ(keys.size(), expected.size());
+    for (auto const& binary : expected)
+        EXPECT_EQ(keys.count(CidKey{binary}), 1);
+}
@@ -0,0 +1,114 @@
+// Tests for the concurrent CID set
+//
+// File Name: cid-set-test.cpp
+// Date: 2026-10-18
+
+#include "multiformats/cid_set.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <cstdint>
+
+using Multiformats::Cid;
+using Multiformats::CidKey;
+using Multiformats::CidSet;
+
+namespace {
+    /** @brief Binary CIDv1 of a raw block with a sha2-256 digest from i */
+    std::vector<std::uint8_t> synthetic_cid(std::uint32_t i) {
+        std::vector<std::uint8_t> ret{0x01, 0x55, 0x12, 0x20};
+        for (int byte = 0; byte < 32; ++byte)
+            ret.push_back(static_cast<std::uint8_t>((i * 2654435761u) >>
+                                                    (byte % 4 * 8)) ^
+                          static_cast<std::uint8_t>(byte));
+
+        return ret;
+    }
+} // namespace
+
+TEST(CidSetTests, InsertFindErase) {
+    CidSet set;
+    auto const binary = synthetic_cid(1);
+    Cid const cid{binary};
+
+    EXPECT_FALSE(set.contains(cid));
+    EXPECT_TRUE(set.insert(cid));
+    EXPECT_FALSE(set.insert(cid));
+    EXPECT_FALSE(set.insert(CidKey{binary}));
+    EXPECT_TRUE(set.contains(CidKey{binary}));
+    EXPECT_EQ(set.size(), 1);
+
+    // the CIDv0 of the same multihash is another CID
+    std::vector<std::uint8_t> const v0(binary.begin() + 2, binary.end());
+    EXPECT_FALSE(set.contains(CidKey{v0}));
+    EXPECT_TRUE(set.insert(CidKey{v0}));
+    EXPECT_EQ(set.size(), 2);
+
+    EXPECT_TRUE(set.erase(cid));
+    EXPECT_FALSE(set.erase(cid));
+    EXPECT_FALSE(set.contains(cid));
+    EXPECT_TRUE(set.contains(Cid{v0}));
+    EXPECT_EQ(set.size(), 1);
+
+    EXPECT_TRUE(set.insert(cid));
+    EXPECT_EQ(set.size(), 2);
+
+    EXPECT_THROW(CidSet{0}, std::invalid_argument);
+}
+
+TEST(CidSetTests, IdentityDigests) {
+    CidSet set{1};
+    for (std::uint8_t size = 0; size < 100; ++size) {
+        std::vector<std::uint8_t> binary{0x01, 0x55, 0x00, size};
+        binary.resize(binary.size() + size, size);
+        EXPECT_TRUE(set.insert(CidKey{binary}));
+        EXPECT_TRUE(set.contains(CidKey{binary}));
+    }
+
+    EXPECT_EQ(set.size(), 100);
+}
+
+TEST(CidSetTests, Concurrent) {
+    CidSet set{8};
+    constexpr int thread_count = 8;
+    constexpr std::uint32_t cid_count = 4000;
+
+    // every thread inserts the same CIDs in a different order, then erases
+    // the odd ones
+    std::atomic<std::uint32_t> inserted{};
+    std::atomic<std::uint32_t> erased{};
+    std::atomic<int> done_inserting{};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t] {
+            for (std::uint32_t i = 0; i < cid_count; ++i) {
+                auto const n = (i * 7 + t * 331) % cid_count;
+                if (set.insert(CidKey{synthetic_cid(n)}))
+                    ++inserted;
+            }
+
+            ++done_inserting;
+            while (done_inserting < thread_count)
+                std::this_thread::yield();
+
+            for (std::uint32_t i = 1; i < cid_count; i += 2) {
+                if (set.erase(CidKey{synthetic_cid(i)}))
+                    ++erased;
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(inserted, cid_count);
+    EXPECT_EQ(erased, cid_count / 2);
+    EXPECT_EQ(set.size(), cid_count / 2);
+    for (std::uint32_t i = 0; i < cid_count; ++i)
+        EXPECT_EQ(set.contains(CidKey{synthetic_cid(i)}), i % 2 == 0) << i;
+}
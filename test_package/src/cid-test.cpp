@@ -25,3 +25,35 @@ TEST(CidTests, Test) {
     EXPECT_EQ(cid.human_readable(Multiformats::Multibase::Protocol::Base58Btc),
               human_readable);
 }
+
+TEST(CidTests, Parse) {
+    using Multiformats::Multicodec::Code;
+
+    std::string const encoded{
+        "zb2rhe5P4gXftAwvA4eXQ5HJwsER2owDyS9sKaQRRVQPn93bA"};
+    auto const binary = Multiformats::Multibase::decode(encoded);
+
+    auto cid = Multiformats::Cid::parse<Code::raw, Code::sha2_256>(binary);
+    EXPECT_EQ(cid.to_string(Multiformats::Multibase::Protocol::Base58Btc),
+              encoded);
+
+    EXPECT_THROW((Multiformats::Cid::parse<Code::dag_pb, Code::sha2_256>(
+                     binary)),
+                 std::invalid_argument);
+    EXPECT_THROW((Multiformats::Cid::parse<Code::raw, Code::sha2_512>(binary)),
+                 std::invalid_argument);
+
+    auto truncated = binary;
+    truncated.pop_back();
+    EXPECT_THROW((Multiformats::Cid::parse<Code::raw, Code::sha2_256>(
+                     truncated)),
+                 std::invalid_argument);
+
+    // CIDv0 is the bare multihash
+    std::vector<std::uint8_t> const v0(binary.cbegin() + 2, binary.cend());
+    auto v0_cid = Multiformats::Cid::parse<Code::dag_pb, Code::sha2_256>(v0);
+    EXPECT_EQ(
+        v0_cid.human_readable(Multiformats::Multibase::Protocol::Base58Btc),
+        "base58btc - cidv0 - dag-pb - sha2-256-256-"
+        "6e6ff7950a36187a801613426e858dce686cd7d7e3c0fc42ee0330072d245c95");
+}
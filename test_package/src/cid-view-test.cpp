@@ -0,0 +1,240 @@
+// Tests for the non-owning CID parser
+//
+// File Name: cid-view-test.cpp
+// Date: 2026-10-18
+
+#include "multiformats/cid_view.hpp"
+
+#include "multiformats/cid_key.hpp"
+#include "multiformats/multibase.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+using Multiformats::CidError;
+using Multiformats::CidView;
+using Multiformats::Multibase::Protocol;
+
+namespace {
+    std::string const encoded{
+        "zb2rhe5P4gXftAwvA4eXQ5HJwsER2owDyS9sKaQRRVQPn93bA"};
+
+    std::vector<std::uint8_t> bytes(Multiformats::ByteSpan span) {
+        return {span.begin(), span.end()};
+    }
+
+    /** @brief The CIDv0 of the same multihash, as base58btc without prefix */
+    std::string v0_text() {
+        auto const binary = Multiformats::Multibase::decode(encoded);
+        return Multiformats::Multibase::encode(
+                   Protocol::Base58Btc, {binary.begin() + 2, binary.end()})
+            .substr(1);
+    }
+
+    /** @brief Parse text with a buffer as large as the text */
+    CidError parse_text(std::string const& text, CidView& out,
+                        std::vector<std::uint8_t>& buffer) {
+        buffer.assign(text.size(), 0);
+        return CidView::parse(text, buffer, out);
+    }
+} // namespace
+
+TEST(CidViewTests, Binary) {
+    auto const binary = Multiformats::Multibase::decode(encoded);
+
+    CidView view;
+    ASSERT_EQ(CidView::parse(binary, view), CidError::None);
+    EXPECT_EQ(view.version(), 1);
+    EXPECT_EQ(view.content_type(), 0x55);
+    EXPECT_EQ(view.hash_function(), 0x12);
+    EXPECT_EQ(view.digest_size(), 32);
+    EXPECT_EQ(view.digest().data(), binary.data() + 4);
+    EXPECT_EQ(bytes(view.multihash()),
+              std::vector<std::uint8_t>(binary.begin() + 2, binary.end()));
+    EXPECT_EQ(view.to_binary().data(), binary.data());
+    EXPECT_EQ(Multiformats::CidKey{view.to_binary()},
+              Multiformats::CidKey{binary});
+}
+
+TEST(CidViewTests, BinaryV0) {
+    auto const binary = Multiformats::Multibase::decode(encoded);
+    std::vector<std::uint8_t> const v0(binary.begin() + 2, binary.end());
+
+    CidView view;
+    ASSERT_EQ(CidView::parse(v0, view), CidError::None);
+    EXPECT_EQ(view.version(), 0);
+    EXPECT_EQ(view.content_type(), 0x70);
+    EXPECT_EQ(view.hash_function(), 0x12);
+    EXPECT_EQ(view.digest_size(), 32);
+    EXPECT_EQ(bytes(view.digest()),
+              std::vector<std::uint8_t>(v0.begin() + 2, v0.end()));
+    EXPECT_EQ(bytes(view.multihash()), v0);
+}
+
+TEST(CidViewTests, BinaryErrors) {
+    auto const binary = Multiformats::Multibase::decode(encoded);
+    std::vector<std::uint8_t> const v0(binary.begin() + 2, binary.end());
+
+    auto truncated = binary;
+    truncated.pop_back();
+    auto trailing = binary;
+    trailing.push_back(0);
+    auto version = binary;
+    version[0] = 2;
+    auto v0_trailing = v0;
+    v0_trailing.push_back(0);
+
+    std::vector<std::pair<std::vector<std::uint8_t>, CidError>> const cases{
+        {{}, CidError::Truncated},
+        {{0x01}, CidError::Truncated},
+        {{0x01, 0x55}, CidError::Truncated},
+        {{0x01, 0x55, 0x12}, CidError::Truncated},
+        {{0x01, 0x55, 0x12, 0x80}, CidError::Truncated},
+        {truncated, CidError::Truncated},
+        {trailing, CidError::TrailingBytes},
+        {version, CidError::Version},
+        {{0x00, 0x55, 0x00, 0x00}, CidError::Version},
+        {{v0.begin(), v0.end() - 1}, CidError::Truncated},
+        {{0x12}, CidError::Truncated},
+        {v0_trailing, CidError::TrailingBytes}};
+
+    for (auto const& [invalid, expected] : cases) {
+        CidView view;
+        EXPECT_EQ(CidView::parse(invalid, view), expected)
+            << Multiformats::to_string(expected);
+        EXPECT_TRUE(view.to_binary().empty());
+    }
+}
+
+TEST(CidViewTests, TextV0) {
+    auto const binary = Multiformats::Multibase::decode(encoded);
+    auto const text = v0_text();
+    ASSERT_EQ(text.size(), 46);
+    ASSERT_EQ(text.substr(0, 2), "Qm");
+    std::array<std::uint8_t, 64> buffer;
+
+    CidView view;
+    ASSERT_EQ(CidView::parse(text, buffer, view), CidError::None);
+    EXPECT_EQ(view.version(), 0);
+    EXPECT_EQ(view.to_binary().data(), buffer.data());
+    EXPECT_EQ(bytes(view.to_binary()),
+              std::vector<std::uint8_t>(binary.begin() + 2, binary.end()));
+}
+
+TEST(CidViewTests, TextErrors) {
+    CidView view;
+    std::vector<std::uint8_t> buffer;
+
+    for (std::string const invalid :
+         {"", "z", "f", "b0", "f0155", "f01551", "fo1", "m/w", "mAf", "uA+",
+          "bafkreg", "Bafkrei", "?abc",
+          "zb2rhe5P4gXftAwvA4eXQ5HJwsER2owDyS9sKaQRRVQPn93b0"})
+        EXPECT_NE(parse_text(invalid, view, buffer), CidError::None)
+            << invalid;
+
+    EXPECT_EQ(parse_text("fxyz", view, buffer), CidError::Multibase);
+    EXPECT_EQ(parse_text("f01551", view, buffer), CidError::Multibase);
+    EXPECT_EQ(parse_text("f0255", view, buffer), CidError::Version);
+    EXPECT_EQ(parse_text("f01551280", view, buffer), CidError::Truncated);
+    EXPECT_TRUE(view.to_binary().empty());
+
+    std::array<std::uint8_t, 16> small;
+    EXPECT_EQ(CidView::parse(encoded, small, view), CidError::BufferTooSmall);
+    EXPECT_EQ(CidView::parse(v0_text(), small, view),
+              CidError::BufferTooSmall);
+    EXPECT_EQ(CidView::parse(Multiformats::Multibase::encode(
+                                 Protocol::Base32,
+                                 Multiformats::Multibase::decode(encoded)),
+                             small, view),
+              CidError::BufferTooSmall);
+}
+
+TEST(CidViewTests, GarbageText) {
+    // every prefix Multibase knows, with short and random payloads
+    std::string const prefixes{std::string{'\0'} + "079fFvVtTbBcChZz1QmMuU"};
+    std::string const characters{
+        "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ+/-_="};
+
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<std::size_t> pick{0, characters.size() - 1};
+    std::uniform_int_distribution<std::size_t> length{0, 60};
+
+    std::vector<std::string> payloads{""};
+    for (auto const c : characters) {
+        payloads.push_back(std::string(1, c));
+        payloads.push_back(std::string(2, c));
+        payloads.push_back(std::string(9, c));
+    }
+
+    for (int i = 0; i < 200; ++i) {
+        std::string payload(length(rng), ' ');
+        for (auto& c : payload)
+            c = characters[pick(rng)];
+        payloads.push_back(payload);
+    }
+
+    for (auto const prefix : prefixes) {
+        for (auto const& payload : payloads) {
+            auto const text = prefix + payload;
+
+            CidView view;
+            std::vector<std::uint8_t> buffer;
+            auto const error = parse_text(text, view, buffer);
+            if (error == CidError::None) {
+                EXPECT_LE(view.to_binary().size(), text.size());
+            }
+
+            std::array<std::uint8_t, 4> small;
+            CidView::parse(text, small, view);
+        }
+    }
+}
+
+class CidViewTextTests : public testing::TestWithParam<Protocol> {};
+
+TEST_P(CidViewTextTests, Decode) {
+    std::vector<std::vector<std::uint8_t>> binaries{
+        Multiformats::Multibase::decode(encoded),
+        {0x01, 0x55, 0x00, 0x00},
+        {0x01, 0x55, 0x00, 0x01, 0x00},
+        {0x01, 0x71, 0x00, 0x02, 0x00, 0x00},
+        {0x01, 0x80, 0x01, 0x00, 0x03, 0xff, 0x00, 0x01}};
+
+    // identity digests of every length, for every trailing bit pattern
+    for (std::uint8_t size = 0; size < 70; ++size) {
+        std::vector<std::uint8_t> binary{0x01, 0x55, 0x00, size};
+        for (std::uint8_t i = 0; i < size; ++i)
+            binary.push_back(static_cast<std::uint8_t>(i * 37 + size));
+        binaries.push_back(binary);
+    }
+
+    for (auto const& binary : binaries) {
+        auto const text = Multiformats::Multibase::encode(GetParam(), binary);
+
+        CidView view;
+        std::vector<std::uint8_t> buffer;
+        ASSERT_EQ(parse_text(text, view, buffer), CidError::None) << text;
+        EXPECT_EQ(bytes(view.to_binary()), binary) << text;
+        EXPECT_EQ(view.to_binary().data(), buffer.data());
+        EXPECT_EQ(view.digest().end(), buffer.data() + binary.size());
+    }
+}
+
+// base8, base10 and base32z are left out, as Multibase::decode does not take
+// back what Multibase::encode gives for all of them
+INSTANTIATE_TEST_CASE_P(
+    CidView, CidViewTextTests,
+    testing::Values(Protocol::Base2, Protocol::Base16, Protocol::Base16Upper,
+                    Protocol::Base32Hex, Protocol::Base32HexUpper,
+                    Protocol::Base32HexPad, Protocol::Base32HexPadUpper,
+                    Protocol::Base32, Protocol::Base32Upper,
+                    Protocol::Base32Pad, Protocol::Base32PadUpper,
+                    Protocol::Base58Flickr, Protocol::Base58Btc,
+                    Protocol::Base64, Protocol::Base64Pad, Protocol::Base64Url,
+                    Protocol::Base64UrlPad));
@@ -0,0 +1,100 @@
+// Tests for the hashing thread pool
+//
+// File Name: hash-executor-test.cpp
+// Date: 2026-10-18
+
+#include "multiformats/hash_executor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+
+using Multiformats::HashExecutor;
+using Multiformats::Multihash;
+
+namespace {
+    std::vector<std::uint8_t> make_block(std::size_t size, std::uint8_t seed) {
+        std::vector<std::uint8_t> block(size);
+        for (std::size_t i = 0; i < size; ++i)
+            block[i] = static_cast<std::uint8_t>(i * 31 + seed);
+
+        return block;
+    }
+} // namespace
+
+TEST(HashExecutorTests, Futures) {
+    HashExecutor::Options options;
+    options.workers = 4;
+    options.queue_capacity = 8;
+    options.batch_size = 4;
+    HashExecutor executor{options};
+
+    // mixed sizes and codes so batches are both formed and broken up
+    std::vector<std::vector<std::uint8_t>> blocks;
+    for (std::size_t i = 0; i < 200; ++i)
+        blocks.push_back(make_block(i % 7 == 0 ? 100000 : i * 13, i));
+
+    std::vector<std::future<Multihash>> futures;
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        Multiformats::Varint code = i % 3 == 0 ? 0x12 : 0xb220;
+        if (i % 2 == 0)
+            futures.push_back(executor.submit(blocks[i], code));
+        else
+            futures.push_back(
+                executor.submit(std::vector<std::uint8_t>{blocks[i]}, code));
+    }
+
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+        EXPECT_EQ(futures[i].get(),
+                  Multihash(blocks[i], i % 3 == 0 ? "sha2-256" : "blake2b-256"));
+}
+
+TEST(HashExecutorTests, Callbacks) {
+    auto block = make_block(4096, 7);
+    std::mutex mutex;
+    std::vector<Multihash> results;
+    {
+        HashExecutor executor{};
+        for (auto i = 0; i < 50; ++i)
+            executor.submit(block, 0x12,
+                            [&](Multihash const& multihash,
+                                std::exception_ptr error) {
+                                EXPECT_FALSE(error);
+                                std::lock_guard lock{mutex};
+                                results.push_back(multihash);
+                            });
+    }
+
+    // the destructor finished every job
+    ASSERT_EQ(results.size(), 50u);
+    for (auto const& result : results)
+        EXPECT_EQ(result, Multihash(block, "sha2-256"));
+}
+
+TEST(HashExecutorTests, SubmitFromCallback) {
+    auto block = make_block(1000, 1);
+    std::promise<Multihash> inner;
+    HashExecutor executor{};
+    executor.submit(block, 0x12, [&](Multihash const&, std::exception_ptr) {
+        executor.submit(block, 0x11,
+                        [&](Multihash const& multihash, std::exception_ptr) {
+                            inner.set_value(multihash);
+                        });
+    });
+
+    EXPECT_EQ(inner.get_future().get(), Multihash(block, "sha1"));
+}
+
+TEST(HashExecutorTests, NotSupported) {
+    HashExecutor executor{};
+    std::vector<std::uint8_t> buf(5, 1);
+    auto future = executor.submit(buf, 0x06);
+    EXPECT_THROW(future.get(), std::invalid_argument);
+}
+
+TEST(HashExecutorTests, InvalidOptions) {
+    HashExecutor::Options options;
+    options.queue_capacity = 0;
+    EXPECT_THROW(HashExecutor{options}, std::invalid_argument);
+}
@@ -0,0 +1,185 @@
+// Tests for the Multiaddr IP prefix filter
+//
+// File Name: multiaddr-filter-test.cpp
+// Date: 2026-10-18
+
+#include "multiformats/multiaddr_filter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+#include <cstdio>
+
+using Multiformats::Multiaddr;
+using Multiformats::MultiaddrFilter;
+using Action = MultiaddrFilter::Action;
+
+TEST(MultiaddrFilterTests, LongestPrefix) {
+    MultiaddrFilter filter;
+    filter.add("10.0.0.0/8", Action::Deny);
+    filter.add("10.1.0.0/16", Action::Accept);
+    filter.add("10.1.2.3/32", Action::Deny);
+    filter.add("2001:db8::/32", Action::Deny);
+    filter.add("2001:db8:1::/48", Action::Accept);
+    EXPECT_EQ(filter.size(), 5);
+
+    EXPECT_EQ(filter.match(Multiaddr{"/ip4/10.2.0.1/tcp/1"}), Action::Deny);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip4/10.1.9.9/tcp/1"}), Action::Accept);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip4/10.1.2.3"}), Action::Deny);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip4/11.0.0.1"}), Action::None);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip6/2001:db8::1/udp/1/quic"}),
+              Action::Deny);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip6/2001:db8:1::1"}), Action::Accept);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip6zone/eth0/ip6/2001:db8:1::1"}),
+              Action::Accept);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip6/2001:db9::1"}), Action::None);
+
+    // host bits are ignored and adding again replaces the action
+    filter.add("10.1.255.255/16", Action::Deny);
+    EXPECT_EQ(filter.size(), 5);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip4/10.1.9.9"}), Action::Deny);
+}
+
+TEST(MultiaddrFilterTests, DefaultRoutes) {
+    MultiaddrFilter filter;
+    filter.add("0.0.0.0/0", Action::Deny);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip4/192.0.2.1"}), Action::Deny);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip6/2001:db8::1"}), Action::None);
+
+    // IPv4 prefixes also cover IPv4-mapped IPv6 addresses
+    EXPECT_EQ(filter.match(Multiaddr{"/ip6/::ffff:192.0.2.1"}), Action::Deny);
+
+    filter.add("::/0", Action::Accept);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip6/2001:db8::1"}), Action::Accept);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip4/192.0.2.1"}), Action::Deny);
+    EXPECT_EQ(filter.size(), 2);
+}
+
+TEST(MultiaddrFilterTests, Remove) {
+    MultiaddrFilter filter;
+    filter.add("192.168.0.0/16", Action::Deny);
+    filter.add("192.168.1.0/24", Action::Accept);
+
+    filter.add("192.168.0.0/16", Action::None);
+    EXPECT_EQ(filter.size(), 1);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip4/192.168.2.1"}), Action::None);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip4/192.168.1.1"}), Action::Accept);
+
+    // removing what isn't there changes nothing
+    filter.add("172.16.0.0/12", Action::None);
+    filter.add("192.168.1.128/25", Action::None);
+    EXPECT_EQ(filter.size(), 1);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip4/192.168.1.200"}), Action::Accept);
+}
+
+TEST(MultiaddrFilterTests, NotIp) {
+    MultiaddrFilter filter;
+    filter.add("0.0.0.0/0", Action::Deny);
+    filter.add("::/0", Action::Deny);
+
+    EXPECT_EQ(filter.match(Multiaddr{"/dns4/example.com/tcp/80"}),
+              Action::None);
+    EXPECT_EQ(filter.match(Multiaddr{"/unix/tmp/socket"}), Action::None);
+    EXPECT_EQ(filter.match(Multiaddr{"/ip6zone/eth0"}), Action::None);
+}
+
+TEST(MultiaddrFilterTests, InvalidPrefix) {
+    MultiaddrFilter filter;
+    for (auto const* cidr :
+         {"10.0.0.0", "10.0.0.0/", "10.0.0.0/33", "10.0.0.0/8x",
+          "10.0.0.0/-1", "::/129", "10.0.0/8", "example.com/8", "/8"})
+        EXPECT_THROW(filter.add(cidr, Action::Deny), std::invalid_argument)
+            << cidr;
+
+    EXPECT_EQ(filter.size(), 0);
+}
+
+class MultiaddrFilterScanTest : public ::testing::TestWithParam<bool> {};
+
+// 32 bit prefixes as IPv4 ones, or as the leading bits of IPv6 ones
+TEST_P(MultiaddrFilterScanTest, MatchesLinearScan) {
+    auto const ip6 = GetParam();
+
+    struct Prefix {
+        std::uint32_t address;
+        int length;
+        Action action;
+    };
+
+    auto const mask = [](int length) {
+        return length == 0 ? 0u : ~0u << (32 - length);
+    };
+
+    auto const text = [ip6](std::uint32_t address) {
+        if (ip6) {
+            char buffer[16];
+            std::snprintf(buffer, sizeof(buffer), "%x:%x::", address >> 16,
+                          address & 0xffff);
+            return std::string{buffer};
+        }
+
+        return std::to_string(address >> 24) + "." +
+               std::to_string((address >> 16) & 0xff) + "." +
+               std::to_string((address >> 8) & 0xff) + "." +
+               std::to_string(address & 0xff);
+    };
+
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<std::uint32_t> address{0, 0xffff};
+    std::uniform_int_distribution<int> length{0, 32};
+    std::uniform_int_distribution<int> action{0, 2};
+
+    MultiaddrFilter filter;
+    std::vector<Prefix> prefixes;
+    // enough prefixes for the trie to be indexed part way through
+    for (int i = 0; i < 4000; ++i) {
+        Prefix const prefix{address(rng) << 16 | address(rng), length(rng),
+                            Action(action(rng))};
+        filter.add(text(prefix.address) + "/" +
+                       std::to_string(prefix.length),
+                   prefix.action);
+
+        auto const masked = prefix.address & mask(prefix.length);
+        auto const same = [&](Prefix const& other) {
+            return other.length == prefix.length &&
+                   (other.address & mask(other.length)) == masked;
+        };
+        prefixes.erase(std::remove_if(prefixes.begin(), prefixes.end(), same),
+                       prefixes.end());
+        if (prefix.action != Action::None)
+            prefixes.push_back(prefix);
+    }
+
+    EXPECT_EQ(filter.size(), prefixes.size());
+
+    for (int i = 0; i < 5000; ++i) {
+        // bias towards the addresses the prefixes were drawn from
+        auto const probe = i % 2 == 0
+                               ? prefixes[i % prefixes.size()].address ^
+                                     (address(rng) >> (i % 17))
+                               : address(rng) << 16 | address(rng);
+
+        auto expected = Action::None;
+        auto best = -1;
+        for (auto const& prefix : prefixes) {
+            if (prefix.length > best &&
+                (probe & mask(prefix.length)) ==
+                    (prefix.address & mask(prefix.length))) {
+                best = prefix.length;
+                expected = prefix.action;
+            }
+        }
+
+        auto const multiaddr = (ip6 ? "/ip6/" : "/ip4/") + text(probe);
+        ASSERT_EQ(filter.match(Multiaddr{multiaddr}), expected) << multiaddr;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(MultiaddrFilterTests, MultiaddrFilterScanTest,
+                        ::testing::Values(false, true));
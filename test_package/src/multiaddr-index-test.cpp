@@ -0,0 +1,194 @@
+// Tests for Multiaddr patterns and the signature index
+//
+// File Name: multiaddr-index-test.cpp
+// Date: 2026-10-18
+
+#include "multiformats/multiaddr_index.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+using Multiformats::Multiaddr;
+using Multiformats::MultiaddrIndex;
+using Multiformats::MultiaddrPattern;
+
+namespace {
+    std::vector<std::string> const addresses{
+        "/ip4/1.2.3.4/udp/4001/quic",
+        "/ip4/1.2.3.5/udp/4001/quic",
+        "/ip4/1.2.3.4/tcp/4001",
+        "/ip6/::1/udp/4001/quic",
+        "/ip4/1.2.3.4/tcp/4001/p2p-circuit",
+        "/ip4/1.2.3.4/udp/4001/quic/p2p-circuit/ip4/5.6.7.8/tcp/1",
+        "/dns4/example.com/tcp/443/wss",
+        "/unix/tmp/socket",
+        "/unix/var/socket"};
+} // namespace
+
+TEST(MultiaddrPatternTests, Matches) {
+    struct Case {
+        char const* pattern;
+        std::vector<bool> expected;
+    };
+
+    std::vector<Case> const cases{
+        {"/ip4/*/udp/*/quic", {1, 1, 0, 0, 0, 0, 0, 0, 0}},
+        {"/ip4/1.2.3.4/udp/*/quic", {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+        {"/ip4/*/**", {1, 1, 1, 0, 1, 1, 0, 0, 0}},
+        {"/**/p2p-circuit/**", {0, 0, 0, 0, 1, 1, 0, 0, 0}},
+        {"/**/p2p-circuit", {0, 0, 0, 0, 1, 0, 0, 0, 0}},
+        {"/**/tcp/*", {0, 0, 1, 0, 0, 1, 0, 0, 0}},
+        {"/**/udp/4001/**", {1, 1, 0, 1, 0, 1, 0, 0, 0}},
+        {"/**/**", {1, 1, 1, 1, 1, 1, 1, 1, 1}},
+        {"/**/quic/**/tcp/*", {0, 0, 0, 0, 0, 1, 0, 0, 0}},
+        {"/dns4/*/tcp/443/wss", {0, 0, 0, 0, 0, 0, 1, 0, 0}},
+        {"/unix/*", {0, 0, 0, 0, 0, 0, 0, 1, 1}},
+        {"/unix/tmp/socket", {0, 0, 0, 0, 0, 0, 0, 1, 0}},
+        {"/ip6/::1/udp/4001/quic", {0, 0, 0, 1, 0, 0, 0, 0, 0}},
+        {"/ip6/::1:0/udp/4001/quic", {0, 0, 0, 0, 0, 0, 0, 0, 0}}};
+
+    for (auto const& [text, expected] : cases) {
+        MultiaddrPattern const pattern{text};
+        for (std::size_t i = 0; i < addresses.size(); ++i) {
+            Multiaddr const multiaddr{addresses[i]};
+            std::vector<std::uint64_t> codes;
+            for (auto const& component : multiaddr)
+                codes.push_back(component.code);
+
+            EXPECT_EQ(pattern.matches(multiaddr), expected[i])
+                << text << " " << addresses[i];
+            // codes alone can only rule addresses out when there are values
+            if (!pattern.has_values()) {
+                EXPECT_EQ(pattern.matches_codes(codes), expected[i])
+                    << text << " " << addresses[i];
+            } else if (expected[i]) {
+                EXPECT_TRUE(pattern.matches_codes(codes))
+                    << text << " " << addresses[i];
+            }
+        }
+    }
+
+    EXPECT_FALSE(MultiaddrPattern{"/ip4/*"}.has_values());
+    EXPECT_TRUE(MultiaddrPattern{"/ip4/*/tcp/1"}.has_values());
+}
+
+TEST(MultiaddrPatternTests, Invalid) {
+    for (auto const* pattern : {"", "ip4/*", "/ip4", "/ip4/1.2.3", "/tcp/x"})
+        EXPECT_THROW(MultiaddrPattern{pattern}, std::invalid_argument)
+            << pattern;
+
+    EXPECT_THROW(MultiaddrPattern{"/nope/*"}, std::out_of_range);
+    EXPECT_THROW(MultiaddrPattern{"/*"}, std::out_of_range);
+}
+
+TEST(MultiaddrIndexTests, Query) {
+    MultiaddrIndex index;
+    for (auto const& address : addresses)
+        EXPECT_TRUE(index.add(Multiaddr{address}));
+
+    EXPECT_FALSE(index.add(Multiaddr{addresses[0]}));
+    EXPECT_EQ(index.size(), addresses.size());
+    EXPECT_EQ(index.signatures(), 7);
+    EXPECT_TRUE(index.contains(Multiaddr{addresses[2]}.view()));
+
+    auto const query = [&index](char const* text) {
+        std::vector<std::string> ret;
+        index.query(MultiaddrPattern{text}, [&ret](Multiaddr const& multiaddr) {
+            ret.push_back(multiaddr.to_string());
+        });
+        std::sort(ret.begin(), ret.end());
+        return ret;
+    };
+
+    EXPECT_EQ(query("/ip4/*/udp/*/quic"),
+              (std::vector<std::string>{addresses[0], addresses[1]}));
+    EXPECT_EQ(query("/ip4/1.2.3.5/udp/*/quic"),
+              (std::vector<std::string>{addresses[1]}));
+    EXPECT_EQ(query("/**/p2p-circuit/**"),
+              (std::vector<std::string>{addresses[4], addresses[5]}));
+    EXPECT_EQ(query("/ip6zone/*/**"), std::vector<std::string>{});
+    EXPECT_EQ(index.count(MultiaddrPattern{"/**"}), addresses.size());
+    EXPECT_EQ(index.count(MultiaddrPattern{"/unix/tmp/socket"}), 1);
+
+    EXPECT_TRUE(index.remove(Multiaddr{addresses[0]}.view()));
+    EXPECT_FALSE(index.remove(Multiaddr{addresses[0]}.view()));
+    EXPECT_FALSE(index.contains(Multiaddr{addresses[0]}.view()));
+    EXPECT_EQ(query("/ip4/*/udp/*/quic"),
+              (std::vector<std::string>{addresses[1]}));
+
+    // an emptied signature no longer counts
+    EXPECT_TRUE(index.remove(Multiaddr{addresses[1]}.view()));
+    EXPECT_EQ(index.signatures(), 6);
+    EXPECT_EQ(index.size(), addresses.size() - 2);
+}
+
+TEST(MultiaddrIndexTests, MatchesLinearScan) {
+    // ports and hosts vary within a handful of shapes
+    std::vector<Multiaddr> all;
+    for (int i = 0; i < 3000; ++i) {
+        auto const host = "10.0." + std::to_string(i % 7) + "." +
+                          std::to_string(i % 251);
+        auto const port = std::to_string(i % 13);
+        switch (i % 5) {
+        case 0:
+            all.emplace_back("/ip4/" + host + "/tcp/" + port);
+            break;
+        case 1:
+            all.emplace_back("/ip4/" + host + "/udp/" + port + "/quic");
+            break;
+        case 2:
+            all.emplace_back("/ip4/" + host + "/udp/" + port +
+                             "/quic/p2p-circuit");
+            break;
+        case 3:
+            all.emplace_back("/ip6/::" + std::to_string(i) + "/tcp/" + port);
+            break;
+        default:
+            all.emplace_back("/dns4/host" + std::to_string(i % 11) +
+                             ".example/tcp/" + port + "/ws");
+        }
+    }
+
+    MultiaddrIndex index;
+    std::size_t added{};
+    for (auto const& multiaddr : all)
+        added += index.add(multiaddr);
+
+    // remove some, so that groups have been compacted
+    for (std::size_t i = 0; i < all.size(); i += 3)
+        added -= index.remove(all[i].view());
+
+    EXPECT_EQ(index.size(), added);
+
+    for (auto const* text :
+         {"/ip4/*/tcp/*", "/ip4/*/udp/3/**", "/**/p2p-circuit",
+          "/**/tcp/5/**", "/ip4/10.0.3.17/**", "/dns4/host3.example/**",
+          "/**/quic/**", "/**"}) {
+        MultiaddrPattern const pattern{text};
+
+        std::vector<std::string> expected;
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            if (index.contains(all[i].view()) && pattern.matches(all[i]))
+                expected.push_back(all[i].to_string());
+        }
+
+        std::sort(expected.begin(), expected.end());
+        expected.erase(std::unique(expected.begin(), expected.end()),
+                       expected.end());
+
+        std::vector<std::string> found;
+        index.query(pattern, [&found](Multiaddr const& multiaddr) {
+            found.push_back(multiaddr.to_string());
+        });
+        std::sort(found.begin(), found.end());
+
+        EXPECT_EQ(found, expected) << text;
+        EXPECT_EQ(index.count(pattern), expected.size()) << text;
+    }
+}
@@ -0,0 +1,175 @@
+// Tests for bulk Multiaddr parsing
+//
+// File Name: multiaddr-list-test.cpp
+// Date: 2026-10-18
+
+#include "multiformats/multiaddr_list.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using Multiformats::Multiaddr;
+using Multiformats::MultiaddrError;
+using Multiformats::MultiaddrList;
+
+namespace {
+    std::vector<std::string> const valid{
+        "/ip4/1.2.3.4/tcp/4001",
+        "/ip6/::1/udp/4001/quic",
+        "/dns4/example.com/tcp/443/wss",
+        "/ip4/127.0.0.1/p2p/QmcgpsyWgH8Y8ajJz1Cu72KnS5uo2Aa2LpzU7kinSupNKC",
+        "/unix/tmp/socket"};
+
+    /** @brief Addresses and bad lines mixed, with the line of each error */
+    std::string mixed(std::size_t lines,
+                      std::vector<MultiaddrList::LineError>& errors,
+                      std::vector<std::string>& addresses) {
+        std::string ret;
+        for (std::size_t i = 0; i < lines; ++i) {
+            switch (i % 11) {
+            case 3:
+                ret += "/ip4/1.2.3/tcp/1\n";
+                errors.push_back({i + 1, MultiaddrError::InvalidValue});
+                break;
+            case 7:
+                ret += "\n";
+                break;
+            default:
+                addresses.push_back(valid[i % valid.size()]);
+                ret += addresses.back() + "\n";
+            }
+        }
+
+        return ret;
+    }
+
+    void expect_equal(MultiaddrList const& list,
+                      std::vector<std::string> const& addresses) {
+        ASSERT_EQ(list.size(), addresses.size());
+        for (std::size_t i = 0; i < addresses.size(); ++i)
+            EXPECT_EQ(list[i], Multiaddr{addresses[i]}.view()) << i;
+    }
+} // namespace
+
+TEST(MultiaddrListTests, Parse) {
+    auto const list = MultiaddrList::parse("/ip4/1.2.3.4/tcp/80\r\n"
+                                           "\n"
+                                           "ip4/1.2.3.4\n"
+                                           "/nope/1\n"
+                                           "/sha2-256\n"
+                                           "/tcp\n"
+                                           "/tcp/80a\n"
+                                           "/ip6/::1\n"
+                                           "/ip4/1.2.3.4/tcp/80/");
+
+    expect_equal(list, {"/ip4/1.2.3.4/tcp/80", "/ip6/::1"});
+
+    std::vector<MultiaddrList::LineError> const errors{
+        {3, MultiaddrError::Syntax},
+        {4, MultiaddrError::UnknownProtocol},
+        {5, MultiaddrError::UnsupportedProtocol},
+        {6, MultiaddrError::MissingValue},
+        {7, MultiaddrError::InvalidValue},
+        {9, MultiaddrError::UnknownProtocol}};
+    EXPECT_EQ(list.errors(), errors);
+
+    // the views are back to back in one buffer
+    EXPECT_EQ(list.to_binary().size(), list[0].to_binary().size() +
+                                           list[1].to_binary().size());
+    EXPECT_EQ(list[1].to_binary().data(),
+              list[0].to_binary().data() + list[0].to_binary().size());
+
+    EXPECT_TRUE(MultiaddrList::parse("").empty());
+    EXPECT_TRUE(MultiaddrList::parse("\n\r\n").errors().empty());
+}
+
+TEST(MultiaddrListTests, TooLong) {
+    std::string address;
+    for (int i = 0; i < 40000; ++i)
+        address += "/quic";
+
+    auto const list = MultiaddrList::parse(address + "\n/quic\n");
+    ASSERT_EQ(list.size(), 1);
+    EXPECT_EQ(list[0].to_string(), "/quic");
+    EXPECT_EQ(list.errors(), (std::vector<MultiaddrList::LineError>{
+                                 {1, MultiaddrError::TooLong}}));
+}
+
+TEST(MultiaddrListTests, ChunksMatchSerial) {
+    std::vector<MultiaddrList::LineError> errors;
+    std::vector<std::string> addresses;
+    auto const text = mixed(5000, errors, addresses);
+
+    for (std::size_t chunk_size : {1, 100, 4096, 1 << 30}) {
+        MultiaddrList::Options options;
+        options.workers = 4;
+        options.chunk_size = chunk_size;
+
+        auto const list = MultiaddrList::parse(text, options);
+        expect_equal(list, addresses);
+        EXPECT_EQ(list.errors(), errors) << chunk_size;
+    }
+
+    MultiaddrList::Options options;
+    options.chunk_size = 0;
+    EXPECT_THROW(MultiaddrList::parse(text, options), std::invalid_argument);
+}
+
+TEST(MultiaddrListTests, MalformedPeerId) {
+    // a short base8 peer ID, which once threw from a worker, and short
+    // base64 ones, which once crashed the decoder
+    std::string text;
+    for (int i = 0; i < 100; ++i)
+        text += valid[i % valid.size()] + "\n";
+    text += "/p2p/70\n/p2p/u\n/p2p/m\n/p2p/mA\n/p2p/uA\n/ipfs/u\n";
+
+    std::vector<MultiaddrList::LineError> errors;
+    for (std::size_t line = 101; line <= 106; ++line)
+        errors.push_back({line, MultiaddrError::InvalidValue});
+
+    for (std::size_t workers : {1, 2}) {
+        MultiaddrList::Options options;
+        options.workers = workers;
+        options.chunk_size = workers == 1 ? 1 << 30 : 64;
+
+        auto const list = MultiaddrList::parse(text, options);
+        EXPECT_EQ(list.size(), 100);
+        EXPECT_EQ(list.errors(), errors);
+    }
+}
+
+TEST(MultiaddrListTests, FromFile) {
+    std::vector<MultiaddrList::LineError> errors;
+    std::vector<std::string> addresses;
+    auto const text = mixed(2000, errors, addresses);
+
+    auto const path = "multiaddr-list.txt";
+    std::ofstream{path, std::ios::binary} << text;
+
+    MultiaddrList::Options options;
+    options.chunk_size = 1000;
+    auto const list = MultiaddrList::from_file(path, options);
+    expect_equal(list, addresses);
+    EXPECT_EQ(list.errors(), errors);
+
+    std::ofstream{path, std::ios::binary | std::ios::trunc};
+    EXPECT_TRUE(MultiaddrList::from_file(path).empty());
+    std::remove(path);
+
+    EXPECT_THROW(MultiaddrList::from_file("no-such-multiaddr-list.txt"),
+                 std::system_error);
+}
+
+TEST(MultiaddrListTests, ErrorsMatchExceptions) {
+    EXPECT_THROW(Multiaddr{"/nope/1"}, std::out_of_range);
+    for (auto const* address : {"", "ip4", "/tcp", "/tcp/x", "/sha2-256"})
+        EXPECT_THROW(Multiaddr{address}, std::invalid_argument) << address;
+
+    EXPECT_STREQ(to_string(MultiaddrError::MissingValue),
+                 "missing multiaddr value");
+}
@@ -0,0 +1,110 @@
+// Tests for the Multiaddr interning pool
+//
+// File Name: multiaddr-pool-test.cpp
+// Date: 2026-10-18
+
+#include "multiformats/multiaddr_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <cstdint>
+
+using Multiformats::Multiaddr;
+using Multiformats::MultiaddrPool;
+using Multiformats::MultiaddrView;
+
+TEST(MultiaddrPoolTests, EqualityAndHash) {
+    Multiaddr const a{"/ip4/1.2.3.4/tcp/80"};
+    Multiaddr const b{std::vector<std::uint8_t>{a.to_binary()}};
+    Multiaddr const c{"/ip4/1.2.3.4/tcp/81"};
+
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(a != c);
+    EXPECT_EQ(std::hash<Multiaddr>{}(a), std::hash<Multiaddr>{}(b));
+    EXPECT_EQ(std::hash<Multiaddr>{}(a), std::hash<MultiaddrView>{}(b.view()));
+
+    std::unordered_set<Multiaddr> set{a, b, c};
+    EXPECT_EQ(set.size(), 2);
+}
+
+TEST(MultiaddrPoolTests, Intern) {
+    MultiaddrPool pool;
+    Multiaddr const address{"/ip4/1.2.3.4/tcp/80"};
+
+    EXPECT_EQ(pool.find(address.view()), nullptr);
+
+    auto const handle = pool.intern(address);
+    ASSERT_NE(handle, nullptr);
+    EXPECT_TRUE(*handle == address);
+    EXPECT_NE(handle->to_binary().data(), address.to_binary().data());
+
+    // equal addresses from any source share the handle
+    EXPECT_EQ(pool.intern(address.view()), handle);
+    EXPECT_EQ(pool.intern(Multiaddr{"/ip4/1.2.3.4/tcp/80"}), handle);
+    EXPECT_EQ(pool.find(address.view()), handle);
+    EXPECT_NE(pool.intern(Multiaddr{"/ip4/1.2.3.4/tcp/81"}), handle);
+    EXPECT_EQ(pool.size(), 2);
+
+    // a known address isn't moved from
+    Multiaddr known{"/ip4/1.2.3.4/tcp/80"};
+    EXPECT_EQ(pool.intern(std::move(known)), handle);
+    EXPECT_TRUE(known == address);
+
+    std::vector<std::uint8_t> const truncated{0x04, 0x01};
+    EXPECT_THROW(pool.intern(MultiaddrView{truncated}), std::invalid_argument);
+    EXPECT_EQ(pool.size(), 2);
+
+    EXPECT_THROW(MultiaddrPool{0}, std::invalid_argument);
+}
+
+TEST(MultiaddrPoolTests, HandlesAreStable) {
+    MultiaddrPool pool{1};
+    std::vector<MultiaddrPool::Handle> handles;
+    for (int port = 0; port < 10000; ++port)
+        handles.push_back(
+            pool.intern(Multiaddr{"/ip4/10.0.0.1/tcp/" + std::to_string(port)}));
+
+    for (int port = 0; port < 10000; ++port) {
+        Multiaddr const address{"/ip4/10.0.0.1/tcp/" + std::to_string(port)};
+        EXPECT_TRUE(*handles[port] == address);
+        EXPECT_EQ(pool.find(address.view()), handles[port]);
+    }
+}
+
+TEST(MultiaddrPoolTests, Concurrent) {
+    MultiaddrPool pool{8};
+    constexpr int thread_count = 8;
+    constexpr int address_count = 2000;
+
+    std::vector<std::vector<MultiaddrPool::Handle>> handles(thread_count);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t] {
+            // every thread interns the same addresses in a different order
+            for (int i = 0; i < address_count; ++i) {
+                auto const port = (i * 7 + t * 331) % address_count;
+                handles[t].push_back(pool.intern(
+                    Multiaddr{"/ip6/::1/udp/" + std::to_string(port)}));
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(pool.size(), address_count);
+    for (int t = 0; t < thread_count; ++t) {
+        for (int i = 0; i < address_count; ++i) {
+            auto const port = (i * 7 + t * 331) % address_count;
+            EXPECT_EQ(handles[t][i],
+                      pool.find(Multiaddr{"/ip6/::1/udp/" + std::to_string(port)}
+                                    .view()));
+        }
+    }
+}
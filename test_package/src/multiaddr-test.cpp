@@ -6,12 +6,17 @@
 
 #include "util.hpp"
 
+#include "multiformats/codec_traits.hpp"
 #include "multiformats/multiaddr.hpp"
 
 #include <gtest/gtest.h>
 
+#include <iterator>
+#include <string>
 #include <vector>
 
+#include <cstdint>
+
 struct MultiaddrTestParam {
     std::string address;
     std::vector<std::uint8_t> binary;
@@ -28,7 +33,22 @@ std::vector<MultiaddrTestParam> const parameters{
      "047f00000106005090030b612f622f632f642f652f66"_hex},
     {"/ip6/2001:8a0:7ac5:4201:3ac9:86ff:fe31:7095/tcp/8000/http",
      "29200108a07ac542013ac986fffe317095061f40e003"_hex},
-    {"/unix/a/b/c/d/e", "900309612f622f632f642f65"_hex}};
+    {"/unix/a/b/c/d/e", "900309612f622f632f642f65"_hex},
+    {"/ip4/255.0.10.1/udp/65535", "04ff000a019102ffff"_hex},
+    {"/ip6/::", "2900000000000000000000000000000000"_hex},
+    {"/ip6/::1", "2900000000000000000000000000000001"_hex},
+    {"/ip6/2001:db8::1", "2920010db8000000000000000000000001"_hex},
+    {"/ip6/2001:db8:0:1:1:1:1:1", "2920010db8000000010001000100010001"_hex},
+    {"/ip6/2001:0:0:1::1", "2920010000000000010000000000000001"_hex},
+    {"/ip6/fe80::", "29fe800000000000000000000000000000"_hex},
+    {"/ip6/::ffff:192.0.2.1", "2900000000000000000000ffffc0000201"_hex},
+    {"/ip4/127.0.0.1/p2p/QmcgpsyWgH8Y8ajJz1Cu72KnS5uo2Aa2LpzU7kinSupNKC/"
+     "tcp/1234",
+     "047f000001a503221220d52ebb89d85b02a284948203a62ff28389c57c9f42beec4e"
+     "c20db76a68911c0b0604d2"_hex},
+    {"/p2p/12D3KooWD3eckifWpRn9wQpMG9R9hX3sD158z7EqHWmweQAJU5SA",
+     "a503260024080112202ffa35a99d3a3cfbb17bb7c1dc5561b18a8dcca4df38dc613e"
+     "a859c37eb1336b"_hex}};
 /*
 "/ip4/127.0.0.1/udp/5000"
 "/ip6/2001:8a0:7ac5:4201:3ac9:86ff:fe31:7095/udp/5000"
@@ -91,3 +111,309 @@ TEST_P(MultiaddrParamTestFixture, BinaryToString) {
 
 INSTANTIATE_TEST_CASE_P(MultiaddrTests, MultiaddrParamTestFixture,
                         ::testing::ValuesIn(parameters));
+
+TEST(MultiaddrTests, Ip6TextForms) {
+    std::vector<std::pair<std::string, std::string>> const forms{
+        {"/ip6/2001:0DB8:0000:0000:0000:0000:0000:0001", "/ip6/2001:db8::1"},
+        {"/ip6/2001:db8::0:1", "/ip6/2001:db8::1"},
+        {"/ip6/0:0:0:0:0:0:0:1", "/ip6/::1"},
+        {"/ip6/::0.0.0.1", "/ip6/::1"},
+        {"/ip6/1:0:0:2:0:0:0:3", "/ip6/1:0:0:2::3"},
+        {"/ip6/1:0:0:2:0:0:3:4", "/ip6/1::2:0:0:3:4"},
+        {"/ip6/1:2:3:4:5:6:7::", "/ip6/1:2:3:4:5:6:7:0"},
+        {"/ip6/::2:3:4:5:6:7:8", "/ip6/0:2:3:4:5:6:7:8"},
+        {"/ip6/1:2:3:4:5:6:1.2.3.4", "/ip6/1:2:3:4:5:6:102:304"}};
+
+    for (auto const& [input, canonical] : forms)
+        EXPECT_EQ(Multiformats::Multiaddr{input}.to_string(), canonical)
+            << input;
+}
+
+TEST(MultiaddrTests, InvalidIp) {
+    for (auto const* address :
+         {"/ip4/256.0.0.1", "/ip4/1.2.3", "/ip4/1.2.3.4.5", "/ip4/01.2.3.4",
+          "/ip4/1..2.3", "/ip4/1.2.3.4 ", "/ip4/", "/ip6/1:2:3:4:5:6:7",
+          "/ip6/1:2:3:4:5:6:7:8:9", "/ip6/1::2::3", "/ip6/:1::2", "/ip6/1::2:",
+          "/ip6/12345::", "/ip6/1:2:3:4:5:6:7:8::", "/ip6/::1.2.3",
+          "/ip6/1:2:3:4:5:6:7:1.2.3.4", "/ip6/g::", "/ip6/:::",
+          "/tcp/65536", "/tcp/-1", "/tcp/80a", "/tcp/"}) {
+        EXPECT_THROW(Multiformats::Multiaddr{address}, std::invalid_argument)
+            << address;
+    }
+}
+
+TEST(MultiaddrTests, Components) {
+    Multiformats::Multiaddr const multiaddr{"/ip4/1.2.3.4/tcp/80/dns/a.b"};
+    ASSERT_EQ(multiaddr.size(), 3);
+
+    std::vector<std::uint64_t> codes;
+    for (auto const& component : multiaddr)
+        codes.push_back(component.code);
+
+    EXPECT_EQ(codes, (std::vector<std::uint64_t>{0x04, 0x06, 0x35}));
+    EXPECT_EQ(multiaddr.front().to_string(), "1.2.3.4");
+    EXPECT_EQ(multiaddr.back().code, 0x35);
+    EXPECT_EQ(multiaddr.back().to_string(), "a.b");
+
+    // values point into the binary form
+    auto const& binary = multiaddr.to_binary();
+    EXPECT_EQ(multiaddr.front().value.data(), binary.data() + 1);
+    EXPECT_EQ(multiaddr.back().value.data() + multiaddr.back().value.size(),
+              binary.data() + binary.size());
+}
+
+TEST(MultiaddrTests, ManyComponents) {
+    std::string address;
+    for (int i = 0; i < 20; ++i)
+        address += "/tcp/" + std::to_string(i);
+
+    Multiformats::Multiaddr const multiaddr{address};
+    EXPECT_EQ(multiaddr.size(), 20);
+    EXPECT_EQ(multiaddr.back().to_string(), "19");
+    EXPECT_EQ(std::distance(multiaddr.begin(), multiaddr.end()), 20);
+    EXPECT_EQ(Multiformats::Multiaddr{multiaddr.to_binary()}.to_string(),
+              address);
+}
+
+TEST(MultiaddrTests, InvalidBinary) {
+    using Binary = std::vector<std::uint8_t>;
+
+    // truncated value, truncated length prefixed value, truncated code
+    for (auto const& binary :
+         {Binary{0x04, 0x01, 0x02}, Binary{0x35, 0x05, 0x61}, Binary{0x91}})
+        EXPECT_THROW(Multiformats::Multiaddr{binary}, std::invalid_argument);
+
+    EXPECT_THROW(Multiformats::Multiaddr{Binary{0x12}}, std::runtime_error);
+    EXPECT_EQ(Multiformats::Multiaddr{Binary{}}.size(), 0);
+}
+
+TEST_P(MultiaddrParamTestFixture, View) {
+    auto [address, binary] = GetParam();
+
+    Multiformats::MultiaddrView const view{binary};
+    EXPECT_EQ(view.to_string(), address);
+
+    Multiformats::Multiaddr const multiaddr{view};
+    EXPECT_EQ(multiaddr.to_binary(), binary);
+    EXPECT_TRUE(multiaddr.view() == view);
+    EXPECT_EQ(std::hash<Multiformats::MultiaddrView>{}(multiaddr.view()),
+              std::hash<Multiformats::MultiaddrView>{}(view));
+}
+
+TEST(MultiaddrTests, ViewIsLazy) {
+    // ip4 then a tcp component cut short
+    std::vector<std::uint8_t> const binary{0x04, 0x7f, 0x00, 0x00, 0x01, 0x06,
+                                           0x0f};
+    Multiformats::MultiaddrView const view{binary};
+
+    auto it = view.begin();
+    EXPECT_EQ(it->code, 0x04);
+    EXPECT_EQ(it->to_string(), "127.0.0.1");
+    EXPECT_THROW(++it, std::invalid_argument);
+    EXPECT_THROW(Multiformats::Multiaddr{view}, std::invalid_argument);
+
+    EXPECT_TRUE(view != Multiformats::MultiaddrView{});
+    EXPECT_TRUE(Multiformats::MultiaddrView{}.begin() ==
+                Multiformats::MultiaddrView{}.end());
+}
+
+TEST(MultiaddrTests, EveryProtocol) {
+    using namespace Multiformats;
+
+    // every code with a multiaddr value length round trips by name
+    for (auto const& entry : Multicodec::entries) {
+        auto const size = Multicodec::value_size(Multicodec::Code{entry.code});
+        if (!size)
+            continue;
+
+        std::string address = "/" + std::string{entry.name};
+        switch (*size) {
+        case 0:
+            break;
+        case 2:
+            address += "/80";
+            break;
+        case 4:
+            address += "/1.2.3.4";
+            break;
+        case 16:
+            address += "/::1";
+            break;
+        case Multicodec::variable_size:
+            address += entry.code == 0x01a5
+                           ? "/QmNnooDu7bfjPFoTZYxMNLWUQJyrVwtbZg5gBMjTezGAJN"
+                           : "/x";
+            break;
+        default:
+            address += "/" + std::string(*size, 'x');
+        }
+
+        auto const canonical = "/" + std::string{Multicodec::name(entry.code)} +
+                               address.substr(entry.name.size() + 1);
+        EXPECT_EQ(Multiaddr{address}.to_string(), canonical) << address;
+    }
+}
+
+TEST(MultiaddrTests, PeerId) {
+    using Multiformats::Multiaddr;
+
+    Multiaddr const peer{"/p2p/QmcgpsyWgH8Y8ajJz1Cu72KnS5uo2Aa2LpzU7kinSupNKC"};
+
+    // CIDv1 forms of the same key, in any multibase
+    for (auto const* address :
+         {"/ipfs/QmcgpsyWgH8Y8ajJz1Cu72KnS5uo2Aa2LpzU7kinSupNKC",
+          "/p2p/bafzbeigvf25ytwc3akrijfecaotc74udrhcxzh2cx3we5qqnw5vgrei4bm",
+          "/p2p/zdvgqFmA4BAHCvFpDrJUnvKWFTKLtDbzkN3KQdN5A3ATKwuxv"}) {
+        Multiaddr const multiaddr{address};
+        EXPECT_TRUE(multiaddr == peer) << address;
+        EXPECT_EQ(multiaddr.to_string(), peer.to_string()) << address;
+    }
+
+    // the multihash itself, not its text
+    EXPECT_EQ(peer.front().value.size(), 34);
+
+    for (auto const* address :
+         {"/p2p/QmNnooDu7bfjPFoTZYxMN", "/p2p/Qm0OIl", "/p2p/x", "/p2p/1",
+          // a dag-pb CID rather than a libp2p-key one
+          "/p2p/bafybeigdyrzt5sfp7udm7hu76uh7y26nf3efuylqabf3oclgtqy55fbzdi",
+          // short base2, base8 and base10 values
+          "/p2p/0", "/p2p/01", "/p2p/00000000", "/p2p/7", "/p2p/70",
+          "/p2p/71", "/ipfs/70", "/p2p/9", "/p2p/90", "/p2p/91",
+          "/p2p/9999999999999999999999999",
+          // empty and impossible base64 payloads
+          "/p2p/m", "/p2p/M", "/p2p/u", "/p2p/U", "/p2p/mA", "/p2p/uA",
+          "/p2p/MA===", "/p2p/MAAAAA", "/ipfs/u"})
+        EXPECT_THROW(Multiaddr{address}, std::invalid_argument) << address;
+
+    // base8 zeros, an identity multihash of nothing
+    EXPECT_EQ(Multiaddr{"/p2p/700"}.front().value.size(), 2);
+}
+
+#ifdef MULTIFORMATS_HAS_SOCKADDR
+TEST(MultiaddrTests, Sockaddr) {
+    using Multiformats::Multiaddr;
+
+    for (auto const* address :
+         {"/ip4/127.0.0.1/tcp/4001", "/ip4/10.1.2.3/udp/53",
+          "/ip6/2001:db8::1/tcp/443", "/ip6/::1/sctp/9",
+          "/ip6zone/lo/ip6/fe80::1/udp/4001"}) {
+        Multiaddr const multiaddr{address};
+        auto const transport =
+            Multiformats::Multicodec::Code{multiaddr.back().code};
+
+        sockaddr_storage storage;
+        auto const length = multiaddr.to_sockaddr(storage);
+        EXPECT_EQ(length, storage.ss_family == AF_INET ? sizeof(sockaddr_in)
+                                                       : sizeof(sockaddr_in6));
+
+        auto const back = Multiaddr::from_sockaddr(
+            reinterpret_cast<sockaddr const&>(storage), transport);
+        EXPECT_EQ(back.to_string(), address);
+    }
+
+    sockaddr_storage storage;
+    // components after the port are ignored
+    Multiaddr{"/ip4/1.2.3.4/tcp/80/p2p/"
+              "QmNnooDu7bfjPFoTZYxMNLWUQJyrVwtbZg5gBMjTezGAJN"}
+        .to_sockaddr(storage);
+    auto const& in = reinterpret_cast<sockaddr_in const&>(storage);
+    EXPECT_EQ(in.sin_family, AF_INET);
+    EXPECT_EQ(ntohs(in.sin_port), 80);
+    EXPECT_EQ(ntohl(in.sin_addr.s_addr), 0x01020304);
+
+    Multiaddr{"/ip6zone/7/ip6/fe80::1/tcp/80"}.to_sockaddr(storage);
+    EXPECT_EQ(reinterpret_cast<sockaddr_in6 const&>(storage).sin6_scope_id, 7);
+
+    for (auto const* address :
+         {"/ip4/1.2.3.4", "/dns4/a.b/tcp/80", "/ip4/1.2.3.4/ws",
+          "/ip6zone/lo/ip4/1.2.3.4/tcp/80",
+          "/ip6zone/no-such-interface/ip6/fe80::1/tcp/80",
+          // names starting with digits, short and longer than IF_NAMESIZE
+          "/ip6zone/1nosuch/ip6/::1/tcp/1",
+          "/ip6zone/1nosuchinterfacexxxx/ip6/::1/tcp/1"})
+        EXPECT_THROW(Multiaddr{address}.to_sockaddr(storage),
+                     std::invalid_argument)
+            << address;
+
+    // if_nametoindex would only see "lo"
+    std::string const nul_zone("/ip6zone/lo\0x/ip6/::1/tcp/1", 27);
+    EXPECT_THROW(Multiaddr{nul_zone}.to_sockaddr(storage),
+                 std::invalid_argument);
+
+    storage.ss_family = AF_UNIX;
+    EXPECT_THROW(Multiaddr::from_sockaddr(
+                     reinterpret_cast<sockaddr const&>(storage)),
+                 std::invalid_argument);
+}
+#endif
+
+TEST(MultiaddrTests, Encapsulate) {
+    using Multiformats::Multiaddr;
+    using Code = Multiformats::Multicodec::Code;
+
+    std::string const peer_id{
+        "QmNnooDu7bfjPFoTZYxMNLWUQJyrVwtbZg5gBMjTezGAJN"};
+    std::string const relay_id{
+        "QmcZf59bWwK5XFi76CZX8cbJ4BhTzzA3gU1ZjYZcYW3dwt"};
+
+    Multiaddr const transport{"/ip4/1.2.3.4/tcp/4001"};
+    Multiaddr const peer{"/p2p/" + peer_id};
+    Multiaddr const relayed{"/p2p-circuit/p2p/" + relay_id};
+
+    auto const full = transport.encapsulate(peer).encapsulate(relayed);
+    EXPECT_EQ(full.to_string(), "/ip4/1.2.3.4/tcp/4001/p2p/" + peer_id +
+                                    "/p2p-circuit/p2p/" + relay_id);
+    EXPECT_EQ(full.size(), 5);
+    EXPECT_EQ(full.back().to_string(), relay_id);
+    EXPECT_EQ(full.to_binary(), Multiaddr{full.to_string()}.to_binary());
+
+    EXPECT_TRUE(full.starts_with(transport));
+    EXPECT_TRUE(full.starts_with(transport.encapsulate(peer)));
+    EXPECT_FALSE(full.starts_with(peer));
+    EXPECT_FALSE(transport.starts_with(full));
+
+    // the last p2p component and everything after it
+    EXPECT_EQ(full.decapsulate(Code::p2p).to_string(),
+              "/ip4/1.2.3.4/tcp/4001/p2p/" + peer_id + "/p2p-circuit");
+    EXPECT_EQ(full.decapsulate(Code::p2p_circuit).to_string(),
+              transport.encapsulate(peer).to_string());
+    EXPECT_EQ(full.decapsulate(Code::ip4).size(), 0);
+    EXPECT_EQ(full.decapsulate(Code::udp).to_binary(), full.to_binary());
+
+    auto const [head, tail] = full.split_at(2);
+    EXPECT_EQ(head.to_binary(), transport.to_binary());
+    EXPECT_EQ(tail.to_string(), peer.encapsulate(relayed).to_string());
+    EXPECT_EQ(tail.back().code, 0x01a5);
+    EXPECT_EQ(full.split_at(0).second.to_binary(), full.to_binary());
+    EXPECT_EQ(full.split_at(5).second.size(), 0);
+    EXPECT_THROW(full.split_at(6), std::out_of_range);
+}
+
+TEST(MultiaddrTests, EncapsulateManyComponents) {
+    using Multiformats::Multiaddr;
+
+    std::string address;
+    Multiaddr joined{"/tcp/0"};
+    for (int i = 0; i < 20; ++i) {
+        address += "/tcp/" + std::to_string(i);
+        if (i != 0)
+            joined = joined.encapsulate(Multiaddr{"/tcp/" + std::to_string(i)});
+    }
+
+    EXPECT_EQ(joined.to_string(), address);
+    EXPECT_EQ(joined.size(), 20);
+    EXPECT_EQ(joined.back().to_string(), "19");
+
+    for (std::size_t i = 0; i <= joined.size(); ++i) {
+        auto const [head, tail] = joined.split_at(i);
+        EXPECT_EQ(head.size(), i);
+        EXPECT_EQ(tail.size(), joined.size() - i);
+        EXPECT_EQ(head.encapsulate(tail).to_binary(), joined.to_binary());
+        if (i < joined.size()) {
+            EXPECT_EQ(tail.front().to_string(), std::to_string(i));
+        }
+        if (i > 0) {
+            EXPECT_EQ(head.back().to_string(), std::to_string(i - 1));
+        }
+    }
+}
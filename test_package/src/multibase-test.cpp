@@ -134,6 +134,8 @@ std::vector<Parameter> const parameters{
     {Protocol::Base58Flickr, yes_mani, "Z7Pznk19XTTzBtx"},
     {Protocol::Base58Btc, yes_mani, "z7paNL19xttacUY"},
     {Protocol::Base58Btc, cid_decoded, cid_encoded},
+    {Protocol::Base58Btc, {0x00}, "z1"},
+    {Protocol::Base58Btc, {0x00, 0x00, 0x01}, "z112"},
 
     {Protocol::Base64, unicode_one, "mw7fDr8O/"},
     {Protocol::Base64, f, "mZg"},
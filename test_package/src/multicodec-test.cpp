@@ -0,0 +1,88 @@
+// Tests for the multicodec tables
+//
+// File Name: multicodec-test.cpp
+// Date: 2026-10-18
+
+#include "multiformats/codec_traits.hpp"
+#include "multiformats/multicodec.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+namespace Multicodec = Multiformats::Multicodec;
+
+static_assert(Multicodec::code("sha2-256") == 0x12);
+static_assert(Multicodec::name(0x12) == "sha2-256");
+static_assert(Multicodec::table.find("sha2-256")->second == 0x12);
+
+using Sha256 = Multicodec::codec_traits<Multicodec::Code::sha2_256>;
+static_assert(Sha256::value == 0x12 && Sha256::name == "sha2-256");
+static_assert(Sha256::tag == Multicodec::Tag::Multihash);
+static_assert(Sha256::digest_size == 32 && !Sha256::value_size);
+
+using Tcp = Multicodec::codec_traits<Multicodec::Code::tcp>;
+static_assert(Tcp::tag == Multicodec::Tag::Multiaddr && Tcp::value_size == 2);
+static_assert(Multicodec::codec_traits<Multicodec::Code::unix_>::name ==
+              "unix");
+static_assert(Multicodec::codec_traits<Multicodec::Code::p2p>::value_size ==
+              Multicodec::variable_size);
+
+static_assert(Multicodec::codec_traits<Multicodec::Code::udp>::varint[0] ==
+                  0x91 &&
+              Multicodec::codec_traits<Multicodec::Code::udp>::varint[1] ==
+                  0x02);
+
+TEST(MulticodecTests, NameToCode) {
+    for (auto const& entry : Multicodec::entries) {
+        EXPECT_EQ(Multicodec::find(entry.name), entry.code) << entry.name;
+        EXPECT_EQ(Multicodec::table.at(entry.name),
+                  Multiformats::Varint{entry.code});
+    }
+
+    EXPECT_EQ(Multicodec::find("not-a-codec"), std::nullopt);
+    EXPECT_EQ(Multicodec::find(""), std::nullopt);
+    EXPECT_THROW(Multicodec::code("sha2-25"), std::out_of_range);
+}
+
+TEST(MulticodecTests, CodeToName) {
+    for (auto const& entry : Multicodec::entries)
+        EXPECT_EQ(Multicodec::code(Multicodec::name(entry.code)), entry.code);
+
+    EXPECT_EQ(Multicodec::name(0x01a5), "p2p");
+    EXPECT_EQ(Multicodec::name(0x02), "");
+    EXPECT_EQ(Multicodec::name(0xffffffff), "");
+}
+
+TEST(MulticodecTests, Table) {
+    EXPECT_EQ(Multicodec::table.size(), std::size(Multicodec::entries));
+    EXPECT_TRUE(std::is_sorted(
+        Multicodec::table.begin(), Multicodec::table.end(),
+        [](auto const& lhs, auto const& rhs) {
+            return lhs.second < rhs.second;
+        }));
+
+    // the same pairs as the unordered_map it replaced
+    for (auto const& [name, code] : Multicodec::table) {
+        Multiformats::Varint varint = code;
+        EXPECT_EQ(Multicodec::table.at(std::string{name}), varint) << name;
+    }
+
+    auto it = Multicodec::table.find("dag-cbor");
+    ASSERT_NE(it, Multicodec::table.end());
+    EXPECT_EQ(it->first, "dag-cbor");
+    EXPECT_EQ(it->second, 0x71u);
+
+    EXPECT_EQ(Multicodec::table.find("dag-cbor2"), Multicodec::table.end());
+    EXPECT_EQ(Multicodec::table.count("tcp"), 1u);
+    EXPECT_THROW(Multicodec::table.at("tcp2"), std::out_of_range);
+}
+
+TEST(MulticodecTests, Tags) {
+    EXPECT_EQ(Multicodec::lookup(0x12)->tag, Multicodec::Tag::Multihash);
+    EXPECT_EQ(Multicodec::lookup(0x06)->tag, Multicodec::Tag::Multiaddr);
+    EXPECT_EQ(Multicodec::lookup(0x51)->tag, Multicodec::Tag::Serialization);
+    EXPECT_EQ(Multicodec::lookup(0x02), nullptr);
+}
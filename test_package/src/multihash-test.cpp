@@ -6,11 +6,15 @@
 
 #include "util.hpp"
 
+#include "multiformats/codec_traits.hpp"
 #include "multiformats/multibase.hpp"
 #include "multiformats/multihash.hpp"
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
+
 struct MultihashTestParam {
     std::string protocol;
     std::vector<std::uint8_t> plaintext;
@@ -22,6 +26,22 @@ std::vector<MultihashTestParam> const parameters{
      "c0e402409b2d7e635f15ca3cd47ecdb2ab8197ba6d26a019ff72eba34f33aba75260eec6542738bf172fb9dcbdc0ca3337a3b7fa2a14858074b8be17c2611074f323a3dc"_hex},
     {"blake2s-256", "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex,
      "e0e4022012934809335113c1b646ef2600770c57abb00c29f7a186f709b4ce4a18dc3d79"_hex},
+    {"blake2b-8", "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex,
+     "81e402017f"_hex},
+    {"blake2b-256", "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex,
+     "a0e402209f05956f76ad8313788cdc80c18b3ecd0ca61d98374132d0f7e3275ed54cda72"_hex},
+    {"blake2s-8", "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex,
+     "c1e40201ba"_hex},
+    {"blake2s-128", "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex,
+     "d0e402102d694ec14768dd30120a252d7e86ede1"_hex},
+    {"murmur3-32", "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex,
+     "2304db696f65"_hex},
+    {"murmur3-128", "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex,
+     "2210676a19923e00037a054db16eeaddf599"_hex},
+    {"xxh3-64", "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex,
+     "e3e702080ba9672f7670c03b"_hex},
+    {"xxh3-128", "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex,
+     "e4e70210e329672ba97bb5008a2d24495dea8d22"_hex},
     {"md4", "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex,
      "d401102bffa98f583e2b367c01116d0ae891fd"_hex},
     {"md5", "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex,
@@ -57,6 +77,224 @@ TEST_P(MultihashParamTestFixture, Hash) {
         std::equal(multihash.begin(), multihash.end(), raw_expected.begin()));
 }
 
+// spans several compression blocks for both BLAKE2 variants
+TEST(MultihashTests, Blake2MultiBlock) {
+    std::vector<std::uint8_t> input;
+    for (auto i = 0; i < 1024; ++i)
+        input.push_back(i & 0xff);
+
+    auto blake2b = "a0e40220f1551feeb252c7e60bb362205bd1ac2f70b145260a91d41e8c5d0a187549a5f2"_hex;
+    auto blake2s = "e0e40220a049455add68f38d48845e25a52ba3100c4d0899178c202aec07364fecacf650"_hex;
+
+    Multiformats::Multihash blake2b_hash{input, "blake2b-256"};
+    Multiformats::Multihash blake2s_hash{input, "blake2s-256"};
+
+    EXPECT_TRUE(std::equal(blake2b_hash.begin(), blake2b_hash.end(),
+                           blake2b.begin(), blake2b.end()));
+    EXPECT_TRUE(std::equal(blake2s_hash.begin(), blake2s_hash.end(),
+                           blake2s.begin(), blake2s.end()));
+}
+
+TEST(MultihashTests, NonCryptographicStreaming) {
+    std::vector<std::uint8_t> input;
+    for (auto i = 0; i < 5000; ++i)
+        input.push_back((i * 7) & 0xff);
+
+    std::vector<std::pair<std::string, std::vector<std::uint8_t>>> const
+        expected{{"murmur3-32", "2304d3502e3f"_hex},
+                 {"murmur3-128", "22106819b24a29a982ecba4e0ade4c32d724"_hex},
+                 {"xxh3-64", "e3e702086abe8be5abcb2760"_hex},
+                 {"xxh3-128", "e4e70210a4ba2a60fb07e0166abe8be5abcb2760"_hex}};
+
+    for (auto const& [protocol, raw] : expected) {
+        Multiformats::Multihash multihash{raw.cbegin(), raw.cend()};
+        EXPECT_EQ(Multiformats::Multihash(input, protocol), multihash);
+
+        // uneven pieces cross every internal block and buffer boundary
+        Multiformats::Multihasher hasher{protocol};
+        for (std::size_t offset = 0, step = 1; offset < input.size();
+             offset += step, step = step * 3 % 301 + 1)
+            hasher.update({input.data() + offset,
+                           std::min(step, input.size() - offset)});
+
+        EXPECT_EQ(hasher.finish(), multihash) << protocol;
+    }
+}
+
+TEST(MultihashTests, HeaderFields) {
+    auto raw =
+        "a0e402209f05956f76ad8313788cdc80c18b3ecd0ca61d98374132d0f7e3275ed54cda72"_hex;
+    Multiformats::Multihash multihash{raw.cbegin(), raw.cend()};
+
+    EXPECT_EQ(multihash.func_code(), 0xb220);
+    EXPECT_EQ(multihash.len(), 32);
+    EXPECT_EQ(std::distance(multihash.begin(), multihash.digest()), 4);
+    EXPECT_EQ(multihash, Multiformats::Multihash(
+                             "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex,
+                             "blake2b-256"));
+}
+
+// digests longer than the inline capacity are kept on the heap
+TEST(MultihashTests, LongDigest) {
+    std::vector<std::uint8_t> raw{0x00, 0x80, 0x01};
+    for (auto i = 0; i < 128; ++i)
+        raw.push_back(i);
+
+    Multiformats::Multihash multihash{raw.cbegin(), raw.cend()};
+    Multiformats::Multihash copy{multihash};
+    Multiformats::Multihash moved{std::move(multihash)};
+
+    EXPECT_EQ(copy.len(), 128);
+    EXPECT_EQ(copy, moved);
+    EXPECT_TRUE(std::equal(moved.begin(), moved.end(), raw.cbegin(),
+                           raw.cend()));
+
+    // the moved from multihash is empty, not a header without its digest
+    EXPECT_EQ(multihash.size(), 0);
+    EXPECT_EQ(multihash.len(), 0);
+    EXPECT_EQ(multihash, Multiformats::Multihash{});
+
+    auto const identity = "0001ff"_hex;
+    Multiformats::Multihash assigned{identity.cbegin(), identity.cend()};
+    assigned = copy;
+    EXPECT_EQ(assigned, moved);
+    assigned = std::move(copy);
+    EXPECT_EQ(assigned, moved);
+    EXPECT_EQ(copy.len(), 0);
+}
+
+TEST(MultihashTests, Fragments) {
+    auto plaintext = "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex;
+    Multiformats::ByteSpan whole{plaintext};
+    std::vector<Multiformats::ByteSpan> fragments{
+        whole.first(3), whole.subspan(3, 10), whole.subspan(13)};
+
+    for (auto protocol : {"sha2-256", "blake2b-256", "sha3-512"}) {
+        Multiformats::Multihash expected{plaintext, protocol};
+        EXPECT_EQ(Multiformats::Multihash(fragments, protocol), expected);
+    }
+}
+
+#ifdef MULTIFORMATS_HAS_IOVEC
+TEST(MultihashTests, Iovec) {
+    auto header = "431fb5d4c9"_hex;
+    auto body = "b735ba1a34d0df045118806ae2336f2c"_hex;
+    iovec iov[] = {{header.data(), header.size()}, {body.data(), body.size()}};
+
+    Multiformats::Multihash multihash{iov, 2, 0x12};
+    EXPECT_EQ(multihash,
+              Multiformats::Multihash(
+                  "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex, "sha2-256"));
+}
+#endif
+
+TEST(MultihashTests, HashEach) {
+    std::vector<std::vector<std::uint8_t>> blocks{
+        "00"_hex, "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex, {}};
+    std::vector<Multiformats::ByteSpan> buffers{blocks.cbegin(),
+                                                 blocks.cend()};
+
+    for (auto protocol : {0x12, 0xb220}) {
+        auto multihashes = Multiformats::Multihash::hash_each(buffers, protocol);
+        ASSERT_EQ(multihashes.size(), blocks.size());
+        for (std::size_t i = 0; i < blocks.size(); ++i)
+            EXPECT_EQ(multihashes[i],
+                      Multiformats::Multihash(blocks[i], protocol));
+    }
+}
+
+TEST(MultihashTests, FromFile) {
+    std::vector<std::uint8_t> contents(10 * 1024 * 1024 + 123);
+    for (std::size_t i = 0; i < contents.size(); ++i)
+        contents[i] = (i * 7) & 0xff;
+
+    std::string const path{"multihash-from-file.bin"};
+    for (auto size : {contents.size(), std::size_t{0}}) {
+        std::ofstream{path, std::ios::binary}.write(
+            reinterpret_cast<char const*>(contents.data()), size);
+
+        std::vector<std::uint8_t> expected{contents.cbegin(),
+                                           contents.cbegin() + size};
+        EXPECT_EQ(Multiformats::Multihash::from_file(path, "sha2-256"),
+                  Multiformats::Multihash(expected, "sha2-256"));
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(MultihashTests, FromMissingFile) {
+    EXPECT_THROW(Multiformats::Multihash::from_file("does-not-exist", 0x12),
+                 std::system_error);
+}
+
+TEST(MultihashTests, Compute) {
+    using Multiformats::Multihash;
+    using Multiformats::Multicodec::Code;
+
+    std::vector<std::uint8_t> const plaintext(1000, 0x5a);
+
+    EXPECT_EQ(Multihash::compute<Code::sha2_256>(plaintext),
+              Multihash(plaintext, "sha2-256"));
+    EXPECT_EQ(Multihash::compute<Code::blake2b_256>(plaintext),
+              Multihash(plaintext, "blake2b-256"));
+    EXPECT_EQ(Multihash::compute<Code::xxh3_64>(plaintext),
+              Multihash(plaintext, "xxh3-64"));
+    EXPECT_EQ(Multihash::compute<Code::shake_128>(plaintext).len(),
+              Multiformats::Multicodec::digest_size(Code::shake_128));
+}
+
+TEST(MultihashTests, Verify) {
+    auto plaintext = "431fb5d4c9b735ba1a34d0df045118806ae2336f2c"_hex;
+    Multiformats::Multihash multihash{plaintext, "sha2-256"};
+    EXPECT_TRUE(multihash.verify(plaintext));
+
+    plaintext.back() ^= 1;
+    EXPECT_FALSE(multihash.verify(plaintext));
+
+    // sha2-256 truncated to 4 bytes
+    auto truncated = "1204383a4348"_hex;
+    plaintext.back() ^= 1;
+    EXPECT_TRUE(Multiformats::Multihash(truncated.cbegin(), truncated.cend())
+                    .verify(plaintext));
+
+    // truncated to nothing, which would match any data
+    auto empty = "1200"_hex;
+    EXPECT_FALSE(Multiformats::Multihash(empty.cbegin(), empty.cend())
+                     .verify(plaintext));
+}
+
+TEST(MultihashTests, VerifyBatch) {
+    std::vector<std::vector<std::uint8_t>> blocks;
+    std::vector<Multiformats::Multihash> multihashes;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        blocks.emplace_back(i % 100 * 37, static_cast<std::uint8_t>(i));
+        multihashes.emplace_back(blocks.back(),
+                                 i % 2 ? "sha2-256" : "blake2b-256");
+    }
+
+    blocks[3].push_back(0);
+    blocks[501][0] ^= 1;
+    auto unsupported = "0603010203"_hex;
+    multihashes[999] = {unsupported.cbegin(), unsupported.cend()};
+
+    std::vector<Multiformats::ByteSpan> data{blocks.cbegin(), blocks.cend()};
+    auto failed = Multiformats::Multihash::verify_batch(data, multihashes);
+
+    ASSERT_EQ(failed.size(), blocks.size());
+    for (std::size_t i = 0; i < failed.size(); ++i)
+        EXPECT_EQ(failed[i], i == 3 || i == 501 || i == 999) << i;
+
+    EXPECT_THROW(Multiformats::Multihash::verify_batch(
+                     data, {multihashes.data(), 10}),
+                 std::invalid_argument);
+}
+
+TEST(MultihashTests, TruncatedDigest) {
+    auto raw = "12200102"_hex;
+    EXPECT_THROW(Multiformats::Multihash(raw.cbegin(), raw.cend()),
+                 std::invalid_argument);
+}
+
 TEST(MultihashTests, NotInMulticodec) {
     EXPECT_THROW({
         std::vector<std::uint8_t> buf(5, 1);